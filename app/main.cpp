@@ -12,6 +12,7 @@
 
 #include "notification_bus.h"
 #include "db_manager.h"
+#include "db_writer.h"
 #include "service_registry.h"
 #include "proxy_manager.h"
 
@@ -64,6 +65,9 @@ int main(int argc, char* argv[])
             proxy.load();
         }
 
+        db::DbWriter writer;
+        Q_UNUSED(writer);
+
         db::DbManager dbManager;
         if (!dbManager.open(settings::Provider::value(settings::data_base::name).toString()))
         {
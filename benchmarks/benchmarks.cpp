@@ -0,0 +1,108 @@
+// Qt
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QDir>
+
+// Internal
+#include "db_manager.h"
+#include "service_registry.h"
+
+// Benchmarks
+#include "mavlink_frame_parser_benchmark.h"
+#include "mavlink_communicator_benchmark.h"
+#include "udp_link_benchmark.h"
+#include "replay_link_benchmark.h"
+#include "telemetry_pipeline_benchmark.h"
+#include "telemetry_benchmark.h"
+#include "telemetry_history_benchmark.h"
+#include "generic_repository_benchmark.h"
+#include "mission_load_benchmark.h"
+#include "mission_service_benchmark.h"
+#include "mission_transfer_benchmark.h"
+#include "vehicle_map_item_model_benchmark.h"
+
+namespace
+{
+    const QString resultsOption = "-results";
+    const QString defaultResultsDir = "benchmark_results";
+    const QString dbName = "benchmark_db";
+
+    // Every benchmark writes own machine-readable xml file besides the console output
+    int run(QObject* benchmark, QStringList arguments, const QString& resultsDir)
+    {
+        QString className = benchmark->metaObject()->className();
+
+        arguments << "-o" << QDir(resultsDir).filePath(className + ".xml") + ",xml";
+        arguments << "-o" << "-,txt";
+
+        return QTest::qExec(benchmark, arguments);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Usage: benchmarks [-results <dir>] [QTest options]
+    QStringList arguments = app.arguments();
+    QString resultsDir = ::defaultResultsDir;
+
+    int index = arguments.indexOf(::resultsOption);
+    if (index > 0 && index + 1 < arguments.count())
+    {
+        resultsDir = arguments.at(index + 1);
+        arguments.erase(arguments.begin() + index, arguments.begin() + index + 2);
+    }
+    QDir().mkpath(resultsDir);
+
+    {
+        QFile file(::dbName);
+        if (file.exists()) file.remove();
+    }
+
+    db::DbManager dbManager;
+    if (!dbManager.open(::dbName)) return 1;
+
+    domain::ServiceRegistry registry;
+
+    int result = 0;
+
+    MavLinkFrameParserBenchmark frameParserBenchmark;
+    result |= ::run(&frameParserBenchmark, arguments, resultsDir);
+
+    MavLinkCommunicatorBenchmark communicatorBenchmark;
+    result |= ::run(&communicatorBenchmark, arguments, resultsDir);
+
+    UdpLinkBenchmark udpLinkBenchmark;
+    result |= ::run(&udpLinkBenchmark, arguments, resultsDir);
+
+    ReplayLinkBenchmark replayLinkBenchmark;
+    result |= ::run(&replayLinkBenchmark, arguments, resultsDir);
+
+    TelemetryPipelineBenchmark telemetryPipelineBenchmark;
+    result |= ::run(&telemetryPipelineBenchmark, arguments, resultsDir);
+
+    TelemetryBenchmark telemetryBenchmark;
+    result |= ::run(&telemetryBenchmark, arguments, resultsDir);
+
+    TelemetryHistoryBenchmark telemetryHistoryBenchmark;
+    result |= ::run(&telemetryHistoryBenchmark, arguments, resultsDir);
+
+    GenericRepositoryBenchmark repositoryBenchmark;
+    result |= ::run(&repositoryBenchmark, arguments, resultsDir);
+
+    MissionLoadBenchmark missionLoadBenchmark;
+    result |= ::run(&missionLoadBenchmark, arguments, resultsDir);
+
+    MissionServiceBenchmark missionServiceBenchmark;
+    result |= ::run(&missionServiceBenchmark, arguments, resultsDir);
+
+    MissionTransferBenchmark missionTransferBenchmark;
+    result |= ::run(&missionTransferBenchmark, arguments, resultsDir);
+
+    VehicleMapItemModelBenchmark vehicleMapItemModelBenchmark;
+    result |= ::run(&vehicleMapItemModelBenchmark, arguments, resultsDir);
+
+    return result;
+}
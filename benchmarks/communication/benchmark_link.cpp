@@ -0,0 +1,29 @@
+#include "benchmark_link.h"
+
+using namespace comm;
+
+BenchmarkLink::BenchmarkLink(QObject* parent):
+    AbstractLink(parent)
+{}
+
+bool BenchmarkLink::isConnected() const
+{
+    return true;
+}
+
+void BenchmarkLink::connectLink()
+{}
+
+void BenchmarkLink::disconnectLink()
+{}
+
+void BenchmarkLink::feed(const QByteArray& data)
+{
+    this->receiveData(data);
+}
+
+bool BenchmarkLink::sendDataImpl(const QByteArray& data)
+{
+    Q_UNUSED(data)
+    return true;
+}
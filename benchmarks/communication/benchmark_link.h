@@ -0,0 +1,30 @@
+#ifndef BENCHMARK_LINK_H
+#define BENCHMARK_LINK_H
+
+// Internal
+#include "abstract_link.h"
+
+namespace comm
+{
+    // In-memory link, feeds prepared data directly to the communicator
+    class BenchmarkLink: public AbstractLink
+    {
+        Q_OBJECT
+
+    public:
+        explicit BenchmarkLink(QObject* parent = nullptr);
+
+        bool isConnected() const override;
+
+    public slots:
+        void connectLink() override;
+        void disconnectLink() override;
+
+        void feed(const QByteArray& data);
+
+    protected:
+        bool sendDataImpl(const QByteArray& data) override;
+    };
+}
+
+#endif // BENCHMARK_LINK_H
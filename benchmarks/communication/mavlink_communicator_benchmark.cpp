@@ -0,0 +1,239 @@
+#include "mavlink_communicator_benchmark.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QDebug>
+
+// Internal
+#include "mavlink_communicator.h"
+#include "abstract_mavlink_handler.h"
+#include "tlog_recorder.h"
+
+#include "benchmark_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const int packetsCount = 10000;
+    const int radiosCount = 8;
+    const int chunkSize = 4096;
+    const int timeout = 10000;
+
+    // Typical set of ids, handled by MavLinkCommunicatorFactory
+    const QList<quint32> handledIds = {
+        MAVLINK_MSG_ID_HEARTBEAT, MAVLINK_MSG_ID_SYS_STATUS, MAVLINK_MSG_ID_SYSTEM_TIME,
+        MAVLINK_MSG_ID_PING, MAVLINK_MSG_ID_GPS_RAW_INT, MAVLINK_MSG_ID_GPS_STATUS,
+        MAVLINK_MSG_ID_SCALED_IMU, MAVLINK_MSG_ID_SCALED_PRESSURE, MAVLINK_MSG_ID_ATTITUDE,
+        MAVLINK_MSG_ID_GLOBAL_POSITION_INT, MAVLINK_MSG_ID_MISSION_ITEM,
+        MAVLINK_MSG_ID_MISSION_REQUEST, MAVLINK_MSG_ID_MISSION_CURRENT,
+        MAVLINK_MSG_ID_MISSION_COUNT, MAVLINK_MSG_ID_MISSION_ITEM_REACHED,
+        MAVLINK_MSG_ID_MISSION_ACK, MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT,
+        MAVLINK_MSG_ID_VFR_HUD, MAVLINK_MSG_ID_COMMAND_ACK,
+        MAVLINK_MSG_ID_POSITION_TARGET_GLOBAL_INT, MAVLINK_MSG_ID_RADIO_STATUS,
+        MAVLINK_MSG_ID_ALTITUDE, MAVLINK_MSG_ID_HOME_POSITION, MAVLINK_MSG_ID_LANDING_TARGET,
+        MAVLINK_MSG_ID_VIBRATION, MAVLINK_MSG_ID_HIGH_LATENCY, MAVLINK_MSG_ID_AUTOPILOT_VERSION,
+        MAVLINK_MSG_ID_RANGEFINDER, MAVLINK_MSG_ID_WIND, MAVLINK_MSG_ID_RADIO };
+
+    class CountingHandler: public AbstractMavLinkHandler
+    {
+    public:
+        CountingHandler(MavLinkCommunicator* communicator, quint32 msgId, bool catchAll):
+            AbstractMavLinkHandler(communicator, catchAll ? QList<quint32>() :
+                                                            QList<quint32>({ msgId })),
+            m_msgId(msgId)
+        {}
+
+        void processMessage(const mavlink_message_t& message) override
+        {
+            // Handlers was filtering messages by themselves before dispatch table
+            if (message.msgid != m_msgId) return;
+
+            count++;
+        }
+
+        int count = 0;
+
+    private:
+        const quint32 m_msgId;
+    };
+
+    QByteArray toPacket(const mavlink_message_t& message)
+    {
+        quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+        int lenght = mavlink_msg_to_send_buffer(buffer, &message);
+
+        return QByteArray((const char*)buffer, lenght);
+    }
+}
+
+void MavLinkCommunicatorBenchmark::initTestCase()
+{
+    mavlink_message_t message;
+
+    mavlink_heartbeat_t heartbeat = {};
+    mavlink_attitude_t attitude = {};
+    mavlink_gps_raw_int_t gps = {};
+    mavlink_vfr_hud_t vfrHud = {};
+    mavlink_global_position_int_t position = {};
+
+    // Telemetry stream mix, one message per datagram
+    for (int i = 0; i < ::packetsCount; ++i)
+    {
+        switch (i % 10)
+        {
+        case 0:
+            mavlink_msg_heartbeat_encode(1, 1, &message, &heartbeat);
+            break;
+        case 1:
+        case 2:
+            mavlink_msg_gps_raw_int_encode(1, 1, &message, &gps);
+            break;
+        case 3:
+        case 4:
+            mavlink_msg_vfr_hud_encode(1, 1, &message, &vfrHud);
+            break;
+        case 5:
+        case 6:
+            mavlink_msg_global_position_int_encode(1, 1, &message, &position);
+            break;
+        default:
+            attitude.time_boot_ms = i;
+            mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+            break;
+        }
+
+        m_packets.append(::toPacket(message));
+    }
+}
+
+void MavLinkCommunicatorBenchmark::benchmarkHandlerDispatch_data()
+{
+    QTest::addColumn<bool>("catchAll");
+
+    QTest::newRow("every handler, 10000 msgs") << true;
+    QTest::newRow("dispatch table, 10000 msgs") << false;
+}
+
+void MavLinkCommunicatorBenchmark::benchmarkHandlerDispatch()
+{
+    QFETCH(bool, catchAll);
+
+    MavLinkCommunicator communicator(255, 0, false);
+    BenchmarkLink link;
+    communicator.addLink(&link);
+
+    QList<CountingHandler*> handlers;
+    for (quint32 msgId: ::handledIds)
+    {
+        CountingHandler* handler = new CountingHandler(&communicator, msgId, catchAll);
+        communicator.addHandler(handler); // Communicator takes ownership
+        handlers.append(handler);
+    }
+
+    QBENCHMARK
+    {
+        for (const QByteArray& packet: m_packets) link.feed(packet);
+    }
+
+    int handled = 0;
+    for (CountingHandler* handler: handlers) handled += handler->count;
+
+    QVERIFY(handled > 0);
+    QCOMPARE(handled % ::packetsCount, 0);
+
+    communicator.removeLink(&link);
+}
+
+void MavLinkCommunicatorBenchmark::benchmarkParseThreads_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("communicator thread, 8 links") << 0;
+    QTest::newRow("2 parse threads, 8 links") << 2;
+    QTest::newRow("4 parse threads, 8 links") << 4;
+    QTest::newRow("8 parse threads, 8 links") << 8;
+}
+
+void MavLinkCommunicatorBenchmark::benchmarkParseThreads()
+{
+    QFETCH(int, threads);
+
+    QByteArray stream;
+    for (const QByteArray& packet: m_packets) stream.append(packet);
+
+    MavLinkCommunicator communicator(255, 0, false);
+    communicator.setParseThreads(threads);
+
+    QList<BenchmarkLink*> links;
+    for (int i = 0; i < ::radiosCount; ++i)
+    {
+        links.append(new BenchmarkLink(&communicator));
+        communicator.addLink(links.last());
+    }
+
+    CountingHandler* handler = new CountingHandler(&communicator, MAVLINK_MSG_ID_ATTITUDE, false);
+    communicator.addHandler(handler);
+
+    QBENCHMARK
+    {
+        handler->count = 0;
+
+        // Radios are interleaved like in a real aggregation
+        for (int pos = 0; pos < stream.size(); pos += ::chunkSize)
+        {
+            for (BenchmarkLink* link: links) link->feed(stream.mid(pos, ::chunkSize));
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        while (handler->count < ::radiosCount * ::packetsCount * 3 / 10 &&
+               !timer.hasExpired(::timeout))
+        {
+            QCoreApplication::processEvents();
+        }
+    }
+
+    QCOMPARE(handler->count, ::radiosCount * ::packetsCount * 3 / 10);
+}
+
+void MavLinkCommunicatorBenchmark::benchmarkRecording_data()
+{
+    QTest::addColumn<bool>("recording");
+
+    QTest::newRow("no recording, 10000 msgs") << false;
+    QTest::newRow("tlog recording, 10000 msgs") << true;
+}
+
+void MavLinkCommunicatorBenchmark::benchmarkRecording()
+{
+    QFETCH(bool, recording);
+
+    QTemporaryDir dir;
+    TlogRecorder recorder;
+    if (recording) QVERIFY(recorder.start(dir.filePath("benchmark.tlog")));
+
+    MavLinkCommunicator communicator(255, 0, false);
+    communicator.setRecorder(&recorder);
+    BenchmarkLink link;
+    communicator.addLink(&link);
+
+    CountingHandler* handler = new CountingHandler(&communicator, MAVLINK_MSG_ID_ATTITUDE, false);
+    communicator.addHandler(handler);
+
+    QBENCHMARK
+    {
+        for (const QByteArray& packet: m_packets) link.feed(packet);
+    }
+
+    recorder.stop();
+    QCOMPARE(recorder.droppedFrames(), quint64(0));
+    if (recording) QVERIFY(recorder.recordedFrames() >= quint64(::packetsCount));
+
+    communicator.removeLink(&link);
+}
@@ -0,0 +1,26 @@
+#ifndef MAVLINK_COMMUNICATOR_BENCHMARK_H
+#define MAVLINK_COMMUNICATOR_BENCHMARK_H
+
+#include <QTest>
+
+class MavLinkCommunicatorBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void benchmarkHandlerDispatch_data();
+    void benchmarkHandlerDispatch();
+
+    void benchmarkParseThreads_data();
+    void benchmarkParseThreads();
+
+    void benchmarkRecording_data();
+    void benchmarkRecording();
+
+private:
+    QList<QByteArray> m_packets;
+};
+
+#endif // MAVLINK_COMMUNICATOR_BENCHMARK_H
@@ -0,0 +1,250 @@
+#include "mavlink_frame_parser_benchmark.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QDebug>
+
+// Internal
+#include "mavlink_frame_parser.h"
+
+using namespace comm;
+
+namespace
+{
+    const int packetsCount = 10000;
+    const int typePacketsCount = 1000;
+
+    void encode(quint32 msgId, int i, mavlink_message_t* message)
+    {
+        switch (msgId)
+        {
+        case MAVLINK_MSG_ID_HEARTBEAT:
+        {
+            mavlink_heartbeat_t heartbeat = {};
+            heartbeat.custom_mode = i;
+            heartbeat.type = MAV_TYPE_FIXED_WING;
+            heartbeat.autopilot = MAV_AUTOPILOT_ARDUPILOTMEGA;
+            mavlink_msg_heartbeat_encode(1, 1, message, &heartbeat);
+            break;
+        }
+        case MAVLINK_MSG_ID_ATTITUDE:
+        {
+            mavlink_attitude_t attitude = {};
+            attitude.time_boot_ms = i;
+            attitude.roll = 0.1f * i;
+            mavlink_msg_attitude_encode(1, 1, message, &attitude);
+            break;
+        }
+        case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        {
+            mavlink_global_position_int_t position = {};
+            position.time_boot_ms = i;
+            position.lat = 557000000 + i;
+            position.lon = 371000000 + i;
+            mavlink_msg_global_position_int_encode(1, 1, message, &position);
+            break;
+        }
+        case MAVLINK_MSG_ID_GPS_RAW_INT:
+        {
+            mavlink_gps_raw_int_t gps = {};
+            gps.time_usec = i;
+            gps.lat = 557000000 + i;
+            gps.lon = 371000000 + i;
+            mavlink_msg_gps_raw_int_encode(1, 1, message, &gps);
+            break;
+        }
+        case MAVLINK_MSG_ID_VFR_HUD:
+        {
+            mavlink_vfr_hud_t hud = {};
+            hud.airspeed = 0.1f * i;
+            mavlink_msg_vfr_hud_encode(1, 1, message, &hud);
+            break;
+        }
+        case MAVLINK_MSG_ID_SYS_STATUS:
+        default:
+        {
+            mavlink_sys_status_t status = {};
+            status.voltage_battery = i;
+            mavlink_msg_sys_status_encode(1, 1, message, &status);
+            break;
+        }
+        }
+    }
+
+    // Returns a decoded field, so decoding is not optimised out
+    quint64 decode(const mavlink_message_t& message)
+    {
+        switch (message.msgid)
+        {
+        case MAVLINK_MSG_ID_HEARTBEAT:
+        {
+            mavlink_heartbeat_t heartbeat;
+            mavlink_msg_heartbeat_decode(&message, &heartbeat);
+            return heartbeat.custom_mode;
+        }
+        case MAVLINK_MSG_ID_ATTITUDE:
+        {
+            mavlink_attitude_t attitude;
+            mavlink_msg_attitude_decode(&message, &attitude);
+            return attitude.time_boot_ms;
+        }
+        case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+        {
+            mavlink_global_position_int_t position;
+            mavlink_msg_global_position_int_decode(&message, &position);
+            return position.time_boot_ms;
+        }
+        case MAVLINK_MSG_ID_GPS_RAW_INT:
+        {
+            mavlink_gps_raw_int_t gps;
+            mavlink_msg_gps_raw_int_decode(&message, &gps);
+            return gps.time_usec;
+        }
+        case MAVLINK_MSG_ID_VFR_HUD:
+        {
+            mavlink_vfr_hud_t hud;
+            mavlink_msg_vfr_hud_decode(&message, &hud);
+            return hud.airspeed;
+        }
+        case MAVLINK_MSG_ID_SYS_STATUS:
+        {
+            mavlink_sys_status_t status;
+            mavlink_msg_sys_status_decode(&message, &status);
+            return status.voltage_battery;
+        }
+        }
+
+        return 0;
+    }
+}
+
+void MavLinkFrameParserBenchmark::initTestCase()
+{
+    mavlink_message_t message;
+    quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+
+    mavlink_attitude_t attitude = {};
+    mavlink_gps_raw_int_t gps = {};
+    gps.lat = 557000000;
+    gps.lon = 371000000;
+
+    // Replay-file like stream
+    for (int i = 0; i < ::packetsCount; ++i)
+    {
+        if (i % 2)
+        {
+            attitude.time_boot_ms = i;
+            mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+        }
+        else
+        {
+            gps.time_usec = i;
+            mavlink_msg_gps_raw_int_encode(1, 1, &message, &gps);
+        }
+
+        m_stream.append((const char*)buffer, mavlink_msg_to_send_buffer(buffer, &message));
+    }
+
+    // Stream of a single type per message, payload lengths differ a lot
+    for (quint32 msgId: { MAVLINK_MSG_ID_HEARTBEAT, MAVLINK_MSG_ID_ATTITUDE,
+                          MAVLINK_MSG_ID_GLOBAL_POSITION_INT, MAVLINK_MSG_ID_GPS_RAW_INT,
+                          MAVLINK_MSG_ID_VFR_HUD, MAVLINK_MSG_ID_SYS_STATUS })
+    {
+        QByteArray& stream = m_typeStreams[msgId];
+
+        for (int i = 0; i < ::typePacketsCount; ++i)
+        {
+            ::encode(msgId, i, &message);
+            stream.append((const char*)buffer, mavlink_msg_to_send_buffer(buffer, &message));
+        }
+    }
+}
+
+void MavLinkFrameParserBenchmark::benchmarkParsing_data()
+{
+    QTest::addColumn<bool>("frameParser");
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("mavlink_parse_char, 512 b chunks") << false << 512;
+    QTest::newRow("frame parser, 512 b chunks") << true << 512;
+    QTest::newRow("mavlink_parse_char, 64 kb chunks") << false << 65536;
+    QTest::newRow("frame parser, 64 kb chunks") << true << 65536;
+}
+
+void MavLinkFrameParserBenchmark::benchmarkParsing()
+{
+    QFETCH(bool, frameParser);
+    QFETCH(int, chunkSize);
+
+    int parsed = 0;
+    mavlink_message_t message;
+    mavlink_status_t status;
+    MavLinkFrameParser parser(MAVLINK_COMM_0);
+
+    QBENCHMARK
+    {
+        parsed = 0;
+
+        for (int pos = 0; pos < m_stream.size(); pos += chunkSize)
+        {
+            const char* chunk = m_stream.constData() + pos;
+            int size = qMin(chunkSize, m_stream.size() - pos);
+
+            if (frameParser)
+            {
+                parser.setData(chunk, size);
+                while (parser.next(message)) parsed++;
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                {
+                    if (mavlink_parse_char(MAVLINK_COMM_1, chunk[i], &message, &status)) parsed++;
+                }
+            }
+        }
+    }
+
+    QCOMPARE(parsed, ::packetsCount);
+}
+
+void MavLinkFrameParserBenchmark::benchmarkMessageTypes_data()
+{
+    QTest::addColumn<quint32>("msgId");
+
+    QTest::newRow("HEARTBEAT") << quint32(MAVLINK_MSG_ID_HEARTBEAT);
+    QTest::newRow("ATTITUDE") << quint32(MAVLINK_MSG_ID_ATTITUDE);
+    QTest::newRow("GLOBAL_POSITION_INT") << quint32(MAVLINK_MSG_ID_GLOBAL_POSITION_INT);
+    QTest::newRow("GPS_RAW_INT") << quint32(MAVLINK_MSG_ID_GPS_RAW_INT);
+    QTest::newRow("VFR_HUD") << quint32(MAVLINK_MSG_ID_VFR_HUD);
+    QTest::newRow("SYS_STATUS") << quint32(MAVLINK_MSG_ID_SYS_STATUS);
+}
+
+void MavLinkFrameParserBenchmark::benchmarkMessageTypes()
+{
+    QFETCH(quint32, msgId);
+
+    const QByteArray& stream = m_typeStreams[msgId];
+    int parsed = 0;
+    quint64 checksum = 0;
+    mavlink_message_t message;
+    MavLinkFrameParser parser(MAVLINK_COMM_0);
+
+    // Parse and decode, as handlers do
+    QBENCHMARK
+    {
+        parsed = 0;
+        parser.setData(stream.constData(), stream.size());
+
+        while (parser.next(message))
+        {
+            checksum += ::decode(message);
+            parsed++;
+        }
+    }
+
+    QCOMPARE(parsed, ::typePacketsCount);
+    QVERIFY(checksum > 0);
+}
@@ -0,0 +1,25 @@
+#ifndef MAVLINK_FRAME_PARSER_BENCHMARK_H
+#define MAVLINK_FRAME_PARSER_BENCHMARK_H
+
+#include <QTest>
+#include <QMap>
+
+class MavLinkFrameParserBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void benchmarkParsing_data();
+    void benchmarkParsing();
+
+    void benchmarkMessageTypes_data();
+    void benchmarkMessageTypes();
+
+private:
+    QByteArray m_stream;
+    QMap<quint32, QByteArray> m_typeStreams;
+};
+
+#endif // MAVLINK_FRAME_PARSER_BENCHMARK_H
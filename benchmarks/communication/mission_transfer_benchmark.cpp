@@ -0,0 +1,181 @@
+#include "mission_transfer_benchmark.h"
+
+// Qt
+#include <QEventLoop>
+#include <QTimer>
+#include <QDebug>
+
+// Internal
+#include "service_registry.h"
+#include "vehicle_service.h"
+#include "mission_service.h"
+#include "vehicle.h"
+#include "mission.h"
+#include "mission_item.h"
+#include "mission_assignment.h"
+
+#include "mavlink_communicator.h"
+#include "mission_handler.h"
+#include "simulated_vehicle.h"
+
+#include "simulator_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint8 mavId = 201; // apart from the other benchmarks vehicles
+    const int itemsCount = 50;
+    const int latency = 50; // ms, one way
+    const int baudRate = 57600; // telemetry radio
+    const int timeout = 120000;
+}
+
+void MissionTransferBenchmark::initTestCase()
+{
+    domain::VehicleService* vehicleService = serviceRegistry->vehicleService();
+    domain::MissionService* missionService = serviceRegistry->missionService();
+
+    m_vehicle = dto::VehiclePtr::create();
+    m_vehicle->setMavId(::mavId);
+    m_vehicle->setName("Benchmark simulated vehicle");
+    m_vehicle->setType(dto::Vehicle::FixedWing);
+    QVERIFY(vehicleService->save(m_vehicle));
+
+    m_mission = dto::MissionPtr::create();
+    m_mission->setName("Benchmark transfer mission");
+    QVERIFY(missionService->save(m_mission));
+
+    dto::MissionItemPtrList items;
+    for (int sequence = 0; sequence < ::itemsCount; ++sequence)
+    {
+        dto::MissionItemPtr item = dto::MissionItemPtr::create();
+        item->setMissionId(m_mission->id());
+        item->setSequence(sequence);
+        item->setCommand(sequence ? dto::MissionItem::Waypoint : dto::MissionItem::Home);
+        item->setLatitude(55.97 + sequence * 1e-4);
+        item->setLongitude(37.11);
+        item->setAltitude(150);
+        items.append(item);
+    }
+    QVERIFY(missionService->save(items));
+
+    m_mission->setCount(::itemsCount);
+    QVERIFY(missionService->save(m_mission));
+
+    missionService->assign(m_mission->id(), m_vehicle->id());
+    QVERIFY(missionService->vehicleAssignment(m_vehicle->id()));
+
+    m_communicator = new MavLinkCommunicator(255, 190, false);
+    m_link = new SimulatorLink(::mavId, m_communicator);
+    m_link->setLatency(::latency);
+    m_link->setBaudRate(::baudRate);
+    m_communicator->addLink(m_link);
+
+    m_handler = new MissionHandler(m_communicator);
+    m_communicator->addHandler(m_handler);
+
+    // Link of the vehicle is known after the first heartbeat
+    QTRY_VERIFY_WITH_TIMEOUT(m_communicator->mavSystemLink(::mavId), 5000);
+
+    // Download needs the mission onboard
+    QVERIFY(this->sync(true));
+    QCOMPARE(m_link->vehicle()->missionCount(), ::itemsCount);
+}
+
+void MissionTransferBenchmark::cleanupTestCase()
+{
+    delete m_communicator;
+
+    serviceRegistry->missionService()->remove(m_mission);
+    serviceRegistry->vehicleService()->remove(m_vehicle);
+}
+
+void MissionTransferBenchmark::benchmarkUpload_data()
+{
+    this->addRows();
+}
+
+void MissionTransferBenchmark::benchmarkUpload()
+{
+    QFETCH(int, window);
+    QFETCH(double, loss);
+
+    m_handler->setTransferWindow(::mavId, window);
+    m_link->setLoss(loss);
+
+    bool ok = false;
+    QBENCHMARK_ONCE
+    {
+        ok = this->sync(true);
+    }
+
+    m_link->setLoss(0);
+
+    QVERIFY(ok);
+    QCOMPARE(m_link->vehicle()->missionCount(), ::itemsCount);
+}
+
+void MissionTransferBenchmark::benchmarkDownload_data()
+{
+    this->addRows();
+}
+
+void MissionTransferBenchmark::benchmarkDownload()
+{
+    QFETCH(int, window);
+    QFETCH(double, loss);
+
+    m_handler->setTransferWindow(::mavId, window);
+    m_link->setLoss(loss);
+
+    bool ok = false;
+    QBENCHMARK_ONCE
+    {
+        ok = this->sync(false);
+    }
+
+    m_link->setLoss(0);
+
+    QVERIFY(ok);
+    QCOMPARE(serviceRegistry->missionService()->missionItems(m_mission->id()).count(),
+             ::itemsCount);
+}
+
+void MissionTransferBenchmark::addRows()
+{
+    QTest::addColumn<int>("window");
+    QTest::addColumn<double>("loss");
+
+    for (int window: { 1, 8 })
+    {
+        for (double loss: { 0.0, 0.05, 0.2 })
+        {
+            QTest::newRow(qPrintable(QString("window %1, loss %2%").arg(window).arg(loss * 100)))
+                    << window << loss;
+        }
+    }
+}
+
+bool MissionTransferBenchmark::sync(bool upload)
+{
+    domain::MissionService* missionService = serviceRegistry->missionService();
+    dto::MissionAssignmentPtr assignment = missionService->vehicleAssignment(m_vehicle->id());
+
+    QEventLoop loop;
+    connect(missionService, &domain::MissionService::assignmentChanged, &loop,
+            [&loop, assignment](dto::MissionAssignmentPtr changed) {
+        if (changed != assignment) return;
+
+        if (changed->status() == dto::MissionAssignment::Actual ||
+            changed->status() == dto::MissionAssignment::NotActual) loop.quit();
+    });
+    QTimer::singleShot(::timeout, &loop, &QEventLoop::quit);
+
+    if (upload) emit missionService->upload(assignment);
+    else emit missionService->download(assignment);
+
+    loop.exec();
+
+    return assignment->status() == dto::MissionAssignment::Actual;
+}
@@ -0,0 +1,42 @@
+#ifndef MISSION_TRANSFER_BENCHMARK_H
+#define MISSION_TRANSFER_BENCHMARK_H
+
+#include <QTest>
+
+// Internal
+#include "dto_traits.h"
+
+namespace comm
+{
+    class MavLinkCommunicator;
+    class MissionHandler;
+    class SimulatorLink;
+}
+
+class MissionTransferBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkUpload_data();
+    void benchmarkUpload();
+
+    void benchmarkDownload_data();
+    void benchmarkDownload();
+
+private:
+    void addRows();
+    bool sync(bool upload);
+
+    comm::MavLinkCommunicator* m_communicator = nullptr;
+    comm::MissionHandler* m_handler = nullptr;
+    comm::SimulatorLink* m_link = nullptr;
+
+    dto::VehiclePtr m_vehicle;
+    dto::MissionPtr m_mission;
+};
+
+#endif // MISSION_TRANSFER_BENCHMARK_H
@@ -0,0 +1,128 @@
+#include "replay_link_benchmark.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QDebug>
+
+// Internal
+#include "mavlink_communicator.h"
+#include "abstract_mavlink_handler.h"
+#include "tlog_recorder.h"
+#include "replay_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const int packetsCount = 50000;
+    const quint64 period = 1000; // 1 kHz stream
+    const int timeout = 30000;
+
+    class CountingHandler: public AbstractMavLinkHandler
+    {
+    public:
+        explicit CountingHandler(MavLinkCommunicator* communicator):
+            AbstractMavLinkHandler(communicator)
+        {}
+
+        void processMessage(const mavlink_message_t& message) override
+        {
+            Q_UNUSED(message)
+            count++;
+        }
+
+        int count = 0;
+    };
+}
+
+void ReplayLinkBenchmark::initTestCase()
+{
+    m_fileName = m_dir.filePath("replay.tlog");
+
+    TlogRecorder recorder;
+    QVERIFY(recorder.start(m_fileName));
+
+    mavlink_message_t message;
+    mavlink_attitude_t attitude = {};
+    mavlink_gps_raw_int_t gps = {};
+    mavlink_vfr_hud_t vfrHud = {};
+    quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+
+    for (int i = 0; i < ::packetsCount; ++i)
+    {
+        switch (i % 4)
+        {
+        case 0:
+            mavlink_msg_gps_raw_int_encode(1, 1, &message, &gps);
+            break;
+        case 1:
+            mavlink_msg_vfr_hud_encode(1, 1, &message, &vfrHud);
+            break;
+        default:
+            attitude.time_boot_ms = i;
+            mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+            break;
+        }
+
+        int size = mavlink_msg_to_send_buffer(buffer, &message);
+        recorder.record(1500000000000000 + i * ::period, (const char*)buffer, size);
+    }
+
+    recorder.stop();
+    QCOMPARE(recorder.recordedFrames(), quint64(::packetsCount));
+}
+
+void ReplayLinkBenchmark::benchmarkReplay_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("max speed, communicator thread, 50000 msgs") << 0;
+    QTest::newRow("max speed, 2 parse threads, 50000 msgs") << 2;
+}
+
+void ReplayLinkBenchmark::benchmarkReplay()
+{
+    QFETCH(int, threads);
+
+    MavLinkCommunicator communicator(255, 0, false);
+    communicator.setParseThreads(threads);
+
+    CountingHandler* handler = new CountingHandler(&communicator);
+    communicator.addHandler(handler);
+
+    ReplayLink link(m_fileName);
+    link.setSpeed(0);
+    link.setPaused(true);
+    communicator.addLink(&link);
+    link.connectLink();
+    QVERIFY(link.isConnected());
+
+    qint64 elapsed = 0;
+
+    QBENCHMARK
+    {
+        handler->count = 0;
+        link.seek(0);
+
+        QElapsedTimer timer;
+        timer.start();
+        link.setPaused(false);
+
+        while (handler->count < ::packetsCount && !timer.hasExpired(::timeout))
+        {
+            QCoreApplication::processEvents();
+        }
+
+        elapsed = timer.nsecsElapsed();
+        link.setPaused(true);
+    }
+
+    QCOMPARE(handler->count, ::packetsCount);
+    qDebug() << "msgs/sec:" << qint64(::packetsCount * 1e9 / qMax(elapsed, qint64(1)));
+
+    communicator.removeLink(&link);
+}
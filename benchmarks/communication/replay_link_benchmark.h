@@ -0,0 +1,22 @@
+#ifndef REPLAY_LINK_BENCHMARK_H
+#define REPLAY_LINK_BENCHMARK_H
+
+#include <QTest>
+#include <QTemporaryDir>
+
+class ReplayLinkBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void benchmarkReplay_data();
+    void benchmarkReplay();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_fileName;
+};
+
+#endif // REPLAY_LINK_BENCHMARK_H
@@ -0,0 +1,131 @@
+#include "simulator_link.h"
+
+// MAVLink
+#include <mavlink.h>
+
+using namespace comm;
+
+namespace
+{
+    // Vehicle encodes on the last channel, uplink is parsed on the previous one
+    const quint8 vehicleChannel = MAVLINK_COMM_NUM_BUFFERS - 1;
+    const quint8 uplinkChannel = MAVLINK_COMM_NUM_BUFFERS - 2;
+
+    const int tick = 2; // ms
+    const int seed = 42; // runs are comparable with the same losses
+}
+
+SimulatorLink::SimulatorLink(quint8 mavId, QObject* parent):
+    AbstractLink(parent),
+    m_vehicle(new sim::SimulatedVehicle(mavId, ::vehicleChannel)),
+    m_random(::seed)
+{
+    // Only heartbeat, so the mission protocol has the whole link
+    for (quint32 msgId: sim::SimulatedVehicle::defaultStreams())
+    {
+        if (msgId != MAVLINK_MSG_ID_HEARTBEAT) m_vehicle->setStreamRate(msgId, 0);
+    }
+
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(::tick);
+    connect(&m_timer, &QTimer::timeout, this, &SimulatorLink::onTimeout);
+
+    m_time.start();
+    m_timer.start();
+}
+
+SimulatorLink::~SimulatorLink()
+{}
+
+bool SimulatorLink::isConnected() const
+{
+    return true;
+}
+
+sim::SimulatedVehicle* SimulatorLink::vehicle() const
+{
+    return m_vehicle.data();
+}
+
+void SimulatorLink::setLoss(double loss)
+{
+    m_loss = loss;
+    m_random.seed(::seed);
+}
+
+void SimulatorLink::setLatency(int latency)
+{
+    m_latency = latency;
+}
+
+void SimulatorLink::setBaudRate(int baudRate)
+{
+    m_bytesPerSecond = baudRate / 10; // start and stop bits
+}
+
+quint64 SimulatorLink::messagesLost() const
+{
+    return m_messagesLost;
+}
+
+void SimulatorLink::connectLink()
+{}
+
+void SimulatorLink::disconnectLink()
+{}
+
+bool SimulatorLink::sendDataImpl(const QByteArray& data)
+{
+    mavlink_message_t message;
+    mavlink_status_t status;
+
+    for (char byte: data)
+    {
+        if (mavlink_parse_char(::uplinkChannel, quint8(byte), &message, &status))
+        {
+            this->enqueue(m_uplink, m_uplinkBusy, message);
+        }
+    }
+
+    return true;
+}
+
+void SimulatorLink::onTimeout()
+{
+    qint64 now = m_time.elapsed();
+    sim::MessageList output;
+
+    while (!m_uplink.isEmpty() && m_uplink.first().due <= now)
+    {
+        m_vehicle->processMessage(m_uplink.takeFirst().message, now, output);
+    }
+    m_vehicle->update(now, output);
+
+    for (const mavlink_message_t& message: output) this->enqueue(m_downlink, m_downlinkBusy, message);
+
+    quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+    while (!m_downlink.isEmpty() && m_downlink.first().due <= now)
+    {
+        int length = mavlink_msg_to_send_buffer(buffer, &m_downlink.first().message);
+        m_downlink.removeFirst();
+
+        this->receiveData(QByteArray(reinterpret_cast<const char*>(buffer), length));
+    }
+}
+
+void SimulatorLink::enqueue(QVector<Pending>& queue, qint64& busyUntil,
+                            const mavlink_message_t& message)
+{
+    // Lost message takes the air time too
+    qint64 now = m_time.elapsed();
+    int length = MAVLINK_NUM_NON_PAYLOAD_BYTES + message.len;
+    busyUntil = qMax(busyUntil, now) + length * 1000 / m_bytesPerSecond;
+
+    if (std::bernoulli_distribution(m_loss)(m_random))
+    {
+        m_messagesLost++;
+        return;
+    }
+
+    queue.append({ busyUntil + m_latency, message });
+}
@@ -0,0 +1,77 @@
+#ifndef SIMULATOR_LINK_H
+#define SIMULATOR_LINK_H
+
+// Qt
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+
+// MAVLink
+#include <mavlink_types.h>
+
+// Internal
+#include "abstract_link.h"
+#include "simulated_vehicle.h"
+
+// Std
+#include <random>
+
+namespace comm
+{
+    // Link to the simulated vehicle behind a radio: messages go with latency, take their time
+    // of the link rate and are lost with the given probability in both directions
+    class SimulatorLink: public AbstractLink
+    {
+        Q_OBJECT
+
+    public:
+        explicit SimulatorLink(quint8 mavId, QObject* parent = nullptr);
+        ~SimulatorLink() override;
+
+        bool isConnected() const override;
+
+        sim::SimulatedVehicle* vehicle() const;
+
+        void setLoss(double loss);
+        void setLatency(int latency); // ms, one way
+        void setBaudRate(int baudRate);
+
+        quint64 messagesLost() const;
+
+    public slots:
+        void connectLink() override;
+        void disconnectLink() override;
+
+    protected:
+        bool sendDataImpl(const QByteArray& data) override;
+
+    private slots:
+        void onTimeout();
+
+    private:
+        struct Pending
+        {
+            qint64 due;
+            mavlink_message_t message;
+        };
+
+        void enqueue(QVector<Pending>& queue, qint64& busyUntil, const mavlink_message_t& message);
+
+        QScopedPointer<sim::SimulatedVehicle> m_vehicle;
+        QTimer m_timer;
+        QElapsedTimer m_time;
+        std::mt19937 m_random;
+
+        double m_loss = 0;
+        int m_latency = 0;
+        int m_bytesPerSecond = 5760;
+        quint64 m_messagesLost = 0;
+
+        QVector<Pending> m_uplink;
+        QVector<Pending> m_downlink;
+        qint64 m_uplinkBusy = 0;
+        qint64 m_downlinkBusy = 0;
+    };
+}
+
+#endif // SIMULATOR_LINK_H
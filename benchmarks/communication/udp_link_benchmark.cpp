@@ -0,0 +1,87 @@
+#include "udp_link_benchmark.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QDebug>
+
+// Internal
+#include "udp_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint16 senderPort = 61000;
+    const quint16 firstReceiverPort = 61001;
+    const int packetsCount = 100; // fits into default socket receive buffer
+    const int timeout = 5000;
+}
+
+void UdpLinkBenchmark::benchmarkLoopback_data()
+{
+    QTest::addColumn<int>("endpoints");
+
+    QTest::newRow("1 endpoint, 100 msgs") << 1;
+    QTest::newRow("8 endpoints, 100 msgs") << 8;
+    QTest::newRow("64 endpoints, 100 msgs") << 64;
+}
+
+void UdpLinkBenchmark::benchmarkLoopback()
+{
+    QFETCH(int, endpoints);
+
+    mavlink_message_t message;
+    mavlink_attitude_t attitude = {};
+    mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+
+    quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+    QByteArray packet((const char*)buffer, mavlink_msg_to_send_buffer(buffer, &message));
+
+    UdpLink sender(::senderPort);
+    sender.setAutoResponse(false);
+    sender.connectLink();
+    QVERIFY(sender.isConnected());
+
+    int received = 0;
+    QList<UdpLink*> receivers;
+    for (int i = 0; i < endpoints; ++i)
+    {
+        UdpLink* receiver = new UdpLink(::firstReceiverPort + i, this);
+        receiver->setAutoResponse(false);
+        receiver->connectLink();
+        QVERIFY(receiver->isConnected());
+
+        QObject::connect(receiver, &AbstractLink::dataReceived, [&received]() { received++; });
+        sender.addEndpoint(Endpoint(QHostAddress::LocalHost, receiver->port()));
+        receivers.append(receiver);
+    }
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int transferred = 0;
+
+    QBENCHMARK
+    {
+        received = 0;
+        timer.start();
+
+        for (int i = 0; i < ::packetsCount; ++i) sender.sendData(packet);
+
+        while (received < ::packetsCount * endpoints && !timer.hasExpired(::timeout))
+        {
+            QCoreApplication::processEvents();
+        }
+
+        elapsed += timer.nsecsElapsed();
+        transferred += received;
+    }
+
+    qDeleteAll(receivers);
+
+    QCOMPARE(received, ::packetsCount * endpoints);
+    qDebug() << "Packets per second:" << qRound64(transferred * 1e9 / qMax(elapsed, qint64(1)));
+}
@@ -0,0 +1,15 @@
+#ifndef UDP_LINK_BENCHMARK_H
+#define UDP_LINK_BENCHMARK_H
+
+#include <QTest>
+
+class UdpLinkBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkLoopback_data();
+    void benchmarkLoopback();
+};
+
+#endif // UDP_LINK_BENCHMARK_H
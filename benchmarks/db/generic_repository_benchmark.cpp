@@ -0,0 +1,143 @@
+#include "generic_repository_benchmark.h"
+
+// Qt
+#include <QSqlQuery>
+#include <QDebug>
+
+// Internal
+#include "generic_repository.h"
+#include "mission.h"
+#include "mission_item.h"
+
+using namespace dto;
+
+namespace
+{
+    const int itemsCount = 100;
+
+    MissionItemPtr createItem(int missionId, int sequence)
+    {
+        MissionItemPtr item = MissionItemPtr::create();
+        item->setMissionId(missionId);
+        item->setSequence(sequence);
+        item->setCommand(MissionItem::Waypoint);
+        item->setLatitude(55.97 + sequence * 1e-4);
+        item->setLongitude(37.11);
+        item->setAltitude(150);
+        item->setParameter(MissionItem::Radius, 50);
+        return item;
+    }
+}
+
+void GenericRepositoryBenchmark::initTestCase()
+{
+    db::GenericRepository<Mission> missionRepository("missions");
+
+    MissionPtr mission = MissionPtr::create();
+    mission->setName("Repository benchmark");
+    QVERIFY(missionRepository.insert(mission));
+
+    m_missionId = mission->id();
+}
+
+void GenericRepositoryBenchmark::cleanupTestCase()
+{
+    QSqlQuery query;
+    query.exec("DELETE FROM mission_items WHERE missionId = " + QString::number(m_missionId));
+    query.exec("DELETE FROM missions WHERE id = " + QString::number(m_missionId));
+}
+
+void GenericRepositoryBenchmark::benchmarkInsert()
+{
+    db::GenericRepository<MissionItem> repository("mission_items");
+
+    QBENCHMARK
+    {
+        for (int i = 0; i < ::itemsCount; ++i)
+        {
+            QVERIFY(repository.insert(::createItem(m_missionId, i)));
+        }
+    }
+}
+
+void GenericRepositoryBenchmark::benchmarkRead_data()
+{
+    QTest::addColumn<bool>("reload");
+
+    QTest::newRow("cached") << false;
+    QTest::newRow("reload") << true;
+}
+
+void GenericRepositoryBenchmark::benchmarkRead()
+{
+    QFETCH(bool, reload);
+
+    db::GenericRepository<MissionItem> repository("mission_items");
+    QList<int> ids = repository.selectId("WHERE missionId = " + QString::number(m_missionId));
+    ids = ids.mid(0, ::itemsCount);
+    QCOMPARE(ids.count(), ::itemsCount);
+
+    for (int id: ids) repository.read(id);
+
+    QBENCHMARK
+    {
+        for (int id: ids) QVERIFY(!repository.read(id, reload).isNull());
+    }
+}
+
+void GenericRepositoryBenchmark::benchmarkUpdate()
+{
+    db::GenericRepository<MissionItem> repository("mission_items");
+    QList<int> ids = repository.selectId("WHERE missionId = " + QString::number(m_missionId));
+    ids = ids.mid(0, ::itemsCount);
+
+    MissionItemPtrList items;
+    for (int id: ids) items.append(repository.read(id));
+
+    int altitude = 0;
+
+    QBENCHMARK
+    {
+        altitude++;
+
+        for (const MissionItemPtr& item: items)
+        {
+            item->setAltitude(altitude);
+            QVERIFY(repository.update(item));
+        }
+    }
+}
+
+void GenericRepositoryBenchmark::benchmarkSaveAll_data()
+{
+    QTest::addColumn<bool>("bulk");
+
+    QTest::newRow("save per item") << false;
+    QTest::newRow("saveAll") << true;
+}
+
+void GenericRepositoryBenchmark::benchmarkSaveAll()
+{
+    QFETCH(bool, bulk);
+
+    db::GenericRepository<MissionItem> repository("mission_items");
+
+    // Download like write: half of items are new, half are resequenced
+    QBENCHMARK
+    {
+        MissionItemPtrList items;
+        for (int i = 0; i < ::itemsCount; ++i) items.append(::createItem(m_missionId, i));
+        QVERIFY(repository.saveAll(items.mid(0, ::itemsCount / 2)));
+
+        for (const MissionItemPtr& item: items) item->setSequence(item->sequence() + 1);
+
+        if (bulk)
+        {
+            QVERIFY(repository.saveAll(items));
+        }
+        else
+        {
+            for (const MissionItemPtr& item: items) QVERIFY(repository.save(item));
+        }
+    }
+}
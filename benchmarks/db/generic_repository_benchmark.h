@@ -0,0 +1,28 @@
+#ifndef GENERIC_REPOSITORY_BENCHMARK_H
+#define GENERIC_REPOSITORY_BENCHMARK_H
+
+#include <QTest>
+
+class GenericRepositoryBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkInsert();
+
+    void benchmarkRead_data();
+    void benchmarkRead();
+
+    void benchmarkUpdate();
+
+    void benchmarkSaveAll_data();
+    void benchmarkSaveAll();
+
+private:
+    int m_missionId = 0;
+};
+
+#endif // GENERIC_REPOSITORY_BENCHMARK_H
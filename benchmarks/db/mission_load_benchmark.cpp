@@ -0,0 +1,99 @@
+#include "mission_load_benchmark.h"
+
+// Qt
+#include <QSqlQuery>
+#include <QDebug>
+
+// Internal
+#include "generic_repository.h"
+#include "mission.h"
+#include "mission_item.h"
+#include "mission_service.h"
+
+using namespace dto;
+
+namespace
+{
+    const int itemsCount = 50000;
+}
+
+void MissionLoadBenchmark::initTestCase()
+{
+    db::GenericRepository<Mission> missionRepository("missions");
+
+    MissionPtr mission = MissionPtr::create();
+    mission->setName("Load benchmark");
+    QVERIFY(missionRepository.insert(mission));
+    m_missionId = mission->id();
+
+    MissionItemPtrList items;
+    for (int i = 0; i < ::itemsCount; ++i)
+    {
+        MissionItemPtr item = MissionItemPtr::create();
+        item->setMissionId(m_missionId);
+        item->setSequence(i);
+        item->setCommand(MissionItem::Waypoint);
+        item->setLatitude(55.97 + i * 1e-6);
+        item->setLongitude(37.11);
+        item->setAltitude(150);
+        item->setParameter(MissionItem::Radius, 50);
+        items.append(item);
+    }
+
+    db::GenericRepository<MissionItem> itemRepository("mission_items");
+    QVERIFY(itemRepository.saveAll(items));
+}
+
+void MissionLoadBenchmark::cleanupTestCase()
+{
+    QSqlQuery query;
+    query.exec("DELETE FROM mission_items WHERE missionId = " + QString::number(m_missionId));
+    query.exec("DELETE FROM missions WHERE id = " + QString::number(m_missionId));
+}
+
+void MissionLoadBenchmark::benchmarkLoad_data()
+{
+    QTest::addColumn<bool>("loadAll");
+
+    QTest::newRow("selectId + read") << false;
+    QTest::newRow("loadAll") << true;
+}
+
+void MissionLoadBenchmark::benchmarkLoad()
+{
+    QFETCH(bool, loadAll);
+
+    int loaded = 0;
+
+    // Cold load, like the services do at startup
+    QBENCHMARK
+    {
+        db::GenericRepository<MissionItem> repository("mission_items");
+
+        if (loadAll)
+        {
+            repository.loadAll();
+        }
+        else
+        {
+            for (int id: repository.selectId()) repository.read(id);
+        }
+
+        loaded = repository.loadedIds().count();
+    }
+
+    QVERIFY(loaded >= ::itemsCount);
+}
+
+void MissionLoadBenchmark::benchmarkServiceStartup()
+{
+    int loaded = 0;
+
+    QBENCHMARK
+    {
+        domain::MissionService service;
+        loaded = service.missionItems(m_missionId).count();
+    }
+
+    QCOMPARE(loaded, ::itemsCount);
+}
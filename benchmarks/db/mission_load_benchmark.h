@@ -0,0 +1,23 @@
+#ifndef MISSION_LOAD_BENCHMARK_H
+#define MISSION_LOAD_BENCHMARK_H
+
+#include <QTest>
+
+class MissionLoadBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkLoad_data();
+    void benchmarkLoad();
+
+    void benchmarkServiceStartup();
+
+private:
+    int m_missionId = 0;
+};
+
+#endif // MISSION_LOAD_BENCHMARK_H
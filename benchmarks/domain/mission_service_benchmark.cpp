@@ -0,0 +1,86 @@
+#include "mission_service_benchmark.h"
+
+// Qt
+#include <QDebug>
+
+// Internal
+#include "service_registry.h"
+#include "mission_service.h"
+#include "mission.h"
+#include "mission_item.h"
+
+using namespace dto;
+
+namespace
+{
+    const int missionsCount = 10;
+    const int itemsCount = 50; // per mission
+}
+
+void MissionServiceBenchmark::initTestCase()
+{
+    domain::MissionService* service = serviceRegistry->missionService();
+
+    // Benchmark database is recreated every run, so missions are not removed
+    for (int i = 0; i < ::missionsCount; ++i)
+    {
+        MissionPtr mission = MissionPtr::create();
+        mission->setName("Benchmark mission " + QString::number(i));
+        QVERIFY(service->save(mission));
+
+        for (int sequence = 0; sequence < ::itemsCount; ++sequence)
+        {
+            MissionItemPtr item = MissionItemPtr::create();
+            item->setMissionId(mission->id());
+            item->setSequence(sequence);
+            item->setCommand(MissionItem::Waypoint);
+            item->setLatitude(55.97 + sequence * 1e-4);
+            item->setLongitude(37.11 + i * 1e-3);
+            item->setAltitude(150);
+            QVERIFY(service->save(item));
+        }
+
+        m_missionIds.append(mission->id());
+    }
+}
+
+void MissionServiceBenchmark::benchmarkMissionItems()
+{
+    domain::MissionService* service = serviceRegistry->missionService();
+    int count = 0;
+
+    QBENCHMARK
+    {
+        count = 0;
+        for (int missionId: m_missionIds) count += service->missionItems(missionId).count();
+    }
+
+    QCOMPARE(count, ::missionsCount * ::itemsCount);
+}
+
+void MissionServiceBenchmark::benchmarkMissionItem()
+{
+    domain::MissionService* service = serviceRegistry->missionService();
+    int missionId = m_missionIds.last();
+
+    QBENCHMARK
+    {
+        for (int sequence = 0; sequence < ::itemsCount; ++sequence)
+        {
+            QVERIFY(!service->missionItem(missionId, sequence).isNull());
+        }
+    }
+}
+
+void MissionServiceBenchmark::benchmarkAllMissionItems()
+{
+    domain::MissionService* service = serviceRegistry->missionService();
+    int count = 0;
+
+    QBENCHMARK
+    {
+        count = service->missionItems().count();
+    }
+
+    QVERIFY(count >= ::missionsCount * ::itemsCount);
+}
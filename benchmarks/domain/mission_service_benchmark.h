@@ -0,0 +1,21 @@
+#ifndef MISSION_SERVICE_BENCHMARK_H
+#define MISSION_SERVICE_BENCHMARK_H
+
+#include <QTest>
+
+class MissionServiceBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void benchmarkMissionItems();
+    void benchmarkMissionItem();
+    void benchmarkAllMissionItems();
+
+private:
+    QList<int> m_missionIds;
+};
+
+#endif // MISSION_SERVICE_BENCHMARK_H
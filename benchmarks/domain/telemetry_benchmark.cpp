@@ -0,0 +1,112 @@
+#include "telemetry_benchmark.h"
+
+// Qt
+#include <QGeoCoordinate>
+#include <QScopedPointer>
+#include <QDebug>
+
+// Internal
+#include "telemetry.h"
+#include "vehicle_telemetry_factory.h"
+
+using namespace domain;
+
+namespace
+{
+    const int setsCount = 1000;
+}
+
+void TelemetryBenchmark::initTestCase()
+{
+    qRegisterMetaType<Telemetry::TelemetryList>("Telemetry::TelemetryList");
+    qRegisterMetaType<Telemetry::TelemetryMap>("Telemetry::TelemetryMap");
+}
+
+void TelemetryBenchmark::benchmarkSetParameter_data()
+{
+    QTest::addColumn<int>("kind");
+    QTest::addColumn<bool>("changing");
+
+    QTest::newRow("real leaf, changing") << 0 << true;
+    QTest::newRow("real leaf, same value") << 0 << false;
+    QTest::newRow("bool leaf, changing") << 1 << true;
+    QTest::newRow("coordinate, changing") << 2 << true;
+    QTest::newRow("coordinate, same value") << 2 << false;
+}
+
+void TelemetryBenchmark::benchmarkSetParameter()
+{
+    QFETCH(int, kind);
+    QFETCH(bool, changing);
+
+    VehicleTelemetryFactory factory;
+    QScopedPointer<Telemetry> node(factory.create());
+
+    Telemetry* ahrs = node->childNode(Telemetry::Ahrs);
+    Telemetry* system = node->childNode(Telemetry::System);
+    Telemetry* position = node->childNode(Telemetry::Position);
+
+    QBENCHMARK
+    {
+        for (int i = 0; i < ::setsCount; ++i)
+        {
+            int value = changing ? i : 0;
+
+            switch (kind)
+            {
+            case 0:
+                ahrs->setParameter(Telemetry::Pitch, value * 0.1);
+                break;
+            case 1:
+                system->setParameter(Telemetry::Armed, bool(value % 2));
+                break;
+            default:
+                position->setParameter(Telemetry::Coordinate, QVariant::fromValue(
+                                           QGeoCoordinate(55.97 + value * 1e-6, 37.11, 150)));
+                break;
+            }
+        }
+    }
+}
+
+void TelemetryBenchmark::benchmarkNotify_data()
+{
+    QTest::addColumn<int>("listeners");
+
+    QTest::newRow("no listeners") << 0;
+    QTest::newRow("1 listener") << 1;
+    QTest::newRow("10 listeners") << 10;
+}
+
+void TelemetryBenchmark::benchmarkNotify()
+{
+    QFETCH(int, listeners);
+
+    VehicleTelemetryFactory factory;
+    QScopedPointer<Telemetry> node(factory.create());
+    Telemetry* ahrs = node->childNode(Telemetry::Ahrs);
+
+    int notifications = 0;
+    for (int i = 0; i < listeners; ++i)
+    {
+        QObject::connect(ahrs, &Telemetry::parametersChanged,
+                         [&notifications]() { notifications++; });
+    }
+
+    int value = 0;
+
+    // ATTITUDE like portion, published from the root node as handlers do
+    QBENCHMARK
+    {
+        value++;
+        ahrs->setParameter(Telemetry::Pitch, value + 0.1);
+        ahrs->setParameter(Telemetry::Roll, value + 0.2);
+        ahrs->setParameter(Telemetry::Yaw, value + 0.3);
+        ahrs->setParameter(Telemetry::PitchSpeed, value + 0.4);
+        ahrs->setParameter(Telemetry::RollSpeed, value + 0.5);
+        ahrs->setParameter(Telemetry::YawSpeed, value + 0.6);
+        node->notify();
+    }
+
+    QCOMPARE(notifications, listeners * value);
+}
@@ -0,0 +1,20 @@
+#ifndef TELEMETRY_BENCHMARK_H
+#define TELEMETRY_BENCHMARK_H
+
+#include <QTest>
+
+class TelemetryBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void benchmarkSetParameter_data();
+    void benchmarkSetParameter();
+
+    void benchmarkNotify_data();
+    void benchmarkNotify();
+};
+
+#endif // TELEMETRY_BENCHMARK_H
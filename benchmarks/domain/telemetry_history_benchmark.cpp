@@ -0,0 +1,106 @@
+#include "telemetry_history_benchmark.h"
+
+// Qt
+#include <QTemporaryDir>
+#include <QtMath>
+#include <QDebug>
+
+// Internal
+#include "telemetry_schema.h"
+#include "telemetry_history.h"
+
+using namespace domain;
+
+namespace
+{
+    const int vehiclesCount = 20;
+    const int leavesCount = 100;
+    const int rate = 50;
+    const qint64 startTime = 1500000000000;
+
+    QVector<const telemetry_schema::Leaf*> recordedLeaves(TelemetryHistory& history)
+    {
+        QVector<const telemetry_schema::Leaf*> leaves;
+
+        for (int slot = 0; slot < telemetry_schema::SlotCount; ++slot)
+        {
+            history.setRecorded(slot, true); // Variant leaves are refused
+        }
+
+        // Schema has less recorded leaves, so some are fed twice as often
+        for (int i = 0; leaves.count() < ::leavesCount; ++i)
+        {
+            int slot = i % telemetry_schema::SlotCount;
+            if (history.isRecorded(slot)) leaves.append(&telemetry_schema::slotLeaf(slot));
+        }
+
+        return leaves;
+    }
+}
+
+void TelemetryHistoryBenchmark::benchmarkIngest()
+{
+    QTemporaryDir dir;
+    TelemetryHistory history;
+    QVERIFY(history.open(dir.path()));
+
+    QVector<const telemetry_schema::Leaf*> leaves = ::recordedLeaves(history);
+    qint64 time = ::startTime;
+
+    // Iteration is one second of the whole fleet
+    QBENCHMARK
+    {
+        for (int tick = 0; tick < ::rate; ++tick)
+        {
+            time += 1000 / ::rate;
+
+            for (int vehicle = 1; vehicle <= ::vehiclesCount; ++vehicle)
+            {
+                for (int i = 0; i < leaves.count(); ++i)
+                {
+                    history.append(vehicle, *leaves[i], qSin(time * 0.001 + i) * vehicle, time);
+                }
+            }
+        }
+    }
+
+    history.flush();
+}
+
+void TelemetryHistoryBenchmark::benchmarkQuery_data()
+{
+    QTest::addColumn<int>("minutes");
+
+    QTest::newRow("1 minute") << 1;
+    QTest::newRow("10 minutes") << 10;
+    QTest::newRow("60 minutes") << 60;
+}
+
+void TelemetryHistoryBenchmark::benchmarkQuery()
+{
+    QFETCH(int, minutes);
+
+    QTemporaryDir dir;
+    TelemetryHistory history;
+    history.setRecorded(telemetry_schema::Ahrs_Pitch, true);
+    QVERIFY(history.open(dir.path()));
+
+    // Hour of the one leaf, query window is in the middle
+    const telemetry_schema::Leaf& leaf = telemetry_schema::slotLeaf(telemetry_schema::Ahrs_Pitch);
+    const int samples = 60 * 60 * ::rate;
+    for (int i = 0; i < samples; ++i)
+    {
+        history.append(1, leaf, qSin(i * 0.01) * 15, ::startTime + i * 1000 / ::rate);
+    }
+    history.flush();
+
+    qint64 from = ::startTime + (60 - minutes) * 30000;
+    qint64 to = from + minutes * 60000;
+
+    QBENCHMARK
+    {
+        QVector<TelemetryHistory::Sample> result = history.query(1, Telemetry::Ahrs,
+                                                                 Telemetry::Pitch, from, to);
+        QVERIFY(!result.isEmpty());
+    }
+}
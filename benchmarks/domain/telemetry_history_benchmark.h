@@ -0,0 +1,17 @@
+#ifndef TELEMETRY_HISTORY_BENCHMARK_H
+#define TELEMETRY_HISTORY_BENCHMARK_H
+
+#include <QTest>
+
+class TelemetryHistoryBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkIngest();
+
+    void benchmarkQuery_data();
+    void benchmarkQuery();
+};
+
+#endif // TELEMETRY_HISTORY_BENCHMARK_H
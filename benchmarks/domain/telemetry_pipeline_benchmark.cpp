@@ -0,0 +1,191 @@
+#include "telemetry_pipeline_benchmark.h"
+
+// Qt
+#include <QThread>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+#include <QDebug>
+
+// Internal
+#include "telemetry_portion.h"
+#include "telemetry_pipeline.h"
+#include "vehicle_telemetry_factory.h"
+
+using namespace domain;
+
+namespace
+{
+    const int vehiclesCount = 20;
+    const int portionsCount = 250; // per vehicle
+    const int parametersCount = 6; // ATTITUDE like portion
+    const int timeout = 10000;
+
+    QAtomicInteger<quint64> posted;
+    QAtomicInteger<quint64> processed;
+
+    class MetaCallCounter: public QObject
+    {
+    protected:
+        bool eventFilter(QObject* watched, QEvent* event) override
+        {
+            if (event->type() == QEvent::MetaCall) ::processed.fetchAndAddRelaxed(1);
+            return QObject::eventFilter(watched, event);
+        }
+    };
+
+    // Decodes telemetry in the own thread, like the communication thread does
+    class Producer: public QThread
+    {
+    public:
+        Producer(const QList<Telemetry*>& nodes, bool pipeline):
+            m_nodes(nodes),
+            m_pipeline(pipeline)
+        {}
+
+    protected:
+        void run() override
+        {
+            for (int i = 0; i < ::portionsCount; ++i)
+            {
+                for (Telemetry* node: m_nodes)
+                {
+                    if (m_pipeline) this->pipelinePortion(node, i);
+                    else this->queuedPortion(node, i);
+                }
+            }
+        }
+
+    private:
+        void pipelinePortion(Telemetry* node, int value)
+        {
+            TelemetryPortion portion(node);
+            portion.setParameter({ Telemetry::Ahrs, Telemetry::Pitch }, value + 0.1);
+            portion.setParameter({ Telemetry::Ahrs, Telemetry::Roll }, value + 0.2);
+            portion.setParameter({ Telemetry::Ahrs, Telemetry::Yaw }, value + 0.3);
+            portion.setParameter({ Telemetry::Ahrs, Telemetry::PitchSpeed }, value + 0.4);
+            portion.setParameter({ Telemetry::Ahrs, Telemetry::RollSpeed }, value + 0.5);
+            portion.setParameter({ Telemetry::Ahrs, Telemetry::YawSpeed }, value + 0.6);
+        }
+
+        void queuedPortion(Telemetry* node, int value)
+        {
+            {
+                QueuedTelemetryPortion portion(node);
+                portion.setParameter({ Telemetry::Ahrs, Telemetry::Pitch }, value + 0.1);
+                portion.setParameter({ Telemetry::Ahrs, Telemetry::Roll }, value + 0.2);
+                portion.setParameter({ Telemetry::Ahrs, Telemetry::Yaw }, value + 0.3);
+                portion.setParameter({ Telemetry::Ahrs, Telemetry::PitchSpeed }, value + 0.4);
+                portion.setParameter({ Telemetry::Ahrs, Telemetry::RollSpeed }, value + 0.5);
+                portion.setParameter({ Telemetry::Ahrs, Telemetry::YawSpeed }, value + 0.6);
+            }
+            ::posted.fetchAndAddRelaxed(::parametersCount + 1);
+        }
+
+        const QList<Telemetry*> m_nodes;
+        const bool m_pipeline;
+    };
+}
+
+QueuedTelemetryPortion::QueuedTelemetryPortion(Telemetry* node):
+    QObject(nullptr),
+    m_node(node)
+{
+    connect(this, &QueuedTelemetryPortion::setParameter,
+            node, QOverload<const Telemetry::TelemetryList&, const QVariant&>::of(
+                &Telemetry::setParameter));
+}
+
+QueuedTelemetryPortion::~QueuedTelemetryPortion()
+{
+    QMetaObject::invokeMethod(m_node, "notify", Qt::QueuedConnection);
+}
+
+void TelemetryPipelineBenchmark::initTestCase()
+{
+    qRegisterMetaType<Telemetry::TelemetryList>("Telemetry::TelemetryList");
+    qRegisterMetaType<Telemetry::TelemetryMap>("Telemetry::TelemetryMap");
+}
+
+void TelemetryPipelineBenchmark::benchmarkVehiclesLoad_data()
+{
+    QTest::addColumn<bool>("pipeline");
+
+    QTest::newRow("queued signals, 20 vehicles") << false;
+    QTest::newRow("spsc pipeline, 20 vehicles") << true;
+}
+
+void TelemetryPipelineBenchmark::benchmarkVehiclesLoad()
+{
+    QFETCH(bool, pipeline);
+
+    TelemetryPipeline telemetryPipeline;
+    VehicleTelemetryFactory factory;
+    QList<Telemetry*> nodes;
+
+    int notifications = 0;
+    for (int i = 0; i < ::vehiclesCount; ++i)
+    {
+        Telemetry* node = factory.create();
+        if (pipeline) node->setPipeline(&telemetryPipeline);
+
+        QObject::connect(node->childNode(Telemetry::Ahrs), &Telemetry::parametersChanged,
+                         [&notifications]() { notifications++; });
+        nodes.append(node);
+    }
+
+    MetaCallCounter counter;
+    QCoreApplication::instance()->installEventFilter(&counter);
+
+    quint64 peakDepth = 0;
+    quint64 coalesced = 0;
+    qint64 elapsed = 0;
+
+    QBENCHMARK
+    {
+        ::posted.store(0);
+        ::processed.store(0);
+        quint64 drains = telemetryPipeline.drains();
+        quint64 merged = telemetryPipeline.coalesced();
+        notifications = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        Producer producer(nodes, pipeline);
+        telemetryPipeline.setProducer(&producer);
+        producer.start();
+
+        // Portions, coalesced while the ring is full, come with one notification
+        auto expected = [&]() {
+            return ::vehiclesCount * ::portionsCount -
+                    int(telemetryPipeline.coalesced() - merged);
+        };
+
+        while ((!producer.isFinished() || notifications < expected() ||
+                (pipeline && telemetryPipeline.drains() < telemetryPipeline.wakeups())) &&
+               !timer.hasExpired(::timeout))
+        {
+            quint64 sent = pipeline ? telemetryPipeline.wakeups() : ::posted.load();
+            quint64 done = pipeline ? telemetryPipeline.drains() : ::processed.load();
+            if (sent > done) peakDepth = qMax(peakDepth, sent - done);
+
+            QCoreApplication::processEvents();
+        }
+        producer.wait();
+
+        elapsed += timer.nsecsElapsed();
+        if (pipeline) ::processed.store(telemetryPipeline.drains() - drains);
+
+        QCOMPARE(notifications, expected());
+        coalesced += telemetryPipeline.coalesced() - merged;
+    }
+
+    QCoreApplication::instance()->removeEventFilter(&counter);
+    qDeleteAll(nodes);
+
+    qDebug() << "Parameters per second:" << qRound64(double(::vehiclesCount) *
+                ::portionsCount * ::parametersCount * 1e9 / qMax(elapsed, qint64(1)));
+    qDebug() << "GUI thread events per iteration:" << ::processed.load()
+             << "peak queue depth:" << peakDepth << "coalesced portions:" << coalesced;
+}
@@ -0,0 +1,36 @@
+#ifndef TELEMETRY_PIPELINE_BENCHMARK_H
+#define TELEMETRY_PIPELINE_BENCHMARK_H
+
+#include <QTest>
+
+// Internal
+#include "telemetry.h"
+
+// Portion as it was before pipeline: queued signal per parameter and queued notify
+class QueuedTelemetryPortion: public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QueuedTelemetryPortion(domain::Telemetry* node);
+    ~QueuedTelemetryPortion() override;
+
+signals:
+    void setParameter(const domain::Telemetry::TelemetryList& path, const QVariant& value);
+
+private:
+    domain::Telemetry* m_node;
+};
+
+class TelemetryPipelineBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void benchmarkVehiclesLoad_data();
+    void benchmarkVehiclesLoad();
+};
+
+#endif // TELEMETRY_PIPELINE_BENCHMARK_H
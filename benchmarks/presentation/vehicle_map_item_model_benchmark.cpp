@@ -0,0 +1,107 @@
+#include "vehicle_map_item_model_benchmark.h"
+
+// Qt
+#include <QGeoCoordinate>
+#include <QDebug>
+
+// Internal
+#include "service_registry.h"
+#include "vehicle_service.h"
+#include "vehicle.h"
+#include "telemetry_service.h"
+#include "telemetry.h"
+
+#include "vehicle_map_item_model.h"
+
+using namespace presentation;
+
+namespace
+{
+    const int vehiclesCount = 20;
+    const int firstMavId = 100;
+
+    const QList<int> roles = {
+        VehicleMapItemModel::VehicleIdRole, VehicleMapItemModel::VehicleNameRole,
+        VehicleMapItemModel::VehicleTypeRole, VehicleMapItemModel::VehicleOnlineRole,
+        VehicleMapItemModel::CoordinateRole, VehicleMapItemModel::HomeCoordinateRole,
+        VehicleMapItemModel::TargetCoordinateRole, VehicleMapItemModel::HeadingRole,
+        VehicleMapItemModel::CourseRole, VehicleMapItemModel::GroundspeedRole,
+        VehicleMapItemModel::SnsFixRole, VehicleMapItemModel::HdopRadiusRole,
+        VehicleMapItemModel::TrackRole };
+}
+
+void VehicleMapItemModelBenchmark::initTestCase()
+{
+    domain::VehicleService* vehicleService = serviceRegistry->vehicleService();
+    domain::TelemetryService* telemetryService = serviceRegistry->telemetryService();
+
+    for (int i = 0; i < ::vehiclesCount; ++i)
+    {
+        dto::VehiclePtr vehicle = dto::VehiclePtr::create();
+        vehicle->setMavId(::firstMavId + i);
+        vehicle->setName("Benchmark vehicle " + QString::number(i));
+        vehicle->setType(dto::Vehicle::FixedWing);
+        QVERIFY(vehicleService->save(vehicle));
+
+        domain::Telemetry* node = telemetryService->vehicleNode(vehicle->id());
+        QVERIFY(node);
+
+        node->childNode(domain::Telemetry::Position)->setParameter(
+                    domain::Telemetry::Coordinate,
+                    QVariant::fromValue(QGeoCoordinate(55.97 + i * 1e-3, 37.11, 150)));
+        node->childNode(domain::Telemetry::Satellite)->setParameter(
+                    domain::Telemetry::Groundspeed, 20.5);
+        node->childNode(domain::Telemetry::Ahrs)->childNode(domain::Telemetry::Compass)->
+                setParameter(domain::Telemetry::Heading, 90.0);
+        node->notify();
+
+        m_vehicles.append(vehicle);
+    }
+}
+
+void VehicleMapItemModelBenchmark::cleanupTestCase()
+{
+    for (const dto::VehiclePtr& vehicle: m_vehicles)
+    {
+        serviceRegistry->vehicleService()->remove(vehicle);
+    }
+}
+
+void VehicleMapItemModelBenchmark::benchmarkData_data()
+{
+    QTest::addColumn<int>("role");
+
+    QTest::newRow("all roles") << 0;
+    QTest::newRow("coordinate") << int(VehicleMapItemModel::CoordinateRole);
+    QTest::newRow("heading") << int(VehicleMapItemModel::HeadingRole);
+    QTest::newRow("name") << int(VehicleMapItemModel::VehicleNameRole);
+}
+
+void VehicleMapItemModelBenchmark::benchmarkData()
+{
+    QFETCH(int, role);
+
+    VehicleMapItemModel model(serviceRegistry->vehicleService(),
+                              serviceRegistry->telemetryService());
+    QVERIFY(model.rowCount() >= ::vehiclesCount);
+
+    const QList<int> queried = role ? QList<int>({ role }) : ::roles;
+    int valid = 0;
+
+    // Map delegates read every role on any change of the row
+    QBENCHMARK
+    {
+        valid = 0;
+
+        for (int row = 0; row < model.rowCount(); ++row)
+        {
+            QModelIndex index = model.index(row);
+            for (int queriedRole: queried)
+            {
+                if (model.data(index, queriedRole).isValid()) valid++;
+            }
+        }
+    }
+
+    QCOMPARE(valid, model.rowCount() * queried.count());
+}
@@ -0,0 +1,24 @@
+#ifndef VEHICLE_MAP_ITEM_MODEL_BENCHMARK_H
+#define VEHICLE_MAP_ITEM_MODEL_BENCHMARK_H
+
+#include <QTest>
+
+// Internal
+#include "dto_traits.h"
+
+class VehicleMapItemModelBenchmark: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkData_data();
+    void benchmarkData();
+
+private:
+    dto::VehiclePtrList m_vehicles;
+};
+
+#endif // VEHICLE_MAP_ITEM_MODEL_BENCHMARK_H
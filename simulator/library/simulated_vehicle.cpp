@@ -0,0 +1,1073 @@
+#include "simulated_vehicle.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QDateTime>
+#include <QtMath>
+
+// Std
+#include <string.h>
+
+namespace
+{
+    struct StreamInfo
+    {
+        const char* name;
+        quint32 msgId;
+        float rate;
+    };
+
+    const StreamInfo streams[] =
+    {
+        { "HEARTBEAT", MAVLINK_MSG_ID_HEARTBEAT, 1 },
+        { "SYS_STATUS", MAVLINK_MSG_ID_SYS_STATUS, 1 },
+        { "SYSTEM_TIME", MAVLINK_MSG_ID_SYSTEM_TIME, 1 },
+        { "ATTITUDE", MAVLINK_MSG_ID_ATTITUDE, 10 },
+        { "GLOBAL_POSITION_INT", MAVLINK_MSG_ID_GLOBAL_POSITION_INT, 5 },
+        { "GPS_RAW_INT", MAVLINK_MSG_ID_GPS_RAW_INT, 2 },
+        { "VFR_HUD", MAVLINK_MSG_ID_VFR_HUD, 4 },
+        { "NAV_CONTROLLER_OUTPUT", MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT, 2 },
+        { "ALTITUDE", MAVLINK_MSG_ID_ALTITUDE, 2 },
+        { "SCALED_PRESSURE", MAVLINK_MSG_ID_SCALED_PRESSURE, 1 },
+        { "VIBRATION", MAVLINK_MSG_ID_VIBRATION, 1 },
+        { "RADIO_STATUS", MAVLINK_MSG_ID_RADIO_STATUS, 1 },
+        { "MISSION_CURRENT", MAVLINK_MSG_ID_MISSION_CURRENT, 1 },
+        { "HOME_POSITION", MAVLINK_MSG_ID_HOME_POSITION, 0.2f }
+    };
+
+    // ArduPlane custom modes
+    const quint32 autoMode = 10;
+    const quint32 rtlMode = 11;
+    const quint32 guidedMode = 15;
+
+    const qint64 retryInterval = 1000; // ms, mission item request retry
+    const double earthRadius = 6378137;
+    const double gravity = 9.81;
+
+    // Default fleet is spread on a grid around the default map center
+    const double centerLatitude = 55.968954;
+    const double centerLongitude = 37.110155;
+    const int gridSize = 16;
+
+    bool isGlobalFrame(quint8 frame)
+    {
+        return frame == MAV_FRAME_GLOBAL || frame == MAV_FRAME_GLOBAL_INT ||
+                frame == MAV_FRAME_GLOBAL_RELATIVE_ALT ||
+                frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT;
+    }
+
+    // Plans are kept as MISSION_ITEM_INT, float items are converted on the way
+    mavlink_mission_item_int_t toIntItem(const mavlink_mission_item_t& item)
+    {
+        mavlink_mission_item_int_t intItem = {};
+        double scale = ::isGlobalFrame(item.frame) ? 1e7 : 1;
+
+        intItem.param1 = item.param1;
+        intItem.param2 = item.param2;
+        intItem.param3 = item.param3;
+        intItem.param4 = item.param4;
+        intItem.x = qRound(item.x * scale);
+        intItem.y = qRound(item.y * scale);
+        intItem.z = item.z;
+        intItem.seq = item.seq;
+        intItem.command = item.command;
+        intItem.frame = item.frame;
+        intItem.current = item.current;
+        intItem.autocontinue = item.autocontinue;
+
+        return intItem;
+    }
+
+    mavlink_mission_item_t toFloatItem(const mavlink_mission_item_int_t& item)
+    {
+        mavlink_mission_item_t floatItem = {};
+        double scale = ::isGlobalFrame(item.frame) ? 1e7 : 1;
+
+        floatItem.param1 = item.param1;
+        floatItem.param2 = item.param2;
+        floatItem.param3 = item.param3;
+        floatItem.param4 = item.param4;
+        floatItem.x = item.x / scale;
+        floatItem.y = item.y / scale;
+        floatItem.z = item.z;
+        floatItem.seq = item.seq;
+        floatItem.command = item.command;
+        floatItem.frame = item.frame;
+        floatItem.current = item.current;
+        floatItem.autocontinue = item.autocontinue;
+
+        return floatItem;
+    }
+}
+
+using namespace sim;
+
+class SimulatedVehicle::Impl
+{
+public:
+    struct Stream
+    {
+        quint32 msgId;
+        qint64 period; // ms, zero if disabled
+        qint64 due;
+    };
+
+    quint8 mavId;
+    quint8 channel;
+    QVector<Stream> streams;
+
+    double originLatitude;
+    double originLongitude;
+    float originAltitude = 200;
+
+    float radius;
+    float airspeed = 20;
+    float targetAltitude = 100; // relative
+    bool armed = true;
+    quint32 customMode = ::autoMode;
+
+    qint64 lastTime = 0;
+    double angle;
+    double latitude = 0;
+    double longitude = 0;
+    float altitude = 0; // relative
+    float climb = 0;
+    float roll = 0;
+    float pitch = 0;
+    float course = 0;
+
+    QVector<mavlink_mission_item_int_t> mission;
+    QVector<mavlink_mission_item_int_t> fence;
+    QVector<mavlink_mission_item_int_t> rally;
+    QVector<mavlink_mission_item_int_t> uploading;
+    quint8 uploadType = MAV_MISSION_TYPE_MISSION;
+    int uploadSeq = -1;
+    int uploadEnd = -1; // last sequence of full or partial upload
+    qint64 uploadRequested = 0;
+    quint8 gcsSysId = 0;
+    quint8 gcsCompId = 0;
+    int current = 0;
+    quint64 manualSamples = 0;
+    MissionInt missionInt = MissionInt::Supported;
+    bool partialWrites = true;
+
+    mavlink_message_t* append(MessageList& output)
+    {
+        output.append(mavlink_message_t());
+        return &output.last();
+    }
+
+    QVector<mavlink_mission_item_int_t>* plan(quint8 type)
+    {
+        switch (type)
+        {
+        case MAV_MISSION_TYPE_MISSION:
+            return &mission;
+        case MAV_MISSION_TYPE_FENCE:
+            return &fence;
+        case MAV_MISSION_TYPE_RALLY:
+            return &rally;
+        default:
+            return nullptr;
+        }
+    }
+
+    static quint8 missionType(const mavlink_message_t& message)
+    {
+#ifdef MAVLINK_V2
+        switch (message.msgid)
+        {
+        case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+            return mavlink_msg_mission_request_list_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_REQUEST:
+            return mavlink_msg_mission_request_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+            return mavlink_msg_mission_request_int_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_COUNT:
+            return mavlink_msg_mission_count_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_ITEM:
+            return mavlink_msg_mission_item_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+            return mavlink_msg_mission_item_int_get_mission_type(&message);
+        default:
+            break;
+        }
+#else
+        Q_UNUSED(message)
+#endif
+        return MAV_MISSION_TYPE_MISSION;
+    }
+
+    void model(qint64 timeMs)
+    {
+        float dt = (timeMs - lastTime) / 1000.0f;
+        lastTime = timeMs;
+
+        angle += airspeed / radius * dt;
+        climb = qBound(-3.0f, targetAltitude - altitude, 3.0f);
+        altitude += climb * dt;
+
+        course = angle + M_PI_2;
+        roll = qAtan(airspeed * airspeed / (radius * ::gravity));
+        pitch = qAtan2(climb, airspeed);
+
+        double north = radius * qCos(angle);
+        double east = radius * qSin(angle);
+        latitude = originLatitude + qRadiansToDegrees(north / ::earthRadius);
+        longitude = originLongitude + qRadiansToDegrees(
+                        east / (::earthRadius * qCos(qDegreesToRadians(originLatitude))));
+    }
+
+    float heading() const
+    {
+        float degrees = ::fmod(qRadiansToDegrees(course), 360.0f);
+        return degrees < 0 ? degrees + 360 : degrees;
+    }
+
+    float yaw() const
+    {
+        float degrees = this->heading();
+        return qDegreesToRadians(degrees > 180 ? degrees - 360 : degrees);
+    }
+
+    void sendStream(quint32 msgId, qint64 timeMs, MessageList& output)
+    {
+        switch (msgId)
+        {
+        case MAVLINK_MSG_ID_HEARTBEAT:
+            this->sendHeartbeat(output);
+            break;
+        case MAVLINK_MSG_ID_SYS_STATUS:
+            this->sendSysStatus(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_SYSTEM_TIME:
+            this->sendSystemTime(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_ATTITUDE:
+            this->sendAttitude(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+            this->sendGlobalPosition(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_GPS_RAW_INT:
+            this->sendGpsRaw(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_VFR_HUD:
+            this->sendVfrHud(output);
+            break;
+        case MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT:
+            this->sendNavController(output);
+            break;
+        case MAVLINK_MSG_ID_ALTITUDE:
+            this->sendAltitude(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_SCALED_PRESSURE:
+            this->sendScaledPressure(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_VIBRATION:
+            this->sendVibration(timeMs, output);
+            break;
+        case MAVLINK_MSG_ID_RADIO_STATUS:
+            this->sendRadioStatus(output);
+            break;
+        case MAVLINK_MSG_ID_MISSION_CURRENT:
+            if (!mission.isEmpty()) this->sendMissionCurrent(output);
+            break;
+        case MAVLINK_MSG_ID_HOME_POSITION:
+            this->sendHomePosition(output);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void sendHeartbeat(MessageList& output)
+    {
+        mavlink_heartbeat_t heartbeat = {};
+
+        heartbeat.type = MAV_TYPE_FIXED_WING;
+        heartbeat.autopilot = MAV_AUTOPILOT_ARDUPILOTMEGA;
+        heartbeat.base_mode = MAV_MODE_FLAG_CUSTOM_MODE_ENABLED;
+        if (armed) heartbeat.base_mode |= MAV_MODE_FLAG_SAFETY_ARMED;
+        heartbeat.custom_mode = customMode;
+        heartbeat.system_status = armed ? MAV_STATE_ACTIVE : MAV_STATE_STANDBY;
+        heartbeat.mavlink_version = 3;
+
+        mavlink_msg_heartbeat_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                          this->append(output), &heartbeat);
+    }
+
+    void sendSysStatus(qint64 timeMs, MessageList& output)
+    {
+        mavlink_sys_status_t status = {};
+
+        status.onboard_control_sensors_present = MAV_SYS_STATUS_SENSOR_3D_GYRO |
+                                                 MAV_SYS_STATUS_SENSOR_3D_ACCEL |
+                                                 MAV_SYS_STATUS_SENSOR_3D_MAG |
+                                                 MAV_SYS_STATUS_SENSOR_ABSOLUTE_PRESSURE |
+                                                 MAV_SYS_STATUS_SENSOR_GPS;
+        status.onboard_control_sensors_enabled = status.onboard_control_sensors_present;
+        status.onboard_control_sensors_health = status.onboard_control_sensors_present;
+        status.load = 250;
+        status.voltage_battery = 12600 - timeMs / 1000 % 1800;
+        status.current_battery = armed ? 1250 : 50;
+        status.battery_remaining = 100 - timeMs / 18000 % 100;
+
+        mavlink_msg_sys_status_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                           this->append(output), &status);
+    }
+
+    void sendSystemTime(qint64 timeMs, MessageList& output)
+    {
+        mavlink_system_time_t time = {};
+
+        time.time_unix_usec = QDateTime::currentMSecsSinceEpoch() * 1000;
+        time.time_boot_ms = timeMs;
+
+        mavlink_msg_system_time_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                            this->append(output), &time);
+    }
+
+    void sendAttitude(qint64 timeMs, MessageList& output)
+    {
+        mavlink_attitude_t attitude = {};
+
+        attitude.time_boot_ms = timeMs;
+        attitude.roll = roll;
+        attitude.pitch = pitch;
+        attitude.yaw = this->yaw();
+        attitude.yawspeed = airspeed / radius;
+
+        mavlink_msg_attitude_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                         this->append(output), &attitude);
+    }
+
+    void sendGlobalPosition(qint64 timeMs, MessageList& output)
+    {
+        mavlink_global_position_int_t position = {};
+
+        position.time_boot_ms = timeMs;
+        position.lat = latitude * 1e7;
+        position.lon = longitude * 1e7;
+        position.alt = (originAltitude + altitude) * 1000;
+        position.relative_alt = altitude * 1000;
+        position.vx = -airspeed * qSin(angle) * 100;
+        position.vy = airspeed * qCos(angle) * 100;
+        position.vz = -climb * 100;
+        position.hdg = this->heading() * 100;
+
+        mavlink_msg_global_position_int_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                    this->append(output), &position);
+    }
+
+    void sendGpsRaw(qint64 timeMs, MessageList& output)
+    {
+        mavlink_gps_raw_int_t gps = {};
+
+        gps.time_usec = timeMs * 1000;
+        gps.fix_type = GPS_FIX_TYPE_3D_FIX;
+        gps.lat = latitude * 1e7;
+        gps.lon = longitude * 1e7;
+        gps.alt = (originAltitude + altitude) * 1000;
+        gps.eph = 120;
+        gps.epv = 180;
+        gps.vel = airspeed * 100;
+        gps.cog = this->heading() * 100;
+        gps.satellites_visible = 12;
+
+        mavlink_msg_gps_raw_int_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                            this->append(output), &gps);
+    }
+
+    void sendVfrHud(MessageList& output)
+    {
+        mavlink_vfr_hud_t hud = {};
+
+        hud.airspeed = airspeed;
+        hud.groundspeed = airspeed;
+        hud.heading = this->heading();
+        hud.throttle = armed ? 55 : 0;
+        hud.alt = originAltitude + altitude;
+        hud.climb = climb;
+
+        mavlink_msg_vfr_hud_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                        this->append(output), &hud);
+    }
+
+    void sendNavController(MessageList& output)
+    {
+        mavlink_nav_controller_output_t nav = {};
+
+        nav.nav_roll = qRadiansToDegrees(roll);
+        nav.nav_pitch = qRadiansToDegrees(pitch);
+        nav.nav_bearing = this->heading();
+        nav.target_bearing = this->heading();
+        nav.wp_dist = radius;
+        nav.alt_error = targetAltitude - altitude;
+
+        mavlink_msg_nav_controller_output_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                      this->append(output), &nav);
+    }
+
+    void sendAltitude(qint64 timeMs, MessageList& output)
+    {
+        mavlink_altitude_t alt = {};
+
+        alt.time_usec = timeMs * 1000;
+        alt.altitude_monotonic = originAltitude + altitude;
+        alt.altitude_amsl = originAltitude + altitude;
+        alt.altitude_local = altitude;
+        alt.altitude_relative = altitude;
+        alt.altitude_terrain = altitude;
+        alt.bottom_clearance = altitude;
+
+        mavlink_msg_altitude_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                         this->append(output), &alt);
+    }
+
+    void sendScaledPressure(qint64 timeMs, MessageList& output)
+    {
+        mavlink_scaled_pressure_t pressure = {};
+
+        pressure.time_boot_ms = timeMs;
+        pressure.press_abs = 1013.25f * qPow(1 - 2.25577e-5 * (originAltitude + altitude),
+                                             5.25588);
+        pressure.press_diff = 0.5 * 1.225 * airspeed * airspeed / 100;
+        pressure.temperature = 1500;
+
+        mavlink_msg_scaled_pressure_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                this->append(output), &pressure);
+    }
+
+    void sendVibration(qint64 timeMs, MessageList& output)
+    {
+        mavlink_vibration_t vibration = {};
+
+        vibration.time_usec = timeMs * 1000;
+        vibration.vibration_x = 2 + qSin(angle * 7);
+        vibration.vibration_y = 2 + qCos(angle * 5);
+        vibration.vibration_z = 4 + qSin(angle * 3);
+
+        mavlink_msg_vibration_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                          this->append(output), &vibration);
+    }
+
+    void sendRadioStatus(MessageList& output)
+    {
+        mavlink_radio_status_t radio = {};
+
+        radio.rssi = 180;
+        radio.remrssi = 175;
+        radio.txbuf = 95;
+        radio.noise = 40;
+        radio.remnoise = 42;
+
+        mavlink_msg_radio_status_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                             this->append(output), &radio);
+    }
+
+    void sendMissionCurrent(MessageList& output)
+    {
+        mavlink_mission_current_t missionCurrent = {};
+
+        missionCurrent.seq = current;
+
+        mavlink_msg_mission_current_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                this->append(output), &missionCurrent);
+    }
+
+    void sendHomePosition(MessageList& output)
+    {
+        mavlink_home_position_t home = {};
+
+        home.latitude = originLatitude * 1e7;
+        home.longitude = originLongitude * 1e7;
+        home.altitude = originAltitude * 1000;
+        home.q[0] = 1;
+
+        mavlink_msg_home_position_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                              this->append(output), &home);
+    }
+
+    void sendMissionCount(quint8 type, MessageList& output)
+    {
+        QVector<mavlink_mission_item_int_t>* items = this->plan(type);
+        if (!items)
+        {
+            this->sendMissionAck(type, MAV_MISSION_UNSUPPORTED, output);
+            return;
+        }
+
+        mavlink_mission_count_t count = {};
+
+        count.target_system = gcsSysId;
+        count.target_component = gcsCompId;
+        count.count = items->count();
+#ifdef MAVLINK_V2
+        count.mission_type = type;
+#endif
+
+        mavlink_msg_mission_count_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                              this->append(output), &count);
+    }
+
+    // Item goes in the form it was requested
+    void sendMissionItem(const mavlink_message_t& request, MessageList& output)
+    {
+        bool integer = request.msgid == MAVLINK_MSG_ID_MISSION_REQUEST_INT;
+        quint8 type = this->missionType(request);
+        quint16 seq = integer ? mavlink_msg_mission_request_int_get_seq(&request) :
+                                mavlink_msg_mission_request_get_seq(&request);
+
+        if (integer && missionInt != MissionInt::Supported)
+        {
+            if (missionInt == MissionInt::Rejected)
+            {
+                this->sendMissionAck(type, MAV_MISSION_UNSUPPORTED, output);
+            }
+            return;
+        }
+
+        QVector<mavlink_mission_item_int_t>* items = this->plan(type);
+        if (!items || seq >= items->count())
+        {
+            this->sendMissionAck(type, MAV_MISSION_INVALID_SEQUENCE, output);
+            return;
+        }
+
+        mavlink_mission_item_int_t item = items->at(seq);
+
+        item.target_system = gcsSysId;
+        item.target_component = gcsCompId;
+        item.current = type == MAV_MISSION_TYPE_MISSION && seq == current;
+#ifdef MAVLINK_V2
+        item.mission_type = type;
+#endif
+
+        if (integer)
+        {
+            mavlink_msg_mission_item_int_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                     this->append(output), &item);
+            return;
+        }
+
+        mavlink_mission_item_t floatItem = ::toFloatItem(item);
+
+        floatItem.target_system = gcsSysId;
+        floatItem.target_component = gcsCompId;
+#ifdef MAVLINK_V2
+        floatItem.mission_type = type;
+#endif
+
+        mavlink_msg_mission_item_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                             this->append(output), &floatItem);
+    }
+
+    // Like ArduPilot, upload items are requested with MISSION_REQUEST_INT, if it is supported
+    void requestMissionItem(qint64 timeMs, MessageList& output)
+    {
+        uploadRequested = timeMs;
+
+        if (missionInt == MissionInt::Supported)
+        {
+            mavlink_mission_request_int_t request = {};
+
+            request.target_system = gcsSysId;
+            request.target_component = gcsCompId;
+            request.seq = uploadSeq;
+#ifdef MAVLINK_V2
+            request.mission_type = uploadType;
+#endif
+
+            mavlink_msg_mission_request_int_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                        this->append(output), &request);
+            return;
+        }
+
+        mavlink_mission_request_t request = {};
+
+        request.target_system = gcsSysId;
+        request.target_component = gcsCompId;
+        request.seq = uploadSeq;
+#ifdef MAVLINK_V2
+        request.mission_type = uploadType;
+#endif
+
+        mavlink_msg_mission_request_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                this->append(output), &request);
+    }
+
+    void sendMissionAck(quint8 missionType, quint8 type, MessageList& output)
+    {
+        mavlink_mission_ack_t ack = {};
+
+        ack.target_system = gcsSysId;
+        ack.target_component = gcsCompId;
+        ack.type = type;
+#ifdef MAVLINK_V2
+        ack.mission_type = missionType;
+#else
+        Q_UNUSED(missionType)
+#endif
+
+        mavlink_msg_mission_ack_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                            this->append(output), &ack);
+    }
+
+    void sendCommandAck(quint16 command, quint8 result, MessageList& output)
+    {
+        mavlink_command_ack_t ack = {};
+
+        ack.command = command;
+        ack.result = result;
+
+        mavlink_msg_command_ack_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                            this->append(output), &ack);
+    }
+
+    void sendAutopilotVersion(MessageList& output)
+    {
+        mavlink_autopilot_version_t version = {};
+
+        version.capabilities = MAV_PROTOCOL_CAPABILITY_MISSION_FLOAT |
+                               MAV_PROTOCOL_CAPABILITY_PARAM_FLOAT |
+                               MAV_PROTOCOL_CAPABILITY_SET_ATTITUDE_TARGET;
+        if (missionInt == MissionInt::Supported)
+        {
+            version.capabilities |= MAV_PROTOCOL_CAPABILITY_MISSION_INT;
+        }
+#ifdef MAVLINK_V2
+        version.capabilities |= MAV_PROTOCOL_CAPABILITY_MAVLINK2 |
+                                MAV_PROTOCOL_CAPABILITY_MISSION_FENCE |
+                                MAV_PROTOCOL_CAPABILITY_MISSION_RALLY;
+#endif
+        version.flight_sw_version = 0x03080000;
+
+        mavlink_msg_autopilot_version_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                                  this->append(output), &version);
+    }
+
+    void sendParamValue(const mavlink_param_set_t& set, MessageList& output)
+    {
+        mavlink_param_value_t value = {};
+
+        ::strncpy(value.param_id, set.param_id, sizeof(value.param_id));
+        value.param_value = set.param_value;
+        value.param_type = set.param_type;
+        value.param_count = 1;
+        value.param_index = UINT16_MAX;
+
+        mavlink_msg_param_value_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                            this->append(output), &value);
+    }
+
+    void processTimesync(const mavlink_message_t& message, qint64 timeMs, MessageList& output)
+    {
+        mavlink_timesync_t timesync;
+        mavlink_msg_timesync_decode(&message, &timesync);
+        if (timesync.tc1) return; // answer of the other side
+
+        timesync.tc1 = timeMs * 1000000;
+        mavlink_msg_timesync_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                         this->append(output), &timesync);
+    }
+
+    void processPing(const mavlink_message_t& message, MessageList& output)
+    {
+        mavlink_ping_t ping;
+        mavlink_msg_ping_decode(&message, &ping);
+        if (ping.target_system) return; // answer to the other side
+
+        ping.target_system = message.sysid;
+        ping.target_component = message.compid;
+        mavlink_msg_ping_encode_chan(mavId, MAV_COMP_ID_AUTOPILOT1, channel,
+                                     this->append(output), &ping);
+    }
+
+    void processMissionCount(const mavlink_message_t& message, qint64 timeMs,
+                             MessageList& output)
+    {
+        mavlink_mission_count_t count;
+        mavlink_msg_mission_count_decode(&message, &count);
+
+        quint8 type = this->missionType(message);
+        if (!this->plan(type))
+        {
+            this->sendMissionAck(type, MAV_MISSION_UNSUPPORTED, output);
+            return;
+        }
+
+        uploadType = type;
+        uploading.fill(mavlink_mission_item_int_t(), count.count);
+        uploadEnd = count.count - 1;
+
+        if (count.count)
+        {
+            uploadSeq = 0;
+            this->requestMissionItem(timeMs, output);
+        }
+        else
+        {
+            uploadSeq = -1;
+            this->plan(type)->clear();
+            if (type == MAV_MISSION_TYPE_MISSION) current = 0;
+            this->sendMissionAck(type, MAV_MISSION_ACCEPTED, output);
+        }
+    }
+
+    // Like ArduPilot, items of the range are replaced, the rest of the plan is kept
+    void processWritePartialList(const mavlink_message_t& message, qint64 timeMs,
+                                 MessageList& output)
+    {
+        mavlink_mission_write_partial_list_t partial;
+        mavlink_msg_mission_write_partial_list_decode(&message, &partial);
+
+        quint8 type = MAV_MISSION_TYPE_MISSION;
+#ifdef MAVLINK_V2
+        type = partial.mission_type;
+#endif
+
+        if (!partialWrites)
+        {
+            this->sendMissionAck(type, MAV_MISSION_UNSUPPORTED, output);
+            return;
+        }
+
+        QVector<mavlink_mission_item_int_t>* items = this->plan(type);
+        if (!items || partial.start_index < 0 || partial.end_index < partial.start_index ||
+            partial.end_index >= items->count())
+        {
+            this->sendMissionAck(type, MAV_MISSION_ERROR, output);
+            return;
+        }
+
+        uploadType = type;
+        uploading = *items;
+        uploadSeq = partial.start_index;
+        uploadEnd = partial.end_index;
+        this->requestMissionItem(timeMs, output);
+    }
+
+    void processMissionItem(const mavlink_message_t& message, qint64 timeMs,
+                            MessageList& output)
+    {
+        mavlink_mission_item_int_t item;
+        if (message.msgid == MAVLINK_MSG_ID_MISSION_ITEM_INT)
+        {
+            mavlink_msg_mission_item_int_decode(&message, &item);
+        }
+        else
+        {
+            mavlink_mission_item_t floatItem;
+            mavlink_msg_mission_item_decode(&message, &floatItem);
+            item = ::toIntItem(floatItem);
+        }
+
+        quint8 type = this->missionType(message);
+
+        if (item.current == 2) // guided waypoint
+        {
+            originLatitude = item.x / 1e7;
+            originLongitude = item.y / 1e7;
+            targetAltitude = item.z;
+            customMode = ::guidedMode;
+            this->sendMissionAck(type, MAV_MISSION_ACCEPTED, output);
+            return;
+        }
+
+        if (item.current == 3) // guided altitude change
+        {
+            targetAltitude = item.z;
+            this->sendMissionAck(type, MAV_MISSION_ACCEPTED, output);
+            return;
+        }
+
+        if (uploadSeq < 0 || type != uploadType) return;
+
+        if (item.seq != uploadSeq)
+        {
+            this->requestMissionItem(timeMs, output);
+            return;
+        }
+
+        uploading[uploadSeq] = item;
+
+        if (uploadSeq < uploadEnd)
+        {
+            ++uploadSeq;
+            this->requestMissionItem(timeMs, output);
+            return;
+        }
+
+        uploadSeq = -1;
+        *this->plan(uploadType) = uploading;
+        uploading.clear();
+        current = qMax(0, qMin(current, mission.count() - 1));
+        this->sendMissionAck(uploadType, MAV_MISSION_ACCEPTED, output);
+    }
+
+    void processCommandLong(const mavlink_message_t& message, MessageList& output)
+    {
+        mavlink_command_long_t command;
+        mavlink_msg_command_long_decode(&message, &command);
+
+        quint8 result = MAV_RESULT_ACCEPTED;
+
+        switch (command.command)
+        {
+        case MAV_CMD_COMPONENT_ARM_DISARM:
+            armed = command.param1 > 0.5f;
+            break;
+        case MAV_CMD_DO_SET_MODE:
+            customMode = command.param2;
+            break;
+        case MAV_CMD_NAV_RETURN_TO_LAUNCH:
+            customMode = ::rtlMode;
+            break;
+        case MAV_CMD_DO_CHANGE_SPEED:
+            if (command.param2 > 0) airspeed = command.param2;
+            break;
+        case MAV_CMD_REQUEST_AUTOPILOT_CAPABILITIES:
+            this->sendAutopilotVersion(output);
+            break;
+        default:
+            break;
+        }
+
+        this->sendCommandAck(command.command, result, output);
+    }
+
+};
+
+SimulatedVehicle::SimulatedVehicle(quint8 mavId, quint8 channel):
+    d(new Impl())
+{
+    d->mavId = mavId;
+    d->channel = channel;
+
+    int index = mavId - 1;
+    d->originLatitude = ::centerLatitude + (index % ::gridSize) * 0.005;
+    d->originLongitude = ::centerLongitude + (index / ::gridSize) * 0.008;
+    d->radius = 150 + (mavId % ::gridSize) * 10;
+    d->angle = mavId * 0.7;
+    d->altitude = d->targetAltitude;
+    d->model(0);
+
+    for (const StreamInfo& info: ::streams) this->setStreamRate(info.msgId, info.rate);
+}
+
+SimulatedVehicle::~SimulatedVehicle()
+{}
+
+quint8 SimulatedVehicle::mavId() const
+{
+    return d->mavId;
+}
+
+bool SimulatedVehicle::isArmed() const
+{
+    return d->armed;
+}
+
+quint32 SimulatedVehicle::customMode() const
+{
+    return d->customMode;
+}
+
+int SimulatedVehicle::missionCount() const
+{
+    return d->mission.count();
+}
+
+int SimulatedVehicle::planCount(quint8 missionType) const
+{
+    QVector<mavlink_mission_item_int_t>* items = d->plan(missionType);
+    return items ? items->count() : 0;
+}
+
+int SimulatedVehicle::currentItem() const
+{
+    return d->current;
+}
+
+quint64 SimulatedVehicle::manualSamples() const
+{
+    return d->manualSamples;
+}
+
+SimulatedVehicle::MissionInt SimulatedVehicle::missionInt() const
+{
+    return d->missionInt;
+}
+
+void SimulatedVehicle::setMissionInt(MissionInt missionInt)
+{
+    d->missionInt = missionInt;
+}
+
+bool SimulatedVehicle::partialWrites() const
+{
+    return d->partialWrites;
+}
+
+void SimulatedVehicle::setPartialWrites(bool partialWrites)
+{
+    d->partialWrites = partialWrites;
+}
+
+float SimulatedVehicle::streamRate(quint32 msgId) const
+{
+    for (const Impl::Stream& stream: d->streams)
+    {
+        if (stream.msgId == msgId) return stream.period ? 1000.0f / stream.period : 0;
+    }
+
+    return 0;
+}
+
+void SimulatedVehicle::setStreamRate(quint32 msgId, float rate)
+{
+    qint64 period = rate > 0 ? qMax(qint64(1), qRound64(1000 / rate)) : 0;
+
+    for (Impl::Stream& stream: d->streams)
+    {
+        if (stream.msgId != msgId) continue;
+
+        stream.period = period;
+        return;
+    }
+
+    // Vehicles start streams with a phase shift not to send everything at once
+    Impl::Stream stream;
+    stream.msgId = msgId;
+    stream.period = period;
+    stream.due = period ? (d->mavId * 13) % period : 0;
+    d->streams.append(stream);
+}
+
+void SimulatedVehicle::setOrigin(double latitude, double longitude, float altitude)
+{
+    d->originLatitude = latitude;
+    d->originLongitude = longitude;
+    d->originAltitude = altitude;
+}
+
+void SimulatedVehicle::update(qint64 timeMs, MessageList& output)
+{
+    d->model(timeMs);
+
+    for (Impl::Stream& stream: d->streams)
+    {
+        if (!stream.period || timeMs < stream.due) continue;
+
+        d->sendStream(stream.msgId, timeMs, output);
+
+        // Skip missed periods after a stall instead of bursting them
+        stream.due += stream.period;
+        if (stream.due <= timeMs) stream.due = timeMs + stream.period;
+    }
+
+    if (d->uploadSeq >= 0 && timeMs - d->uploadRequested > ::retryInterval)
+    {
+        d->requestMissionItem(timeMs, output);
+    }
+}
+
+void SimulatedVehicle::processMessage(const mavlink_message_t& message, qint64 timeMs,
+                                      MessageList& output)
+{
+    d->gcsSysId = message.sysid;
+    d->gcsCompId = message.compid;
+
+    switch (message.msgid)
+    {
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+        d->sendMissionCount(Impl::missionType(message), output);
+        break;
+    case MAVLINK_MSG_ID_MISSION_REQUEST:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+        d->sendMissionItem(message, output);
+        break;
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+        d->processMissionCount(message, timeMs, output);
+        break;
+    case MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST:
+        d->processWritePartialList(message, timeMs, output);
+        break;
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+        d->processMissionItem(message, timeMs, output);
+        break;
+    case MAVLINK_MSG_ID_MISSION_SET_CURRENT:
+    {
+        quint16 seq = mavlink_msg_mission_set_current_get_seq(&message);
+        if (seq < d->mission.count()) d->current = seq;
+        d->sendMissionCurrent(output);
+        break;
+    }
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+        d->processCommandLong(message, output);
+        break;
+    case MAVLINK_MSG_ID_SET_MODE:
+        d->customMode = mavlink_msg_set_mode_get_custom_mode(&message);
+        break;
+    case MAVLINK_MSG_ID_PARAM_SET:
+    {
+        mavlink_param_set_t set;
+        mavlink_msg_param_set_decode(&message, &set);
+        d->sendParamValue(set, output);
+        break;
+    }
+    case MAVLINK_MSG_ID_TIMESYNC:
+        d->processTimesync(message, timeMs, output);
+        break;
+    case MAVLINK_MSG_ID_PING:
+        d->processPing(message, output);
+        break;
+    case MAVLINK_MSG_ID_MANUAL_CONTROL: // routed as broadcast, its target is not target_system
+        if (mavlink_msg_manual_control_get_target(&message) == d->mavId) d->manualSamples++;
+        break;
+    case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
+    case MAVLINK_MSG_ID_SET_ATTITUDE_TARGET:
+        d->manualSamples++;
+        break;
+    default: // messages of the ground station, vehicle doesn't handle
+        break;
+    }
+}
+
+QStringList SimulatedVehicle::streamNames()
+{
+    QStringList names;
+    for (const StreamInfo& info: ::streams) names.append(info.name);
+    return names;
+}
+
+quint32 SimulatedVehicle::streamId(const QString& name)
+{
+    for (const StreamInfo& info: ::streams)
+    {
+        if (!name.compare(info.name, Qt::CaseInsensitive)) return info.msgId;
+    }
+
+    return UINT32_MAX;
+}
+
+QList<quint32> SimulatedVehicle::defaultStreams()
+{
+    QList<quint32> msgIds;
+    for (const StreamInfo& info: ::streams) msgIds.append(info.msgId);
+    return msgIds;
+}
+
+float SimulatedVehicle::defaultRate(quint32 msgId)
+{
+    for (const StreamInfo& info: ::streams)
+    {
+        if (info.msgId == msgId) return info.rate;
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef SIMULATED_VEHICLE_H
+#define SIMULATED_VEHICLE_H
+
+// Qt
+#include <QVector>
+#include <QScopedPointer>
+#include <QStringList>
+
+// MAVLink
+#include <mavlink_types.h>
+
+namespace sim
+{
+    using MessageList = QVector<mavlink_message_t>;
+
+    // Fixed wing on a circular track, it streams telemetry and answers the mission, command,
+    // timesync and ping protocols, handled by the ground station MissionHandler and CommandHandler
+    class SimulatedVehicle
+    {
+    public:
+        // Older autopilots have no MISSION_ITEM_INT, they reject or ignore its requests
+        enum class MissionInt
+        {
+            Supported,
+            Rejected,
+            Ignored
+        };
+
+        SimulatedVehicle(quint8 mavId, quint8 channel);
+        ~SimulatedVehicle();
+
+        quint8 mavId() const;
+
+        bool isArmed() const;
+        quint32 customMode() const;
+        int missionCount() const;
+        int planCount(quint8 missionType) const; // Items of MAV_MISSION_TYPE plan
+        int currentItem() const;
+        quint64 manualSamples() const; // MANUAL_CONTROL, RC override and attitude target
+
+        MissionInt missionInt() const;
+        void setMissionInt(MissionInt missionInt);
+
+        // MISSION_WRITE_PARTIAL_LIST is handled like ArduPilot does or rejected
+        bool partialWrites() const;
+        void setPartialWrites(bool partialWrites);
+
+        float streamRate(quint32 msgId) const;
+        void setStreamRate(quint32 msgId, float rate); // Hz, zero disables stream
+
+        void setOrigin(double latitude, double longitude, float altitude);
+
+        // Appends due stream messages and protocol retries to the output
+        void update(qint64 timeMs, MessageList& output);
+        void processMessage(const mavlink_message_t& message, qint64 timeMs,
+                            MessageList& output);
+
+        static QStringList streamNames();
+        static quint32 streamId(const QString& name); // UINT32_MAX for unknown names
+        static QList<quint32> defaultStreams();
+        static float defaultRate(quint32 msgId);
+
+    private:
+        class Impl;
+        QScopedPointer<Impl> const d;
+
+        Q_DISABLE_COPY(SimulatedVehicle)
+    };
+}
+
+#endif // SIMULATED_VEHICLE_H
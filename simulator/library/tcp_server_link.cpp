@@ -0,0 +1,95 @@
+#include "tcp_server_link.h"
+
+// Qt
+#include <QTcpServer>
+#include <QTcpSocket>
+
+using namespace sim;
+
+TcpServerLink::TcpServerLink(quint16 port, QObject* parent):
+    comm::AbstractLink(parent),
+    m_server(new QTcpServer(this)),
+    m_port(port)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &TcpServerLink::onNewConnection);
+}
+
+bool TcpServerLink::isConnected() const
+{
+    return m_server->isListening();
+}
+
+quint16 TcpServerLink::port() const
+{
+    return m_port;
+}
+
+int TcpServerLink::clientCount() const
+{
+    return m_clients.count();
+}
+
+void TcpServerLink::connectLink()
+{
+    if (this->isConnected()) return;
+
+    if (m_server->listen(QHostAddress::Any, m_port)) emit connectedChanged(true);
+    else emit errored(m_server->errorString());
+}
+
+void TcpServerLink::disconnectLink()
+{
+    if (!this->isConnected()) return;
+
+    for (QTcpSocket* client: m_clients) client->disconnectFromHost();
+    m_server->close();
+
+    emit connectedChanged(false);
+}
+
+void TcpServerLink::setPort(quint16 port)
+{
+    if (m_port == port) return;
+
+    m_port = port;
+
+    if (this->isConnected())
+    {
+        this->disconnectLink();
+        this->connectLink();
+    }
+}
+
+bool TcpServerLink::sendDataImpl(const QByteArray& data)
+{
+    bool sent = false;
+    for (QTcpSocket* client: m_clients)
+    {
+        if (client->write(data) > 0) sent = true;
+    }
+
+    return sent;
+}
+
+void TcpServerLink::onNewConnection()
+{
+    while (QTcpSocket* client = m_server->nextPendingConnection())
+    {
+        m_clients.append(client);
+
+        connect(client, &QTcpSocket::readyRead, this, [this, client]() {
+            qint64 size = 0;
+            while ((size = client->bytesAvailable()) > 0)
+            {
+                size = client->read(this->receiveBuffer(size), size);
+                if (size <= 0) break;
+
+                this->receiveBufferedData(size);
+            }
+        });
+        connect(client, &QTcpSocket::disconnected, this, [this, client]() {
+            m_clients.removeOne(client);
+            client->deleteLater();
+        });
+    }
+}
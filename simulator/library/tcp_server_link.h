@@ -0,0 +1,44 @@
+#ifndef TCP_SERVER_LINK_H
+#define TCP_SERVER_LINK_H
+
+// Internal
+#include "abstract_link.h"
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace sim
+{
+    // Listening side for ground station TcpLink, data is sent to every accepted client
+    class TcpServerLink: public comm::AbstractLink
+    {
+        Q_OBJECT
+
+    public:
+        TcpServerLink(quint16 port = 0, QObject* parent = nullptr);
+
+        bool isConnected() const override;
+
+        quint16 port() const;
+        int clientCount() const;
+
+    public slots:
+        void connectLink() override;
+        void disconnectLink() override;
+
+        void setPort(quint16 port);
+
+    protected:
+        bool sendDataImpl(const QByteArray& data) override;
+
+    private slots:
+        void onNewConnection();
+
+    private:
+        QTcpServer* m_server;
+        QList<QTcpSocket*> m_clients;
+        quint16 m_port;
+    };
+}
+
+#endif // TCP_SERVER_LINK_H
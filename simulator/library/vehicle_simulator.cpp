@@ -0,0 +1,276 @@
+#include "vehicle_simulator.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QMap>
+
+// Std
+#include <string.h>
+
+// Internal
+#include "abstract_link.h"
+#include "mavlink_frame_parser.h"
+
+namespace
+{
+    const int defaultInterval = 10; // ms
+    const int maxMavId = 254; // 255 is reserved for ground station
+
+    // Target system of message, zero for broadcast and for messages without target, as MAVLink
+    // routing does. Vehicles ignore messages they don't handle.
+    int targetSystem(const mavlink_message_t& message)
+    {
+#ifdef MAVLINK_V2
+        const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(message.msgid);
+        if (!entry || !(entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM)) return 0;
+
+        // Trailing zero bytes of MAVLink 2 payload are truncated
+        if (entry->target_system_ofs >= message.len) return 0;
+
+        return _MAV_PAYLOAD(&message)[entry->target_system_ofs];
+#else
+        static const mavlink_message_info_t infos[256] = MAVLINK_MESSAGE_INFO;
+
+        const mavlink_message_info_t& info = infos[message.msgid];
+        for (unsigned i = 0; i < info.num_fields; ++i)
+        {
+            if (::strcmp(info.fields[i].name, "target_system")) continue;
+
+            return _MAV_PAYLOAD(&message)[info.fields[i].wire_offset];
+        }
+
+        return 0;
+#endif
+    }
+}
+
+using namespace sim;
+
+class VehicleSimulator::Impl
+{
+public:
+    quint8 channel;
+    comm::AbstractLink* link = nullptr;
+    comm::MavLinkFrameParser parser;
+
+    QVector<SimulatedVehicle*> vehicles;
+    quint8 firstMavId = 1;
+    QMap<quint32, float> rates; // overrides for every vehicle
+
+    QTimer timer;
+    QElapsedTimer time;
+    bool packed = false;
+
+    MessageList output;
+    QByteArray packet;
+
+    quint64 messagesSent = 0;
+    quint64 messagesReceived = 0;
+    quint64 bytesSent = 0;
+
+    explicit Impl(quint8 channel):
+        channel(channel),
+        parser(channel)
+    {}
+
+    void send()
+    {
+        if (!link || output.isEmpty()) return;
+
+        quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+        packet.resize(0);
+
+        for (const mavlink_message_t& message: output)
+        {
+            int length = mavlink_msg_to_send_buffer(buffer, &message);
+
+            if (packed)
+            {
+                packet.append(reinterpret_cast<const char*>(buffer), length);
+            }
+            else
+            {
+                link->sendData(QByteArray(reinterpret_cast<const char*>(buffer), length));
+            }
+            bytesSent += length;
+        }
+
+        if (packed) link->sendData(packet);
+        messagesSent += output.count();
+        output.clear();
+    }
+};
+
+VehicleSimulator::VehicleSimulator(quint8 channel, QObject* parent):
+    QObject(parent),
+    d(new Impl(channel))
+{
+    d->timer.setTimerType(Qt::PreciseTimer);
+    d->timer.setInterval(::defaultInterval);
+    connect(&d->timer, &QTimer::timeout, this, &VehicleSimulator::onTimeout);
+}
+
+VehicleSimulator::~VehicleSimulator()
+{
+    qDeleteAll(d->vehicles);
+}
+
+comm::AbstractLink* VehicleSimulator::link() const
+{
+    return d->link;
+}
+
+int VehicleSimulator::vehicleCount() const
+{
+    return d->vehicles.count();
+}
+
+SimulatedVehicle* VehicleSimulator::vehicle(quint8 mavId) const
+{
+    return d->vehicles.value(mavId - d->firstMavId, nullptr);
+}
+
+int VehicleSimulator::interval() const
+{
+    return d->timer.interval();
+}
+
+bool VehicleSimulator::isPacked() const
+{
+    return d->packed;
+}
+
+bool VehicleSimulator::isRunning() const
+{
+    return d->timer.isActive();
+}
+
+quint64 VehicleSimulator::messagesSent() const
+{
+    return d->messagesSent;
+}
+
+quint64 VehicleSimulator::messagesReceived() const
+{
+    return d->messagesReceived;
+}
+
+quint64 VehicleSimulator::bytesSent() const
+{
+    return d->bytesSent;
+}
+
+void VehicleSimulator::setLink(comm::AbstractLink* link)
+{
+    if (d->link == link) return;
+
+    if (d->link) delete d->link;
+
+    d->link = link;
+
+    if (link)
+    {
+        link->setParent(this);
+        connect(link, &comm::AbstractLink::dataReceived,
+                this, &VehicleSimulator::onDataReceived);
+    }
+}
+
+void VehicleSimulator::setVehicleCount(int count, quint8 firstMavId)
+{
+    qDeleteAll(d->vehicles);
+    d->vehicles.clear();
+
+    d->firstMavId = qMax(firstMavId, quint8(1));
+    count = qBound(0, count, ::maxMavId - d->firstMavId + 1);
+
+    for (int i = 0; i < count; ++i)
+    {
+        SimulatedVehicle* vehicle = new SimulatedVehicle(d->firstMavId + i, d->channel);
+        for (auto it = d->rates.constBegin(); it != d->rates.constEnd(); ++it)
+        {
+            vehicle->setStreamRate(it.key(), it.value());
+        }
+        d->vehicles.append(vehicle);
+    }
+}
+
+void VehicleSimulator::setStreamRate(quint32 msgId, float rate)
+{
+    d->rates[msgId] = rate;
+
+    for (SimulatedVehicle* vehicle: d->vehicles) vehicle->setStreamRate(msgId, rate);
+}
+
+void VehicleSimulator::setInterval(int interval)
+{
+    d->timer.setInterval(interval);
+}
+
+void VehicleSimulator::setPacked(bool packed)
+{
+    d->packed = packed;
+}
+
+void VehicleSimulator::start()
+{
+    if (this->isRunning()) return;
+
+    if (d->link && !d->link->isConnected()) d->link->connectLink();
+
+    d->time.start();
+    d->timer.start();
+
+    emit runningChanged(true);
+}
+
+void VehicleSimulator::stop()
+{
+    if (!this->isRunning()) return;
+
+    d->timer.stop();
+
+    emit runningChanged(false);
+}
+
+void VehicleSimulator::onTimeout()
+{
+    qint64 timeMs = d->time.elapsed();
+
+    for (SimulatedVehicle* vehicle: d->vehicles)
+    {
+        vehicle->update(timeMs, d->output);
+        d->send();
+    }
+}
+
+void VehicleSimulator::onDataReceived(const QByteArray& data)
+{
+    qint64 timeMs = d->time.isValid() ? d->time.elapsed() : 0;
+    mavlink_message_t message;
+
+    d->parser.setData(data.constData(), data.size());
+    while (d->parser.next(message))
+    {
+        int target = ::targetSystem(message);
+        ++d->messagesReceived;
+
+        if (target == 0) // broadcast
+        {
+            for (SimulatedVehicle* vehicle: d->vehicles)
+            {
+                vehicle->processMessage(message, timeMs, d->output);
+                d->send();
+            }
+        }
+        else if (SimulatedVehicle* vehicle = this->vehicle(target))
+        {
+            vehicle->processMessage(message, timeMs, d->output);
+            d->send();
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef VEHICLE_SIMULATOR_H
+#define VEHICLE_SIMULATOR_H
+
+// Qt
+#include <QObject>
+
+// Internal
+#include "simulated_vehicle.h"
+
+namespace comm
+{
+    class AbstractLink;
+}
+
+namespace sim
+{
+    // Fleet of simulated vehicles sharing one link, as a bunch of autopilots behind one router.
+    // Messages are encoded on a dedicated channel, it must not be taken by a communicator,
+    // running in the same process.
+    class VehicleSimulator: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit VehicleSimulator(quint8 channel = MAVLINK_COMM_NUM_BUFFERS - 1,
+                                  QObject* parent = nullptr);
+        ~VehicleSimulator() override;
+
+        comm::AbstractLink* link() const;
+
+        int vehicleCount() const;
+        SimulatedVehicle* vehicle(quint8 mavId) const;
+
+        int interval() const;
+        bool isPacked() const;
+        bool isRunning() const;
+
+        quint64 messagesSent() const;
+        quint64 messagesReceived() const;
+        quint64 bytesSent() const;
+
+    public slots:
+        void setLink(comm::AbstractLink* link); // Takes ownership
+        void setVehicleCount(int count, quint8 firstMavId = 1);
+        void setStreamRate(quint32 msgId, float rate); // Hz for every vehicle
+        void setInterval(int interval); // ms, simulation step
+        void setPacked(bool packed); // One write per vehicle step instead of per message
+
+        void start();
+        void stop();
+
+    signals:
+        void runningChanged(bool running);
+
+    private slots:
+        void onTimeout();
+        void onDataReceived(const QByteArray& data);
+
+    private:
+        class Impl;
+        QScopedPointer<Impl> const d;
+    };
+}
+
+#endif // VEHICLE_SIMULATOR_H
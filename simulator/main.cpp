@@ -0,0 +1,114 @@
+// Qt
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QHostAddress>
+#include <QTimer>
+#include <QDebug>
+
+// Internal
+#include "vehicle_simulator.h"
+#include "tcp_server_link.h"
+#include "udp_link.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("JAGCS simulator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Simulates MAVLink vehicles for JAGCS load testing");
+    parser.addHelpOption();
+
+    QCommandLineOption vehiclesOption(QStringList({ "n", "vehicles" }),
+                                      "Simulated vehicles count.", "count", "1");
+    QCommandLineOption firstIdOption("first-id", "MAVLink system id of first vehicle.",
+                                     "id", "1");
+    QCommandLineOption hostOption("host", "Ground station address for UDP.",
+                                  "address", "127.0.0.1");
+    QCommandLineOption udpOption("udp", "Ground station UDP port.", "port", "14550");
+    QCommandLineOption bindOption("bind", "Local UDP port.", "port", "14560");
+    QCommandLineOption tcpOption("tcp", "Listen TCP port instead of UDP.", "port");
+    QCommandLineOption rateOption("rate", "Stream rate, repeatable, NAME=HZ. Streams: " +
+                                  sim::SimulatedVehicle::streamNames().join(", ") + ".",
+                                  "stream");
+    QCommandLineOption factorOption("rate-factor", "Multiplies every stream rate.",
+                                    "factor", "1");
+    QCommandLineOption intervalOption("interval", "Simulation step, ms.", "ms", "10");
+    QCommandLineOption packOption("pack", "Pack vehicle messages of one step to one write.");
+    QCommandLineOption durationOption("duration", "Stop after seconds, 0 runs forever.",
+                                      "seconds", "0");
+
+    parser.addOptions({ vehiclesOption, firstIdOption, hostOption, udpOption, bindOption,
+                        tcpOption, rateOption, factorOption, intervalOption, packOption,
+                        durationOption });
+    parser.process(app);
+
+    sim::VehicleSimulator simulator;
+
+    if (parser.isSet(tcpOption))
+    {
+        simulator.setLink(new sim::TcpServerLink(parser.value(tcpOption).toUShort()));
+    }
+    else
+    {
+        comm::UdpLink* link = new comm::UdpLink(parser.value(bindOption).toUShort());
+        link->addEndpoint(comm::Endpoint(QHostAddress(parser.value(hostOption)),
+                                         parser.value(udpOption).toUShort()));
+        simulator.setLink(link);
+    }
+
+    QObject::connect(simulator.link(), &comm::AbstractLink::errored,
+                     [](const QString& error) { qWarning() << error; });
+
+    simulator.setVehicleCount(parser.value(vehiclesOption).toInt(),
+                              parser.value(firstIdOption).toUShort());
+    simulator.setInterval(parser.value(intervalOption).toInt());
+    simulator.setPacked(parser.isSet(packOption));
+
+    float factor = parser.value(factorOption).toFloat();
+    QMap<quint32, float> rates;
+    for (quint32 msgId: sim::SimulatedVehicle::defaultStreams())
+    {
+        rates[msgId] = sim::SimulatedVehicle::defaultRate(msgId);
+    }
+
+    for (const QString& rate: parser.values(rateOption))
+    {
+        quint32 msgId = sim::SimulatedVehicle::streamId(rate.section('=', 0, 0));
+        if (msgId == UINT32_MAX)
+        {
+            qWarning() << "Unknown stream" << rate;
+            return 1;
+        }
+        rates[msgId] = rate.section('=', 1, 1).toFloat();
+    }
+
+    for (auto it = rates.constBegin(); it != rates.constEnd(); ++it)
+    {
+        simulator.setStreamRate(it.key(), it.value() * factor);
+    }
+
+    simulator.start();
+    if (!simulator.link()->isConnected())
+    {
+        qWarning() << "Link is not connected";
+        return 1;
+    }
+
+    QTimer statistics;
+    quint64 lastSent = 0;
+    quint64 lastBytes = 0;
+    QObject::connect(&statistics, &QTimer::timeout, [&]() {
+        qInfo("vehicles %d, sent %llu msg/s, %llu B/s, received %llu msg total",
+              simulator.vehicleCount(), simulator.messagesSent() - lastSent,
+              simulator.bytesSent() - lastBytes, simulator.messagesReceived());
+        lastSent = simulator.messagesSent();
+        lastBytes = simulator.bytesSent();
+    });
+    statistics.start(1000);
+
+    int duration = parser.value(durationOption).toInt();
+    if (duration > 0) QTimer::singleShot(duration * 1000, &app, &QCoreApplication::quit);
+
+    return app.exec();
+}
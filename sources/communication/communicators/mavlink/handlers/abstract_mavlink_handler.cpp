@@ -2,9 +2,16 @@
 
 using namespace comm;
 
-AbstractMavLinkHandler::AbstractMavLinkHandler(MavLinkCommunicator* communicator):
-    m_communicator(communicator)
+AbstractMavLinkHandler::AbstractMavLinkHandler(MavLinkCommunicator* communicator,
+                                               const QList<quint32>& messageIds):
+    m_communicator(communicator),
+    m_messageIds(messageIds)
 {}
 
 AbstractMavLinkHandler::~AbstractMavLinkHandler()
 {}
+
+QList<quint32> AbstractMavLinkHandler::messageIds() const
+{
+    return m_messageIds;
+}
@@ -1,6 +1,9 @@
 #ifndef ABSTRACT_MAVLINK_HANDLER_H
 #define ABSTRACT_MAVLINK_HANDLER_H
 
+// Qt
+#include <QList>
+
 // MAVLink
 #include <mavlink_types.h>
 
@@ -11,13 +14,20 @@ namespace comm
     class AbstractMavLinkHandler // To Processor
     {
     public:
-        explicit AbstractMavLinkHandler(MavLinkCommunicator* communicator);
+        // Empty messageIds means handler will receive every message
+        AbstractMavLinkHandler(MavLinkCommunicator* communicator,
+                               const QList<quint32>& messageIds = QList<quint32>());
         virtual ~AbstractMavLinkHandler();
 
+        QList<quint32> messageIds() const;
+
         virtual void processMessage(const mavlink_message_t& message) = 0;
 
     protected:
         MavLinkCommunicator* const m_communicator;
+
+    private:
+        const QList<quint32> m_messageIds;
     };
 }
 
@@ -15,14 +15,12 @@ using namespace comm;
 using namespace domain;
 
 EkfStatusHandler::EkfStatusHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_EKF_STATUS_REPORT }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void EkfStatusHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_EKF_STATUS_REPORT) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_ekf_status_report_t ekf;
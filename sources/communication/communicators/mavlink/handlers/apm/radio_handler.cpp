@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 RadioHandler::RadioHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_RADIO }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void RadioHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_RADIO) return;
-
     TelemetryPortion portion(m_telemetryService->radioNode());
 
     mavlink_radio_t radio;
@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 RangefinderHandler::RangefinderHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_RANGEFINDER }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void RangefinderHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_RANGEFINDER) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_rangefinder_t rangefinder;
@@ -15,14 +15,12 @@ using namespace comm;
 using namespace domain;
 
 WindHandler::WindHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_WIND }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void WindHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_WIND) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_wind_t wind;
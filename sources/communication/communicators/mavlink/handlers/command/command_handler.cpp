@@ -4,12 +4,16 @@
 #include <mavlink.h>
 
 // Qt
+#include <QElapsedTimer>
+#include <QTimer>
 #include <QDebug>
 
 // Internal
 #include "service_registry.h"
+#include "settings_provider.h"
 
 #include "command_service.h"
+#include "manual_control_channel.h"
 
 #include "telemetry_service.h"
 #include "telemetry_portion.h"
@@ -19,12 +23,16 @@
 
 #include "mavlink_communicator.h"
 #include "mode_helper_factory.h"
+#include "latency_monitor.h"
 
 
 using namespace comm;
 
 namespace
 {
+    const int timesyncInterval = 5000; // ms, round trip of the command retry timeout
+    const int manualInterval = 20; // ms, manual control is sent at 50 Hz at most
+
     const QMap<quint16, dto::Command::CommandType> mavCommandLongMap =
     {
         { MAV_CMD_COMPONENT_ARM_DISARM, dto::Command::ArmDisarm },
@@ -52,6 +60,13 @@ namespace
     {
         return qIsNaN(value) ? std::numeric_limits<std::int32_t>::max() : value * 1000;
     }
+
+    // Channel without impact is ignored by autopilot and stays with RC
+    quint16 toRcChannel(float value)
+    {
+        return qIsNaN(value) ? std::numeric_limits<quint16>::max() :
+                               quint16(1500 + qBound(-1.0f, value, 1.0f) * 500);
+    }
 }
 
 class CommandHandler::Impl
@@ -59,6 +74,8 @@ class CommandHandler::Impl
 public:
     domain::VehicleService* vehicleService = serviceRegistry->vehicleService();
     domain::TelemetryService* telemetryService = serviceRegistry->telemetryService();
+    domain::ManualControlChannel* manualControl =
+            serviceRegistry->commandService()->manualControl();
 
     struct ModeAgregator
     {
@@ -73,17 +90,37 @@ public:
     };
     QMap<quint8, ModeAgregator> modes;
     QMap<quint8, QSharedPointer<IModeHelper> > modeHelpers;
+
+    QElapsedTimer clock;
+    QMap<quint8, qint64> timesyncs; // ns, stamp of the request waiting for the answer
+    QMap<quint8, qint64> timesyncTimes; // ms, last request
+
+    QTimer* manualTimer = nullptr; // Holds the sample back to keep the rate
+    qint64 manualSent = -::manualInterval;
+
+    Impl()
+    {
+        clock.start();
+    }
 };
 
 CommandHandler::CommandHandler(MavLinkCommunicator* communicator):
     AbstractCommandHandler(communicator),
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_COMMAND_ACK, MAVLINK_MSG_ID_HEARTBEAT,
+                                           MAVLINK_MSG_ID_TIMESYNC }),
     d(new Impl())
 {
     serviceRegistry->commandService()->addHandler(this);
 
     connect(d->vehicleService, &domain::VehicleService::vehicleRemoved,
             this, &CommandHandler::onVehicleRemoved);
+
+    // Child timer goes to the communication thread together with the handler
+    d->manualTimer = new QTimer(this);
+    d->manualTimer->setSingleShot(true);
+    connect(d->manualTimer, &QTimer::timeout, this, &CommandHandler::sendManualSample);
+    connect(d->manualControl, &domain::ManualControlChannel::posted,
+            this, &CommandHandler::sendManualSample);
 }
 
 CommandHandler::~CommandHandler()
@@ -93,6 +130,7 @@ void CommandHandler::processMessage(const mavlink_message_t& message)
 {
     if (message.msgid == MAVLINK_MSG_ID_COMMAND_ACK) this->processCommandAck(message);
     else if (message.msgid == MAVLINK_MSG_ID_HEARTBEAT) this->processHeartbeat(message);
+    else if (message.msgid == MAVLINK_MSG_ID_TIMESYNC) this->processTimesync(message);
 }
 
 void CommandHandler::processCommandAck(const mavlink_message_t& message)
@@ -102,6 +140,10 @@ void CommandHandler::processCommandAck(const mavlink_message_t& message)
 
     int vehicleId = d->vehicleService->vehicleIdByMavId(message.sysid);
 
+    dto::Command::CommandType type = ::mavCommandLongMap.value(
+                                         ack.command, dto::Command::UnknownCommand);
+    if (type != dto::Command::UnknownCommand) this->sampleRoundTrip(vehicleId, type);
+
     switch (ack.command)
     {
     case MAV_CMD_DO_CHANGE_SPEED:
@@ -122,14 +164,13 @@ void CommandHandler::processCommandAck(const mavlink_message_t& message)
                          ::mavStatusMap.value(ack.result, dto::Command::Idle));
         break;
     case MAV_CMD_DO_SET_HOME:
+        this->sampleRoundTrip(vehicleId, dto::Command::SetReturn);
         this->ackCommand(vehicleId, dto::Command::SetReturn,
                          ::mavStatusMap.value(ack.result, dto::Command::Idle));
     default:
         break;
     }
 
-    dto::Command::CommandType type = ::mavCommandLongMap.value(
-                                         ack.command, dto::Command::UnknownCommand);
     if (type == dto::Command::UnknownCommand) return;
 
     this->ackCommand(vehicleId, type, ::mavStatusMap.value(ack.result, dto::Command::Idle));
@@ -161,6 +202,13 @@ void CommandHandler::processHeartbeat(const mavlink_message_t& message)
                                  heartbeat.custom_mode)));
     }
 
+    qint64 now = d->clock.elapsed();
+    if (!d->timesyncTimes.contains(message.sysid) ||
+        now - d->timesyncTimes[message.sysid] >= ::timesyncInterval)
+    {
+        this->sendTimesync(message.sysid);
+    }
+
     d->modes[message.sysid].baseMode = heartbeat.base_mode;
     d->modes[message.sysid].customMode = heartbeat.custom_mode;
 
@@ -172,6 +220,20 @@ void CommandHandler::processHeartbeat(const mavlink_message_t& message)
     }
 }
 
+void CommandHandler::processTimesync(const mavlink_message_t& message)
+{
+    mavlink_timesync_t timesync;
+    mavlink_msg_timesync_decode(&message, &timesync);
+
+    // Requests of the vehicle have no remote stamp, answers return our one
+    if (!timesync.tc1 || !d->timesyncs.contains(message.sysid) ||
+        d->timesyncs[message.sysid] != timesync.ts1) return;
+
+    d->timesyncs.remove(message.sysid);
+    this->addRoundTrip(d->vehicleService->vehicleIdByMavId(message.sysid),
+                       (d->clock.nsecsElapsed() - timesync.ts1) / 1000000);
+}
+
 void CommandHandler::sendCommand(int vehicleId, const dto::CommandPtr& command, int attempt)
 {
     qDebug() << "MAV:" << vehicleId << command->type() << command->arguments() << attempt;
@@ -227,6 +289,7 @@ void CommandHandler::sendCommand(int vehicleId, const dto::CommandPtr& command,
         this->sendManualControl(vehicle->mavId(), args.value(0, 0).toFloat(),
                                 args.value(1, 0).toFloat(), args.value(2, 0).toFloat(),
                                 args.value(3, 0).toFloat());
+        this->ackCommand(vehicleId, dto::Command::ManualImpacts, dto::Command::Completed);
         break;
     case dto::Command::CalibrateAirspeed:
         this->sendCommandLong(vehicle->mavId(), MAV_CMD_PREFLIGHT_CALIBRATION,
@@ -429,14 +492,97 @@ void CommandHandler::sendManualControl(quint8 mavId, float pitch, float roll,
                                            m_communicator->linkChannel(link),
                                            &message, &mavlink_manual_control);
     m_communicator->sendMessage(message, link);
+}
 
-    // TODO: wait ack
-    this->ackCommand(d->vehicleService->vehicleIdByMavId(mavId),
-                     dto::Command::ManualImpacts, dto::Command::Completed);
+void CommandHandler::sendRcOverride(quint8 mavId, float pitch, float roll,
+                                    float yaw, float thrust)
+{
+    mavlink_rc_channels_override_t rcOverride = {};
+
+    rcOverride.target_system = mavId;
+    rcOverride.target_component = 0;
+
+    // Channels 5-8 are ignored, extension channels are ignored with zero
+    rcOverride.chan5_raw = std::numeric_limits<quint16>::max();
+    rcOverride.chan6_raw = std::numeric_limits<quint16>::max();
+    rcOverride.chan7_raw = std::numeric_limits<quint16>::max();
+    rcOverride.chan8_raw = std::numeric_limits<quint16>::max();
+
+    // AETR order of ArduPilot RCMAP defaults
+    rcOverride.chan1_raw = ::toRcChannel(roll);
+    rcOverride.chan2_raw = ::toRcChannel(pitch);
+    rcOverride.chan3_raw = ::toRcChannel(thrust);
+    rcOverride.chan4_raw = ::toRcChannel(yaw);
+
+    AbstractLink* link = m_communicator->mavSystemLink(mavId);
+    if (!link) return;
+
+    mavlink_message_t message;
+    mavlink_msg_rc_channels_override_encode_chan(m_communicator->systemId(),
+                                                 m_communicator->componentId(),
+                                                 m_communicator->linkChannel(link),
+                                                 &message, &rcOverride);
+    m_communicator->sendMessage(message, link);
+}
+
+void CommandHandler::sendManualSample()
+{
+    // Sample, which comes earlier, waits in the channel and may be replaced by a newer one
+    qint64 wait = d->manualSent + ::manualInterval - d->clock.elapsed();
+    if (wait > 0)
+    {
+        if (!d->manualTimer->isActive()) d->manualTimer->start(int(wait));
+        return;
+    }
+
+    domain::ManualControlChannel::Sample sample;
+    if (!d->manualControl->take(&sample)) return;
+
+    dto::VehiclePtr vehicle = d->vehicleService->vehicle(sample.vehicleId);
+    if (vehicle.isNull()) return;
+
+    d->manualSent = d->clock.elapsed();
+
+    // Read per sample, so the switch applies without a restart
+    if (settings::Provider::boolValue(settings::manual::rcOverride))
+    {
+        this->sendRcOverride(vehicle->mavId(), sample.pitch, sample.roll,
+                             sample.yaw, sample.thrust);
+    }
+    else
+    {
+        this->sendManualControl(vehicle->mavId(), sample.pitch, sample.roll,
+                                sample.yaw, sample.thrust);
+    }
+
+    utils::LatencyMonitor::record(utils::LatencyMonitor::ManualControl, sample.origin);
+}
+
+void CommandHandler::sendTimesync(quint8 mavId)
+{
+    mavlink_timesync_t timesync;
+
+    timesync.tc1 = 0;
+    timesync.ts1 = d->clock.nsecsElapsed();
+
+    AbstractLink* link = m_communicator->mavSystemLink(mavId);
+    if (!link) return;
+
+    mavlink_message_t message;
+    mavlink_msg_timesync_encode_chan(m_communicator->systemId(),
+                                     m_communicator->componentId(),
+                                     m_communicator->linkChannel(link),
+                                     &message, &timesync);
+    m_communicator->sendMessage(message, link);
+
+    d->timesyncs[mavId] = timesync.ts1;
+    d->timesyncTimes[mavId] = d->clock.elapsed();
 }
 
 void CommandHandler::onVehicleRemoved(const dto::VehiclePtr& vehicle)
 {
     d->modeHelpers.remove(vehicle->mavId());
+    d->timesyncs.remove(vehicle->mavId());
+    d->timesyncTimes.remove(vehicle->mavId());
 }
 
@@ -24,6 +24,7 @@ namespace comm
     public slots:
         void processCommandAck(const mavlink_message_t& message);
         void processHeartbeat(const mavlink_message_t& message);
+        void processTimesync(const mavlink_message_t& message);
 
     protected:
         void sendCommand(int vehicleId, const dto::CommandPtr& command, int attempt = 0) override;
@@ -37,6 +38,9 @@ namespace comm
         void sendSetAltitude(quint8 mavId, float altitude);
         void sendSetLoiterRadius(quint8 mavId, float radius);
         void sendManualControl(quint8 mavId, float pitch, float roll, float yaw, float thrust);
+        void sendRcOverride(quint8 mavId, float pitch, float roll, float yaw, float thrust);
+        void sendManualSample(); // Latest one of the manual control channel
+        void sendTimesync(quint8 mavId);
 
         void onVehicleRemoved(const dto::VehiclePtr& vehicle);
 
@@ -16,14 +16,12 @@ using namespace comm;
 using namespace domain;
 
 AltitudeHandler::AltitudeHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_ALTITUDE }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void AltitudeHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_ALTITUDE) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_altitude_t altitude;
@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 AttitudeHandler::AttitudeHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_ATTITUDE }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void AttitudeHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_ATTITUDE) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_attitude_t attitude;
@@ -15,7 +15,7 @@
 using namespace comm;
 
 AttitudeTargetHandler::AttitudeTargetHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_ATTITUDE_TARGET }),
     m_vehicleService(serviceRegistry->vehicleService())
 {
 //    connect(d->vehicleService, &domain::VehicleService::sendManualControl,
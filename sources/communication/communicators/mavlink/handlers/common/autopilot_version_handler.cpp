@@ -28,7 +28,9 @@ public:
 
 AutopilotVersionHandler::AutopilotVersionHandler(MavLinkCommunicator* communicator):
     QObject(communicator),
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_COMMAND_ACK,
+                                           MAVLINK_MSG_ID_AUTOPILOT_VERSION,
+                                           MAVLINK_MSG_ID_HEARTBEAT }),
     d(new Impl())
 {}
 
@@ -17,15 +17,13 @@ using namespace comm;
 using namespace domain;
 
 FlightHandler::FlightHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_FLIGHT_INFORMATION }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void FlightHandler::processMessage(const mavlink_message_t& message)
 {
 #ifdef MAVLINK_V2
-    if (message.msgid != MAVLINK_MSG_ID_FLIGHT_INFORMATION) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_flight_information_t info;
@@ -21,7 +21,7 @@ using namespace comm;
 using namespace domain;
 
 GpsHandler::GpsHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_GPS_RAW_INT, MAVLINK_MSG_ID_GPS_STATUS }),
     m_telemetryService(serviceRegistry->telemetryService())
 {
     qRegisterMetaType<SatelliteInfo>("SatelliteInfo");
@@ -94,7 +94,7 @@ public:
 
 HeartbeatHandler::HeartbeatHandler(MavLinkCommunicator* communicator):
     QObject(communicator),
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_HEARTBEAT }),
     d(new Impl())
 {
     d->sendTimer = this->startTimer(settings::Provider::value(
@@ -108,8 +108,6 @@ HeartbeatHandler::~HeartbeatHandler()
 
 void HeartbeatHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_HEARTBEAT) return;
-
     mavlink_heartbeat_t heartbeat;
     mavlink_msg_heartbeat_decode(&message, &heartbeat);
 
@@ -18,14 +18,12 @@ using namespace comm;
 using namespace domain;
 
 HighLatencyHandler::HighLatencyHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_HIGH_LATENCY }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void HighLatencyHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_HIGH_LATENCY) return;
-
 // TODO: some anothr high latency data
 // uint32_t custom_mode; /*< A bitfield for use for autopilot-specific flags.*/
 // uint8_t landed_state; /*< The landed state. Is set to MAV_LANDED_STATE_UNDEFINED if landed state is unknown.*/
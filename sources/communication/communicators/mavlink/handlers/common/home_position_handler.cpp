@@ -41,7 +41,7 @@ public:
 
 HomePositionHandler::HomePositionHandler(MavLinkCommunicator* communicator):
     QObject(communicator),
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_HOME_POSITION }),
     d(new Impl())
 {
     connect(d->vehicleService, &VehicleService::vehicleAdded,
@@ -69,8 +69,6 @@ HomePositionHandler::~HomePositionHandler()
 
 void HomePositionHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_HOME_POSITION) return;
-
     TelemetryPortion port(serviceRegistry->telemetryService()->mavNode(message.sysid));
 
     mavlink_home_position_t home;
@@ -16,14 +16,12 @@ using namespace comm;
 using namespace domain;
 
 ImuHandler::ImuHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_SCALED_IMU }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void ImuHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_SCALED_IMU) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_scaled_imu_t imu;
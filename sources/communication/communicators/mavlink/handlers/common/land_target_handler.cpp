@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 LandTargetHandler::LandTargetHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_LANDING_TARGET }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void LandTargetHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_LANDING_TARGET) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_landing_target_t landing;
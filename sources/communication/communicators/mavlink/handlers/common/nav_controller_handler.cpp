@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 NavControllerHandler::NavControllerHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void NavControllerHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_nav_controller_output_t output;
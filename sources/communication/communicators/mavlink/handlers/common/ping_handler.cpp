@@ -9,13 +9,11 @@
 using namespace comm;
 
 PingHandler::PingHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator)
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_PING })
 {}
 
 void PingHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_PING) return;
-
     mavlink_ping_t ping;
     mavlink_msg_ping_decode(&message, &ping);
 
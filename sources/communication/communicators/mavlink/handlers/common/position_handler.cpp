@@ -19,14 +19,12 @@ using namespace comm;
 using namespace domain;
 
 PositionHandler::PositionHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_GLOBAL_POSITION_INT }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void PositionHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_GLOBAL_POSITION_INT) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_global_position_int_t position;
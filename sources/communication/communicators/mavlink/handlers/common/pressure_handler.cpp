@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 PressureHandler::PressureHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_SCALED_PRESSURE }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void PressureHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_SCALED_PRESSURE) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_scaled_pressure_t pressure;
@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 RadioStatusHandler::RadioStatusHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_RADIO_STATUS }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void RadioStatusHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_RADIO_STATUS) return;
-
     TelemetryPortion portion(m_telemetryService->radioNode());
 
     mavlink_radio_status_t radio;
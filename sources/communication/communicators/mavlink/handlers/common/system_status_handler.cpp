@@ -18,14 +18,12 @@ using namespace comm;
 using namespace domain;
 
 SystemStatusHandler::SystemStatusHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_SYS_STATUS }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void SystemStatusHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_SYS_STATUS) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_sys_status_t status;
@@ -18,14 +18,12 @@ using namespace comm;
 using namespace domain;
 
 SystemTimeHandler::SystemTimeHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_SYSTEM_TIME }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void SystemTimeHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_SYSTEM_TIME) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_system_time_t time;
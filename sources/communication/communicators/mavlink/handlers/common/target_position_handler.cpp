@@ -18,14 +18,12 @@ using namespace comm;
 using namespace domain;
 
 TargetPositionHandler::TargetPositionHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_POSITION_TARGET_GLOBAL_INT }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void TargetPositionHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_POSITION_TARGET_GLOBAL_INT) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_position_target_global_int_t position;
@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 VfrHudHandler::VfrHudHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_VFR_HUD }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void VfrHudHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_VFR_HUD) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_vfr_hud_t vfrHud;
@@ -17,14 +17,12 @@ using namespace comm;
 using namespace domain;
 
 VibrationHandler::VibrationHandler(MavLinkCommunicator* communicator):
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_VIBRATION }),
     m_telemetryService(serviceRegistry->telemetryService())
 {}
 
 void VibrationHandler::processMessage(const mavlink_message_t& message)
 {
-    if (message.msgid != MAVLINK_MSG_ID_VIBRATION) return;
-
     TelemetryPortion portion(m_telemetryService->mavNode(message.sysid));
 
     mavlink_vibration_t vibration;
@@ -6,9 +6,13 @@
 // Qt
 #include <QMap>
 #include <QTimerEvent>
+#include <QElapsedTimer>
 #include <QCoreApplication>
 #include <QDebug>
 
+// Std
+#include <limits>
+
 // Internal
 #include "mission.h"
 #include "mission_item.h"
@@ -16,6 +20,8 @@
 #include "mission_assignment.h"
 
 #include "mavlink_communicator.h"
+#include "mavlink_protocol_helpers.h"
+#include "mission_transfer.h"
 
 #include "service_registry.h"
 #include "command_service.h"
@@ -29,7 +35,8 @@
 
 namespace
 {
-    const int interval = 2000;
+    const int pipelinedWindow = 8; // ArduPilot answers every item request
+    const int progressInterval = 100; // ms, progress is reported in batches
 
     const QMap<quint16, dto::MissionItem::Command> mavCommandLongMap =
     {
@@ -57,6 +64,96 @@ namespace
         { MAV_CMD_DO_DIGICAM_CONTROL, dto::MissionItem::CameraControl }
     };
 
+    bool isGlobalFrame(quint8 frame)
+    {
+        return frame == MAV_FRAME_GLOBAL || frame == MAV_FRAME_GLOBAL_INT ||
+                frame == MAV_FRAME_GLOBAL_RELATIVE_ALT ||
+                frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT ||
+                frame == MAV_FRAME_GLOBAL_TERRAIN_ALT ||
+                frame == MAV_FRAME_GLOBAL_TERRAIN_ALT_INT;
+    }
+
+    // Items are handled in the integer form, float one is left for autopilots without
+    // MISSION_ITEM_INT, it loses centimetres of coordinates
+    mavlink_mission_item_int_t toIntItem(const mavlink_mission_item_t& item)
+    {
+        mavlink_mission_item_int_t intItem = {};
+        double scale = ::isGlobalFrame(item.frame) ? 1e7 : 1;
+
+        intItem.param1 = item.param1;
+        intItem.param2 = item.param2;
+        intItem.param3 = item.param3;
+        intItem.param4 = item.param4;
+        intItem.x = qRound(qBound(double(std::numeric_limits<qint32>::min()), item.x * scale,
+                                  double(std::numeric_limits<qint32>::max())));
+        intItem.y = qRound(qBound(double(std::numeric_limits<qint32>::min()), item.y * scale,
+                                  double(std::numeric_limits<qint32>::max())));
+        intItem.z = item.z;
+        intItem.seq = item.seq;
+        intItem.command = item.command;
+        intItem.target_system = item.target_system;
+        intItem.target_component = item.target_component;
+        intItem.frame = item.frame;
+        intItem.current = item.current;
+        intItem.autocontinue = item.autocontinue;
+#ifdef MAVLINK_V2
+        intItem.mission_type = item.mission_type;
+#endif
+        return intItem;
+    }
+
+    mavlink_mission_item_t toFloatItem(const mavlink_mission_item_int_t& item)
+    {
+        mavlink_mission_item_t floatItem = {};
+        double scale = ::isGlobalFrame(item.frame) ? 1e7 : 1;
+
+        floatItem.param1 = item.param1;
+        floatItem.param2 = item.param2;
+        floatItem.param3 = item.param3;
+        floatItem.param4 = item.param4;
+        floatItem.x = static_cast<float>(item.x / scale);
+        floatItem.y = static_cast<float>(item.y / scale);
+        floatItem.z = item.z;
+        floatItem.seq = item.seq;
+        floatItem.command = item.command;
+        floatItem.target_system = item.target_system;
+        floatItem.target_component = item.target_component;
+        floatItem.frame = item.frame;
+        floatItem.current = item.current;
+        floatItem.autocontinue = item.autocontinue;
+#ifdef MAVLINK_V2
+        floatItem.mission_type = item.mission_type;
+#endif
+        return floatItem;
+    }
+
+    // Mission type of the transfer message, -1 for other messages and for MAVLink 1
+    int missionType(const mavlink_message_t& message)
+    {
+#ifdef MAVLINK_V2
+        switch (message.msgid)
+        {
+        case MAVLINK_MSG_ID_MISSION_COUNT:
+            return mavlink_msg_mission_count_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_ITEM:
+            return mavlink_msg_mission_item_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+            return mavlink_msg_mission_item_int_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_REQUEST:
+            return mavlink_msg_mission_request_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+            return mavlink_msg_mission_request_int_get_mission_type(&message);
+        case MAVLINK_MSG_ID_MISSION_ACK:
+            return mavlink_msg_mission_ack_get_mission_type(&message);
+        default:
+            break;
+        }
+#else
+        Q_UNUSED(message)
+#endif
+        return -1;
+    }
+
     QString decodeCommandResult(int result)
     {
         switch (result) {
@@ -99,13 +196,105 @@ public:
 
     QMap <quint8, MissionHandler::Stage> mavStages;
     QMap <quint8, int> mavTimers;
-    QMap <quint8, QList<int> > mavSequencer;
-    int lastSendedSequence = -1;
+    QMap <quint8, MissionTransfer> mavTransfers; // kept with round trip between transfers
+    QMap <quint8, int> mavWindows; // by autopilot, until it rejects pipelined requests
+    QMap <quint8, bool> mavIntItems; // MISSION_ITEM_INT is tried until vehicle rejects it
+    QMap <quint8, bool> mavPartialWrites; // MISSION_WRITE_PARTIAL_LIST, until vehicle rejects it
+    QMap <quint8, QPair<int, int> > mavRanges; // Sequences of the partial upload
+    QMap <quint8, QVector<uint> > mavSentHashes; // Onboard items after the upload is accepted
+    QMap <quint8, QMap<int, dto::MissionItemPtr> > mavDownloaded; // By sequence, saved after download
+
+    dto::MissionAssignmentPtrList changedAssignments;
+    int progressTimer = 0;
+    QElapsedTimer clock;
+
+    Impl()
+    {
+        clock.start();
+    }
+
+    MissionTransfer& transfer(quint8 mavId)
+    {
+        if (!mavTransfers.contains(mavId))
+        {
+            mavTransfers[mavId].setMaxWindow(mavWindows.value(mavId, 1));
+        }
+        return mavTransfers[mavId];
+    }
+
+    void sendItem(MavLinkCommunicator* communicator, quint8 mavId,
+                  mavlink_mission_item_int_t& item)
+    {
+        AbstractLink* link = communicator->mavSystemLink(mavId);
+        if (!link) return;
+
+        item.target_system = mavId;
+        item.target_component = MAV_COMP_ID_MISSIONPLANNER;
+#ifdef MAVLINK_V2
+        item.mission_type = MAV_MISSION_TYPE_MISSION;
+#endif
+
+        mavlink_message_t message;
+        if (mavIntItems.value(mavId, true))
+        {
+            mavlink_msg_mission_item_int_encode_chan(communicator->systemId(),
+                                                     communicator->componentId(),
+                                                     communicator->linkChannel(link),
+                                                     &message, &item);
+        }
+        else
+        {
+            mavlink_mission_item_t floatItem = ::toFloatItem(item);
+            mavlink_msg_mission_item_encode_chan(communicator->systemId(),
+                                                 communicator->componentId(),
+                                                 communicator->linkChannel(link),
+                                                 &message, &floatItem);
+        }
+        communicator->sendMessage(message, link);
+    }
+
+    // Sequences of the items, which differ from the ones acknowledged by vehicle. Range is
+    // empty if nothing differs and full if onboard items are unknown or their count differs.
+    QPair<int, int> changedRange(int vehicleId, const dto::MissionItemPtrList& items) const
+    {
+        QVector<uint> hashes = missionService->vehicleItemHashes(vehicleId);
+        if (hashes.isEmpty() || hashes.count() != items.count())
+        {
+            return qMakePair(0, items.count() - 1);
+        }
+
+        int first = 0;
+        while (first < items.count() &&
+               hashes.at(first) == MissionService::itemHash(items.at(first))) first++;
+
+        int last = items.count() - 1;
+        while (last >= first &&
+               hashes.at(last) == MissionService::itemHash(items.at(last))) last--;
+
+        return qMakePair(first, last);
+    }
+
+    dto::MissionItemPtr downloadedItem(quint8 mavId, int sequence) const
+    {
+        auto it = mavDownloaded.constFind(mavId);
+        if (it == mavDownloaded.constEnd()) return dto::MissionItemPtr();
+
+        return it->value(sequence);
+    }
 };
 
 MissionHandler::MissionHandler(MavLinkCommunicator* communicator):
     QObject(communicator),
-    AbstractMavLinkHandler(communicator),
+    AbstractMavLinkHandler(communicator, { MAVLINK_MSG_ID_HEARTBEAT,
+                                           MAVLINK_MSG_ID_AUTOPILOT_VERSION,
+                                           MAVLINK_MSG_ID_MISSION_COUNT,
+                                           MAVLINK_MSG_ID_MISSION_ITEM,
+                                           MAVLINK_MSG_ID_MISSION_ITEM_INT,
+                                           MAVLINK_MSG_ID_MISSION_REQUEST,
+                                           MAVLINK_MSG_ID_MISSION_REQUEST_INT,
+                                           MAVLINK_MSG_ID_MISSION_ACK,
+                                           MAVLINK_MSG_ID_MISSION_CURRENT,
+                                           MAVLINK_MSG_ID_MISSION_ITEM_REACHED }),
     d(new Impl())
 {
     connect(d->missionService, &MissionService::download, this, &MissionHandler::download);
@@ -118,15 +307,27 @@ MissionHandler::~MissionHandler()
 
 void MissionHandler::processMessage(const mavlink_message_t& message)
 {
+    // Fence and rally transfers of the other ground stations are not handled
+    int missionType = ::missionType(message);
+    if (missionType > -1 && missionType != MAV_MISSION_TYPE_MISSION) return;
+
     switch (message.msgid)
     {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+        this->processHeartbeat(message);
+        break;
+    case MAVLINK_MSG_ID_AUTOPILOT_VERSION:
+        this->processAutopilotVersion(message);
+        break;
     case MAVLINK_MSG_ID_MISSION_COUNT:
         this->processMissionCount(message);
         break;
     case MAVLINK_MSG_ID_MISSION_ITEM:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
         this->processMissionItem(message);
         break;
     case MAVLINK_MSG_ID_MISSION_REQUEST:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
         this->processMissionRequest(message);
         break;
     case MAVLINK_MSG_ID_MISSION_ACK:
@@ -152,8 +353,10 @@ void MissionHandler::download(const dto::MissionAssignmentPtr& assignment)
     assignment->setProgress(0);
     d->missionService->assignmentChanged(assignment);
 
-    this->enterStage(Stage::WaitingCount, vehicle->mavId());
+    d->transfer(vehicle->mavId()).stop();
+
     this->requestMissionCount(vehicle->mavId());
+    this->enterStage(Stage::WaitingCount, vehicle->mavId());
 }
 
 void MissionHandler::upload(const dto::MissionAssignmentPtr& assignment)
@@ -161,32 +364,64 @@ void MissionHandler::upload(const dto::MissionAssignmentPtr& assignment)
     dto::VehiclePtr vehicle = d->vehicleService->vehicle(assignment->vehicleId());
     if (vehicle.isNull()) return;
 
-    d->mavSequencer[vehicle->mavId()].clear();
-    for (const dto::MissionItemPtr& item: d->missionService->missionItems(assignment->missionId()))
+    dto::MissionItemPtrList items = d->missionService->missionItems(assignment->missionId());
+    QPair<int, int> range = d->changedRange(vehicle->id(), items);
+
+    // Items, which are onboard already, are not sent again
+    for (const dto::MissionItemPtr& item: items)
     {
-        d->mavSequencer[vehicle->mavId()].append(item->sequence());
-        item->setStatus(dto::MissionItem::NotActual);
+        item->setStatus(item->sequence() < range.first || item->sequence() > range.second ?
+                            dto::MissionItem::Actual : dto::MissionItem::NotActual);
         d->missionService->missionItemChanged(item);
     }
 
-    if (d->mavSequencer.isEmpty())
+    if (items.isEmpty() || range.first > range.second)
     {
         this->enterStage(Stage::Idle, vehicle->mavId());
+
+        if (items.count())
+        {
+            assignment->setStatus(dto::MissionAssignment::Actual);
+            assignment->setProgress(items.count());
+            d->missionService->assignmentChanged(assignment);
+        }
+        return;
+    }
+
+    assignment->setStatus(dto::MissionAssignment::Uploading);
+    assignment->setProgress(0);
+
+    quint8 mavId = vehicle->mavId();
+    bool partial = d->mavPartialWrites.value(mavId, false) &&
+                   (range.first > 0 || range.second < items.count() - 1);
+
+    d->mavSentHashes[mavId] = partial ? d->missionService->vehicleItemHashes(vehicle->id()) :
+                                        QVector<uint>(items.count());
+
+    if (partial)
+    {
+        d->mavRanges[mavId] = range;
+        d->transfer(mavId).start(items.count(), range.first, range.second);
+        assignment->setProgress(d->transfer(mavId).doneCount());
+        d->missionService->assignmentChanged(assignment);
+
+        this->sendMissionWritePartial(mavId);
     }
     else
     {
-        assignment->setStatus(dto::MissionAssignment::Uploading);
-        assignment->setProgress(0);
+        d->mavRanges.remove(mavId);
+        d->transfer(mavId).start(items.count());
         d->missionService->assignmentChanged(assignment);
 
-        d->lastSendedSequence = -1;
-        this->enterStage(Stage::SendingCount, vehicle->mavId());
-        this->sendMissionCount(vehicle->mavId());
+        this->sendMissionCount(mavId);
     }
+    this->enterStage(Stage::SendingCount, mavId);
 }
 
 void MissionHandler::cancelSync(const dto::MissionAssignmentPtr& assignment)
 {
+    // Upload may be broken in the middle, onboard items are unknown
+    d->missionService->resetVehicleItems(assignment->vehicleId());
     this->enterStage(Stage::Idle, d->vehicleService->mavIdByVehicleId(assignment->vehicleId()));
 
     assignment->setStatus(dto::MissionAssignment::NotActual);
@@ -194,6 +429,12 @@ void MissionHandler::cancelSync(const dto::MissionAssignmentPtr& assignment)
     d->missionService->assignmentChanged(assignment);
 }
 
+void MissionHandler::setTransferWindow(quint8 mavId, int window)
+{
+    d->mavWindows[mavId] = window;
+    d->transfer(mavId).setMaxWindow(window);
+}
+
 void MissionHandler::requestMissionCount(quint8 mavId)
 {
     mavlink_message_t message;
@@ -201,6 +442,9 @@ void MissionHandler::requestMissionCount(quint8 mavId)
 
     request.target_system = mavId;
     request.target_component = MAV_COMP_ID_MISSIONPLANNER;
+#ifdef MAVLINK_V2
+    request.mission_type = MAV_MISSION_TYPE_MISSION;
+#endif
 
     AbstractLink* link = m_communicator->mavSystemLink(mavId);
     if (!link) return;
@@ -214,24 +458,48 @@ void MissionHandler::requestMissionCount(quint8 mavId)
 
 void MissionHandler::requestMissionItem(quint8 mavId, quint16 seq)
 {
-    dto::MissionAssignmentPtr assignment = d->missionService->vehicleAssignment(
-                                               d->vehicleService->vehicleIdByMavId(mavId));
-    if (assignment.isNull()) return;
+    if (d->missionService->vehicleAssignment(d->vehicleService->vehicleIdByMavId(mavId)).isNull())
+    {
+        return;
+    }
+
+    AbstractLink* link = m_communicator->mavSystemLink(mavId);
+    if (!link) return;
 
     mavlink_message_t message;
-    mavlink_mission_request_t missionRequest;
 
-    missionRequest.target_system = mavId;
-    missionRequest.target_component = MAV_COMP_ID_MISSIONPLANNER;
-    missionRequest.seq = seq;
+    if (d->mavIntItems.value(mavId, true))
+    {
+        mavlink_mission_request_int_t missionRequest = {};
 
-    AbstractLink* link = m_communicator->mavSystemLink(mavId);
-    if (!link) return;
+        missionRequest.target_system = mavId;
+        missionRequest.target_component = MAV_COMP_ID_MISSIONPLANNER;
+        missionRequest.seq = seq;
+#ifdef MAVLINK_V2
+        missionRequest.mission_type = MAV_MISSION_TYPE_MISSION;
+#endif
+
+        mavlink_msg_mission_request_int_encode_chan(m_communicator->systemId(),
+                                                    m_communicator->componentId(),
+                                                    m_communicator->linkChannel(link),
+                                                    &message, &missionRequest);
+    }
+    else
+    {
+        mavlink_mission_request_t missionRequest = {};
 
-    mavlink_msg_mission_request_encode_chan(m_communicator->systemId(),
-                                            m_communicator->componentId(),
-                                            m_communicator->linkChannel(link),
-                                            &message, &missionRequest);
+        missionRequest.target_system = mavId;
+        missionRequest.target_component = MAV_COMP_ID_MISSIONPLANNER;
+        missionRequest.seq = seq;
+#ifdef MAVLINK_V2
+        missionRequest.mission_type = MAV_MISSION_TYPE_MISSION;
+#endif
+
+        mavlink_msg_mission_request_encode_chan(m_communicator->systemId(),
+                                                m_communicator->componentId(),
+                                                m_communicator->linkChannel(link),
+                                                &message, &missionRequest);
+    }
     m_communicator->sendMessage(message, link);
 }
 
@@ -241,14 +509,15 @@ void MissionHandler::sendMissionCount(quint8 mavId)
                                                d->vehicleService->vehicleIdByMavId(mavId));
     if (assignment.isNull()) return;
 
-    dto::MissionPtr mission = d->missionService->mission(assignment->missionId());
-
     mavlink_message_t message;
     mavlink_mission_count_t countMessage;
 
     countMessage.target_system = mavId;
     countMessage.target_component = MAV_COMP_ID_MISSIONPLANNER;
-    countMessage.count = mission->count();
+    countMessage.count = d->missionService->mission(assignment->missionId())->count();
+#ifdef MAVLINK_V2
+    countMessage.mission_type = MAV_MISSION_TYPE_MISSION;
+#endif
 
     AbstractLink* link = m_communicator->mavSystemLink(mavId);
     if (!link) return;
@@ -260,17 +529,41 @@ void MissionHandler::sendMissionCount(quint8 mavId)
     m_communicator->sendMessage(message, link);
 }
 
+void MissionHandler::sendMissionWritePartial(quint8 mavId)
+{
+    if (!d->mavRanges.contains(mavId)) return;
+
+    QPair<int, int> range = d->mavRanges.value(mavId);
+
+    mavlink_message_t message;
+    mavlink_mission_write_partial_list_t partial;
+
+    partial.target_system = mavId;
+    partial.target_component = MAV_COMP_ID_MISSIONPLANNER;
+    partial.start_index = range.first;
+    partial.end_index = range.second;
+#ifdef MAVLINK_V2
+    partial.mission_type = MAV_MISSION_TYPE_MISSION;
+#endif
+
+    AbstractLink* link = m_communicator->mavSystemLink(mavId);
+    if (!link) return;
+
+    mavlink_msg_mission_write_partial_list_encode_chan(m_communicator->systemId(),
+                                                       m_communicator->componentId(),
+                                                       m_communicator->linkChannel(link),
+                                                       &message, &partial);
+    m_communicator->sendMessage(message, link);
+}
+
 void MissionHandler::sendMissionItem(quint8 mavId, quint16 seq)
 {
     int vehicleId = d->vehicleService->vehicleIdByMavId(mavId);
     dto::MissionAssignmentPtr assignment = d->missionService->vehicleAssignment(vehicleId);
     if (assignment.isNull()) return;
 
-    mavlink_message_t message;
-    mavlink_mission_item_t msgItem;
-
-    msgItem.target_system = mavId;
-    msgItem.target_component = MAV_COMP_ID_MISSIONPLANNER;
+    mavlink_mission_item_int_t msgItem = {};
+    msgItem.frame = MAV_FRAME_MISSION;
 
     // TODO: mission item to message convertor class
     dto::MissionItemPtr item = d->missionService->missionItem(assignment->missionId(), seq);
@@ -291,8 +584,8 @@ void MissionHandler::sendMissionItem(quint8 mavId, quint16 seq)
 
     if (item->isPositionatedItem())
     {
-        msgItem.x = static_cast<float>(item->latitude());
-        msgItem.y = static_cast<float>(item->longitude());
+        msgItem.x = encodeLatLon(item->latitude());
+        msgItem.y = encodeLatLon(item->longitude());
     }
 
     msgItem.param1 = 0;
@@ -351,28 +644,19 @@ void MissionHandler::sendMissionItem(quint8 mavId, quint16 seq)
 //        altitude must be to target altitude for command completion.
 //    }
 
-    AbstractLink* link = m_communicator->mavSystemLink(mavId);
-    if (!link) return;
-
-    mavlink_msg_mission_item_encode_chan(m_communicator->systemId(),
-                                         m_communicator->componentId(),
-                                         m_communicator->linkChannel(link),
-                                         &message, &msgItem);
-    m_communicator->sendMessage(message, link);
+    if (!m_communicator->mavSystemLink(mavId)) return;
 
-    item->setStatus(dto::MissionItem::Actual);
-    d->lastSendedSequence = seq;
-    d->missionService->missionItemChanged(item);
+    d->sendItem(m_communicator, mavId, msgItem);
 
-    if (d->mavStages[mavId] == Stage::SendingItem)
+    // Taken as onboard state, when the upload is accepted
+    auto hashes = d->mavSentHashes.find(mavId);
+    if (hashes != d->mavSentHashes.end() && seq < hashes->count())
     {
-        d->mavSequencer[mavId].removeOne(seq);
-        assignment->addProgress();
-
-        if (d->mavSequencer[mavId].isEmpty()) this->enterStage(Stage::WaitongAck, mavId);
-
-        d->missionService->assignmentChanged(assignment);
+        (*hashes)[seq] = MissionService::itemHash(item);
     }
+
+    item->setStatus(dto::MissionItem::Actual);
+    d->missionService->missionItemChanged(item);
 }
 
 void MissionHandler::sendMissionAck(quint8 mavId)
@@ -403,45 +687,69 @@ void MissionHandler::processMissionCount(const mavlink_message_t& message)
     // Ignore mission_count, if we are not downloading mission
     if (d->mavStages.value(message.sysid, Stage::Idle) != Stage::WaitingCount) return;
 
+    mavlink_mission_count_t missionCount;
+    mavlink_msg_mission_count_decode(&message, &missionCount);
+
     int vehicleId = d->vehicleService->vehicleIdByMavId(message.sysid);
     dto::MissionAssignmentPtr assignment = d->missionService->vehicleAssignment(vehicleId);
     if (assignment.isNull()) return;
 
-    mavlink_mission_count_t missionCount;
-    mavlink_msg_mission_count_decode(&message, &missionCount);
-
     // Remove superfluous items
-    for (const dto::MissionItemPtr& item:
-         d->missionService->missionItems(assignment->missionId()))
+    dto::MissionItemPtrList superfluous;
+    for (const dto::MissionItemPtr& item: d->missionService->missionItems(assignment->missionId()))
     {
-        if (item->sequence() > missionCount.count - 1) d->missionService->remove(item);
+        if (item->sequence() > missionCount.count - 1) superfluous.append(item);
     }
+    d->missionService->remove(superfluous);
 
-    // TODO: append fake items
-    d->mavSequencer[message.sysid].clear();
-    for (int seq = 0; seq < missionCount.count; ++seq)
+    if (!missionCount.count)
     {
-        d->mavSequencer[message.sysid].append(seq);
+        this->sendMissionAck(message.sysid);
+        this->enterStage(Stage::Idle, message.sysid);
+
+        assignment->setStatus(dto::MissionAssignment::Actual);
+        d->missionService->assignmentChanged(assignment);
+        return;
     }
 
+    // TODO: append fake items
+    MissionTransfer& transfer = d->transfer(message.sysid);
+    transfer.start(missionCount.count);
+
+    for (int seq: transfer.takeRequests(d->clock.elapsed()))
+    {
+        this->requestMissionItem(message.sysid, seq);
+    }
     this->enterStage(Stage::WaitingItem, message.sysid);
-    this->requestMissionItem(message.sysid, 0);
 }
 
 void MissionHandler::processMissionItem(const mavlink_message_t& message)
 {
+    mavlink_mission_item_int_t msgItem;
+    if (message.msgid == MAVLINK_MSG_ID_MISSION_ITEM_INT)
+    {
+        mavlink_msg_mission_item_int_decode(&message, &msgItem);
+        d->mavIntItems[message.sysid] = true;
+    }
+    else
+    {
+        mavlink_mission_item_t floatItem;
+        mavlink_msg_mission_item_decode(&message, &floatItem);
+        msgItem = ::toIntItem(floatItem);
+    }
+
     int vehicleId = d->vehicleService->vehicleIdByMavId(message.sysid);
     dto::MissionAssignmentPtr assignment = d->missionService->vehicleAssignment(vehicleId);
     if (assignment.isNull()) return;
 
-    mavlink_mission_item_t msgItem;
-    mavlink_msg_mission_item_decode(&message, &msgItem);
-
     // Don't allow mav to change items while not in downloading stage(except home)
     if (d->mavStages.value(message.sysid, Stage::Idle) != Stage::WaitingItem &&
         msgItem.seq != 0) return;
 
+    bool downloading = d->mavStages.value(message.sysid, Stage::Idle) == Stage::WaitingItem;
+
     dto::MissionItemPtr item = d->missionService->missionItem(assignment->missionId(), msgItem.seq);
+    if (item.isNull() && downloading) item = d->downloadedItem(message.sysid, msgItem.seq);
     if (item.isNull())
     {
         item = dto::MissionItemPtr::create();
@@ -455,14 +763,15 @@ void MissionHandler::processMissionItem(const mavlink_message_t& message)
 
     if (item->isAltitudedItem())
     {
-        item->setAltitudeRelative(msgItem.frame == MAV_FRAME_GLOBAL_RELATIVE_ALT);
+        item->setAltitudeRelative(msgItem.frame == MAV_FRAME_GLOBAL_RELATIVE_ALT ||
+                                  msgItem.frame == MAV_FRAME_GLOBAL_RELATIVE_ALT_INT);
         item->setAltitude(msgItem.z);
     }
 
     if (item->isPositionatedItem())
     {
-        item->setLatitude(static_cast<double>(msgItem.x));
-        item->setLongitude(static_cast<double>(msgItem.y));
+        item->setLatitude(decodeLatLon(msgItem.x));
+        item->setLongitude(decodeLatLon(msgItem.y));
     }
 
     if (msgItem.command == MAV_CMD_NAV_TAKEOFF)
@@ -515,60 +824,82 @@ void MissionHandler::processMissionItem(const mavlink_message_t& message)
 //    }
 
     item->setStatus(dto::MissionItem::Actual);
-    d->missionService->save(item);
 
-    if (d->mavSequencer[message.sysid].contains(msgItem.seq) &&
-        d->mavStages.value(message.sysid, Stage::Idle) == Stage::WaitingItem)
+    if (!downloading) d->missionService->save(item);
+    else d->mavDownloaded[message.sysid].insert(msgItem.seq, item);
+
+    if (!downloading) return;
+
+    // Duplicates of the retransmitted requests are not counted
+    MissionTransfer& transfer = d->transfer(message.sysid);
+    qint64 now = d->clock.elapsed();
+    if (transfer.markDone(msgItem.seq, now))
     {
-        d->mavSequencer[message.sysid].removeOne(msgItem.seq);
-        assignment->addProgress();
+        assignment->setProgress(transfer.doneCount());
 
-        if (d->mavSequencer[message.sysid].isEmpty())
+        if (transfer.isComplete())
         {
             assignment->setStatus(dto::MissionAssignment::Actual);
 
             this->sendMissionAck(message.sysid);
             this->enterStage(Stage::Idle, message.sysid);
-        }
-        else
-        {
-            this->enterStage(Stage::WaitingItem, message.sysid);
-            this->requestMissionItem(message.sysid, d->mavSequencer[message.sysid].first());
+
+            d->missionService->setVehicleItems(
+                        vehicleId, d->missionService->missionItems(assignment->missionId()));
+            d->missionService->assignmentChanged(assignment);
+            return;
         }
 
-        d->missionService->assignmentChanged(assignment);
+        this->reportProgress(assignment);
     }
+
+    for (int seq: transfer.takeRequests(now)) this->requestMissionItem(message.sysid, seq);
+    this->schedule(message.sysid);
 }
 
 void MissionHandler::processMissionRequest(const mavlink_message_t& message)
 {
+    // Vehicle requests items in the form it handles
     mavlink_mission_request_t request;
-    mavlink_msg_mission_request_decode(&message, &request);
-
-    if (d->mavStages.value(message.sysid, Stage::Idle) == Stage::SendingCount)
+    if (message.msgid == MAVLINK_MSG_ID_MISSION_REQUEST_INT)
     {
-        this->enterStage(Stage::SendingItem, message.sysid);
+        request.seq = mavlink_msg_mission_request_int_get_seq(&message);
+        d->mavIntItems[message.sysid] = true;
+    }
+    else
+    {
+        mavlink_msg_mission_request_decode(&message, &request);
+        d->mavIntItems[message.sysid] = false;
     }
 
-    if (d->lastSendedSequence != -1 && d->lastSendedSequence != request.seq)
+    Stage stage = d->mavStages.value(message.sysid, Stage::Idle);
+    if (stage != Stage::SendingCount && stage != Stage::SendingItem && stage != Stage::WaitongAck)
     {
-        d->mavSequencer[message.sysid].removeOne(d->lastSendedSequence);
+        this->sendMissionItem(message.sysid, request.seq);
+        return;
+    }
 
+    // Request of the other item means the last sent one was received
+    MissionTransfer& transfer = d->transfer(message.sysid);
+    qint64 now = d->clock.elapsed();
+    int lastSent = transfer.lastSent();
+
+    if (lastSent != -1 && lastSent != request.seq && transfer.markDone(lastSent, now))
+    {
         int vehicleId = d->vehicleService->vehicleIdByMavId(message.sysid);
         dto::MissionAssignmentPtr assignment = d->missionService->vehicleAssignment(vehicleId);
         if (assignment)
         {
-            dto::MissionItemPtr item = d->missionService->missionItem(assignment->missionId(),
-                                                                      d->lastSendedSequence);
-            if (item)
-            {
-                item->setStatus(dto::MissionItem::Actual);
-                d->missionService->missionItemChanged(item);
-            }
+            assignment->setProgress(transfer.doneCount());
+            this->reportProgress(assignment);
         }
     }
 
     this->sendMissionItem(message.sysid, request.seq);
+    transfer.markSent(request.seq, now);
+
+    int last = d->mavRanges.value(message.sysid, qMakePair(0, transfer.count() - 1)).second;
+    this->enterStage(request.seq < last ? Stage::SendingItem : Stage::WaitongAck, message.sysid);
 }
 
 void MissionHandler::processMissionAck(const mavlink_message_t& message)
@@ -580,23 +911,55 @@ void MissionHandler::processMissionAck(const mavlink_message_t& message)
     mavlink_mission_ack_t ack;
     mavlink_msg_mission_ack_decode(&message, &ack);
 
-#ifdef MAVLINK_V2
-    if (ack.mission_type != MAV_MISSION_TYPE_MISSION) return;
-#endif
+    Stage stage = d->mavStages.value(message.sysid, Stage::Idle);
+    MissionTransfer& transfer = d->transfer(message.sysid);
 
     if (ack.type == MAV_MISSION_ACCEPTED)
     {
-        if (d->mavStages.value(message.sysid, Stage::Idle) == Stage::WaitongAck)
+        // Empty mission is accepted right after the count
+        if (stage == Stage::WaitongAck || (stage == Stage::SendingCount && !transfer.count()))
         {
+            transfer.markDone(transfer.lastSent(), d->clock.elapsed());
+            assignment->setProgress(transfer.doneCount());
             assignment->setStatus(dto::MissionAssignment::Actual);
+            d->missionService->setVehicleItemHashes(vehicleId,
+                                                    d->mavSentHashes.value(message.sysid));
+
+            this->enterStage(Stage::Idle, message.sysid);
         }
     }
+    else if (stage == Stage::SendingCount && d->mavRanges.contains(message.sysid))
+    {
+        // Partial write is rejected, whole mission is sent instead
+        d->mavPartialWrites[message.sysid] = false;
+        this->enterStage(Stage::Idle, message.sysid);
+        this->upload(assignment);
+        return;
+    }
+    else if (stage == Stage::WaitingItem && ack.type == MAV_MISSION_INVALID_SEQUENCE &&
+             transfer.maxWindow() > 1)
+    {
+        // Autopilot answers only the expected request, the rest are requested again one by one
+        this->setTransferWindow(message.sysid, 1);
+        return;
+    }
+    else if (stage == Stage::WaitingItem && ack.type == MAV_MISSION_UNSUPPORTED &&
+             (d->mavIntItems.value(message.sysid, true) || !transfer.doneCount()))
+    {
+        // Autopilot has no MISSION_REQUEST_INT, expired requests go with MISSION_REQUEST.
+        // The rest of the window is rejected after the switch too, until an item comes.
+        d->mavIntItems[message.sysid] = false;
+        return;
+    }
     else
     {
         notificationBus->notify(tr("Mission"), tr("Error uploading waypoint %1").arg(
                                  ::decodeCommandResult(ack.type)),
                              dto::Notification::Warning);
         assignment->setStatus(dto::MissionAssignment::NotActual);
+        d->missionService->resetVehicleItems(vehicleId);
+
+        if (stage != Stage::Idle) this->enterStage(Stage::Idle, message.sysid);
     }
 
     d->missionService->assignmentChanged(assignment);
@@ -632,43 +995,140 @@ void MissionHandler::processMissionReached(const mavlink_message_t& message)
     }
 }
 
+void MissionHandler::processHeartbeat(const mavlink_message_t& message)
+{
+    if (d->mavPartialWrites.contains(message.sysid)) return;
+
+    bool ardupilot = mavlink_msg_heartbeat_get_autopilot(&message) == MAV_AUTOPILOT_ARDUPILOTMEGA;
+    d->mavPartialWrites[message.sysid] = ardupilot;
+
+    if (d->mavWindows.contains(message.sysid)) return;
+
+    this->setTransferWindow(message.sysid, ardupilot ? ::pipelinedWindow : 1);
+}
+
+void MissionHandler::processAutopilotVersion(const mavlink_message_t& message)
+{
+    mavlink_autopilot_version_t version;
+    mavlink_msg_autopilot_version_decode(&message, &version);
+
+    d->mavIntItems[message.sysid] =
+            bool(version.capabilities & MAV_PROTOCOL_CAPABILITY_MISSION_INT);
+}
+
 void MissionHandler::enterStage(Stage stage, quint8 mavId)
+{
+    // Download is over or cancelled, store received items in one transaction
+    if (stage != Stage::WaitingItem && d->mavDownloaded.contains(mavId))
+    {
+        d->missionService->save(d->mavDownloaded.take(mavId).values());
+    }
+
+    if (stage == Stage::Idle)
+    {
+        d->transfer(mavId).stop();
+        d->mavRanges.remove(mavId);
+        d->mavSentHashes.remove(mavId);
+    }
+
+    d->mavStages[mavId] = stage;
+    this->schedule(mavId);
+}
+
+void MissionHandler::schedule(quint8 mavId)
 {
     if (d->mavTimers.contains(mavId))
     {
         this->killTimer(d->mavTimers.take(mavId));
     }
 
-    d->mavStages[mavId] = stage;
-    if (stage != Stage::Idle &&
-        stage != Stage::SendingItem &&
-        stage != Stage::WaitongAck)
+    const MissionTransfer& transfer = d->transfer(mavId);
+    int timeout = -1;
+
+    switch (d->mavStages.value(mavId, Stage::Idle))
     {
-        d->mavTimers[mavId] = this->startTimer(::interval);
+    case Stage::WaitingCount:
+    case Stage::SendingCount:
+        timeout = transfer.rtt().timeout();
+        break;
+    case Stage::WaitingItem:
+    case Stage::SendingItem:
+    case Stage::WaitongAck:
+        timeout = transfer.nextTimeout(d->clock.elapsed());
+        break;
+    case Stage::Idle:
+    default:
+        break;
     }
+
+    if (timeout > -1) d->mavTimers[mavId] = this->startTimer(qMax(timeout, 1));
+}
+
+void MissionHandler::reportProgress(const dto::MissionAssignmentPtr& assignment)
+{
+    if (!d->changedAssignments.contains(assignment)) d->changedAssignments.append(assignment);
+    if (!d->progressTimer) d->progressTimer = this->startTimer(::progressInterval);
 }
 
 void MissionHandler::timerEvent(QTimerEvent* event)
 {
+    if (event->timerId() == d->progressTimer)
+    {
+        this->killTimer(d->progressTimer);
+        d->progressTimer = 0;
+
+        for (const dto::MissionAssignmentPtr& assignment: d->changedAssignments)
+        {
+            d->missionService->assignmentChanged(assignment);
+        }
+        d->changedAssignments.clear();
+        return;
+    }
+
     quint8 mavId = d->mavTimers.key(event->timerId(), 0);
-    if (!mavId) QObject::timerEvent(event);
+    if (!mavId)
+    {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    MissionTransfer& transfer = d->transfer(mavId);
+    qint64 now = d->clock.elapsed();
 
     switch (d->mavStages.value(mavId, Stage::Idle))
     {
     case Stage::WaitingCount:
+        transfer.rtt().backOff();
         this->requestMissionCount(mavId);
         break;
+    case Stage::SendingCount:
+        transfer.rtt().backOff();
+        if (d->mavRanges.contains(mavId)) this->sendMissionWritePartial(mavId);
+        else this->sendMissionCount(mavId);
+        break;
     case Stage::WaitingItem:
     {
-        const QList<int>& list = d->mavSequencer[mavId];
-        if (list.isEmpty()) this->enterStage(Stage::Idle, mavId);
-        else this->requestMissionItem(mavId, list.first());
+        QList<int> expired = transfer.takeExpired(now);
+
+        // Vehicle, silent to MISSION_REQUEST_INT from the start, may not know it
+        if (!expired.isEmpty() && !transfer.doneCount() && !d->mavIntItems.contains(mavId))
+        {
+            d->mavIntItems[mavId] = false;
+        }
+
+        for (int seq: expired) this->requestMissionItem(mavId, seq);
+        for (int seq: transfer.takeRequests(now)) this->requestMissionItem(mavId, seq);
         break;
     }
-    case Stage::SendingCount:
-        this->sendMissionCount(mavId);
+    case Stage::SendingItem:
+    case Stage::WaitongAck:
+        // Item is lost or the request for the next one is lost, vehicle gets the item again
+        for (int seq: transfer.takeExpired(now)) this->sendMissionItem(mavId, seq);
+        break;
     case Stage::Idle:
     default:
         break;
     }
+
+    this->schedule(mavId);
 }
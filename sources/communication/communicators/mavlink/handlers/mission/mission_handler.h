@@ -42,14 +42,20 @@ namespace comm
        void upload(const dto::MissionAssignmentPtr& assignment);
        void cancelSync(const dto::MissionAssignmentPtr& assignment);
 
+       // Items requested at once while downloading, overrides the one learned from autopilot
+       void setTransferWindow(quint8 mavId, int window);
+
        void requestMissionCount(quint8 mavId);
        void requestMissionItem(quint8 mavId, quint16 seq);
 
        void sendMissionCount(quint8 mavId);
+       void sendMissionWritePartial(quint8 mavId);
        void sendMissionItem(quint8 mavId, quint16 seq);
        void sendMissionAck(quint8 mavId);
 
     protected:
+        void processHeartbeat(const mavlink_message_t& message);
+        void processAutopilotVersion(const mavlink_message_t& message);
         void processMissionCount(const mavlink_message_t& message);
         void processMissionItem(const mavlink_message_t& message);
         void processMissionRequest(const mavlink_message_t& message);
@@ -58,6 +64,8 @@ namespace comm
         void processMissionReached(const mavlink_message_t& message);
 
         void enterStage(Stage stage, quint8 mavId);
+        void schedule(quint8 mavId); // Timer for the nearest timeout of the stage
+        void reportProgress(const dto::MissionAssignmentPtr& assignment);
         void timerEvent(QTimerEvent* event) override;
 
     private:
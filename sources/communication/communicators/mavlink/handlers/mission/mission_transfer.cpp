@@ -0,0 +1,197 @@
+#include "mission_transfer.h"
+
+namespace
+{
+    const double initialWindow = 4;
+}
+
+using namespace comm;
+
+MissionTransfer::MissionTransfer()
+{}
+
+void MissionTransfer::start(int count)
+{
+    m_count = qMax(count, 0);
+    m_done.fill(false, m_count);
+    m_retransmitted.fill(false, m_count);
+    m_sent.fill(0, m_count);
+    m_doneCount = 0;
+    m_inFlight = 0;
+    m_low = 0;
+    m_next = 0;
+    m_lastSent = -1;
+    m_window = qMin(::initialWindow, double(m_maxWindow));
+}
+
+void MissionTransfer::start(int count, int first, int last)
+{
+    this->start(count);
+
+    first = qBound(0, first, m_count);
+    last = qBound(first - 1, last, m_count - 1);
+
+    for (int seq = 0; seq < m_count; ++seq)
+    {
+        if (seq >= first && seq <= last) continue;
+
+        m_done.setBit(seq);
+        m_doneCount++;
+    }
+
+    m_low = first;
+    m_next = first;
+    while (m_low < m_count && m_done.testBit(m_low)) m_low++;
+}
+
+void MissionTransfer::stop()
+{
+    this->start(0);
+}
+
+bool MissionTransfer::isActive() const
+{
+    return m_count > 0 && m_doneCount < m_count;
+}
+
+int MissionTransfer::count() const
+{
+    return m_count;
+}
+
+int MissionTransfer::doneCount() const
+{
+    return m_doneCount;
+}
+
+bool MissionTransfer::isDone(int seq) const
+{
+    return seq >= 0 && seq < m_count && m_done.testBit(seq);
+}
+
+bool MissionTransfer::isComplete() const
+{
+    return m_doneCount == m_count;
+}
+
+int MissionTransfer::lastSent() const
+{
+    return m_lastSent;
+}
+
+int MissionTransfer::maxWindow() const
+{
+    return m_maxWindow;
+}
+
+void MissionTransfer::setMaxWindow(int maxWindow)
+{
+    m_maxWindow = qMax(maxWindow, 1);
+    m_window = qMin(m_window, double(m_maxWindow));
+}
+
+int MissionTransfer::window() const
+{
+    return int(m_window);
+}
+
+utils::RttEstimator& MissionTransfer::rtt()
+{
+    return m_rtt;
+}
+
+const utils::RttEstimator& MissionTransfer::rtt() const
+{
+    return m_rtt;
+}
+
+QList<int> MissionTransfer::takeRequests(qint64 now)
+{
+    QList<int> requests;
+
+    while (m_inFlight < this->window() && m_next < m_count)
+    {
+        int seq = m_next;
+        if (!m_done.testBit(seq) && !m_sent[seq])
+        {
+            this->markSent(seq, now);
+            requests.append(seq);
+        }
+        else m_next++;
+    }
+
+    return requests;
+}
+
+QList<int> MissionTransfer::takeExpired(qint64 now)
+{
+    QList<int> expired;
+    int timeout = m_rtt.timeout();
+
+    for (int seq = m_low; seq < m_next; ++seq)
+    {
+        if (m_done.testBit(seq) || !m_sent[seq] || now - m_sent[seq] < timeout) continue;
+
+        this->markSent(seq, now);
+        expired.append(seq);
+    }
+
+    // Loss is taken as congestion of the link
+    if (!expired.isEmpty())
+    {
+        m_window = qMax(1.0, m_window / 2);
+        m_rtt.backOff();
+    }
+
+    return expired;
+}
+
+void MissionTransfer::markSent(int seq, qint64 now)
+{
+    if (seq < 0 || seq >= m_count) return;
+
+    if (m_sent[seq]) m_retransmitted.setBit(seq);
+    else if (!m_done.testBit(seq)) m_inFlight++;
+
+    // Zero time stands for not in flight
+    m_sent[seq] = qMax(now, qint64(1));
+    m_next = qMax(m_next, seq + 1);
+    m_lastSent = seq;
+}
+
+bool MissionTransfer::markDone(int seq, qint64 now)
+{
+    if (seq < 0 || seq >= m_count || m_done.testBit(seq)) return false;
+
+    if (m_sent[seq])
+    {
+        if (!m_retransmitted.testBit(seq)) m_rtt.addSample(now - m_sent[seq]);
+
+        m_sent[seq] = 0;
+        m_inFlight--;
+    }
+
+    m_done.setBit(seq);
+    m_doneCount++;
+
+    m_window = qMin(m_window + 1 / m_window, double(m_maxWindow));
+    while (m_low < m_count && m_done.testBit(m_low)) m_low++;
+
+    return true;
+}
+
+int MissionTransfer::nextTimeout(qint64 now) const
+{
+    int timeout = m_rtt.timeout();
+    qint64 nearest = -1;
+
+    for (int seq = m_low; seq < m_next; ++seq)
+    {
+        if (m_done.testBit(seq) || !m_sent[seq]) continue;
+
+        qint64 left = qMax(m_sent[seq] + timeout - now, qint64(0));
+        if (nearest < 0 || left < nearest) nearest = left;
+    }
+
+    return int(nearest);
+}
@@ -0,0 +1,74 @@
+#ifndef MISSION_TRANSFER_H
+#define MISSION_TRANSFER_H
+
+// Qt
+#include <QBitArray>
+#include <QVector>
+#include <QList>
+
+// Internal
+#include "rtt_estimator.h"
+
+namespace comm
+{
+    // State of one mission transfer with a vehicle: sequences, which are done, and sequences in
+    // flight with the time they were sent. Timed out sequences are sent again selectively with the
+    // timeout of the measured round trip. Item requests of download are pipelined in a window,
+    // which grows with every answer and halves on loss. Round trip estimate is kept between
+    // transfers of the same vehicle.
+    class MissionTransfer
+    {
+    public:
+        MissionTransfer();
+
+        void start(int count);
+        // Only sequences from first to last are transferred, others are taken as done
+        void start(int count, int first, int last);
+        void stop();
+        bool isActive() const;
+
+        int count() const;
+        int doneCount() const;
+        bool isDone(int seq) const;
+        bool isComplete() const;
+
+        int lastSent() const; // -1 if nothing was sent
+
+        // One for autopilots, answering only the expected request
+        int maxWindow() const;
+        void setMaxWindow(int maxWindow);
+        int window() const;
+
+        utils::RttEstimator& rtt();
+        const utils::RttEstimator& rtt() const;
+
+        // Lowest sequences, which are neither done nor in flight, fill the window
+        QList<int> takeRequests(qint64 now);
+        // Sequences, which are in flight longer than timeout, are sent again
+        QList<int> takeExpired(qint64 now);
+
+        void markSent(int seq, qint64 now);
+        // Returns false for sequences out of the transfer or done already
+        bool markDone(int seq, qint64 now);
+
+        // Milliseconds to the nearest timeout, -1 if nothing is in flight
+        int nextTimeout(qint64 now) const;
+
+    private:
+        int m_count = 0;
+        QBitArray m_done;
+        QBitArray m_retransmitted; // answers of the retransmitted are not sampled
+        QVector<qint64> m_sent; // time of the last sending, zero if not in flight
+        int m_doneCount = 0;
+        int m_inFlight = 0;
+        int m_low = 0; // lowest sequence, which is not done
+        int m_next = 0; // above every sequence, sent once
+        int m_lastSent = -1;
+
+        double m_window = 1;
+        int m_maxWindow = 1;
+        utils::RttEstimator m_rtt;
+    };
+}
+
+#endif // MISSION_TRANSFER_H
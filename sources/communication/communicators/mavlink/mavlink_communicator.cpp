@@ -7,11 +7,26 @@
 
 // Qt
 #include <QMap>
+#include <QVector>
+#include <QThread>
 #include <QDebug>
 
 // Internal
 #include "abstract_link.h"
 #include "abstract_mavlink_handler.h"
+#include "mavlink_message_queue.h"
+#include "mavlink_parse_worker.h"
+#include "tlog_recorder.h"
+#include "latency_monitor.h"
+
+namespace
+{
+#ifdef MAVLINK_V2
+    const quint32 maxDispatchedMessageId = 0xFFFF;
+#else
+    const quint32 maxDispatchedMessageId = 0xFF;
+#endif
+}
 
 using namespace comm;
 
@@ -23,14 +38,83 @@ public:
     bool retranslationEnabled;
 
     QMap<AbstractLink*, quint8> linkChannels;
+    QMap<AbstractLink*, MavLinkParseContextPtr> linkContexts;
+    quint32 linkGeneration = 0;
     QMap<quint8, AbstractLink*> mavSystemLinks;
     QList<quint8> avalibleChannels;
     AbstractLink* receivedLink = nullptr;
 
+    // Optional parse threads, parsed messages come back through the queue
+    QList<QThread*> parseThreads;
+    QList<MavLinkParseWorker*> parseWorkers;
+    QMap<AbstractLink*, MavLinkParseWorker*> linkWorkers;
+    MavLinkMessageQueue queue;
+    int nextWorker = 0;
+
+    TlogRecorder* recorder = nullptr;
+
     QList<AbstractMavLinkHandler*> handlers;
 
-    int oldPacketsReceived = 0;
-    int oldPacketsDrops = 0;
+    // Handlers indexed by message id, every entry also holds the catch-all handlers
+    QVector<QVector<AbstractMavLinkHandler*> > dispatchTable;
+    QVector<AbstractMavLinkHandler*> catchAllHandlers;
+
+    const QVector<AbstractMavLinkHandler*>& messageHandlers(quint32 msgId) const
+    {
+        return msgId < quint32(dispatchTable.size()) ? dispatchTable.at(msgId) : catchAllHandlers;
+    }
+
+    void registerHandler(AbstractMavLinkHandler* handler)
+    {
+        const QList<quint32> messageIds = handler->messageIds();
+
+        if (messageIds.isEmpty())
+        {
+            catchAllHandlers.append(handler);
+            for (QVector<AbstractMavLinkHandler*>& entry: dispatchTable) entry.append(handler);
+            return;
+        }
+
+        for (quint32 msgId: messageIds)
+        {
+            if (msgId > ::maxDispatchedMessageId)
+            {
+                qWarning() << "Message id is out of dispatch table" << msgId;
+                continue;
+            }
+
+            // New entries inherit catch-all handlers, that were registered before
+            while (msgId >= quint32(dispatchTable.size())) dispatchTable.append(catchAllHandlers);
+
+            dispatchTable[msgId].append(handler);
+        }
+    }
+
+    void assignWorker(AbstractLink* link)
+    {
+        if (parseWorkers.isEmpty()) return;
+
+        linkWorkers[link] = parseWorkers.at(nextWorker++ % parseWorkers.count());
+    }
+
+    void stopParseThreads()
+    {
+        // Worker, waiting for the full queue, leaves the wait on interruption
+        for (QThread* thread: parseThreads)
+        {
+            thread->requestInterruption();
+            thread->quit();
+        }
+        queue.wakeProducers();
+        for (QThread* thread: parseThreads) thread->wait();
+
+        qDeleteAll(parseWorkers);
+        qDeleteAll(parseThreads);
+        parseWorkers.clear();
+        parseThreads.clear();
+        linkWorkers.clear();
+        nextWorker = 0;
+    }
 };
 
 MavLinkCommunicator::MavLinkCommunicator(quint8 systemId, quint8 componentId,
@@ -39,6 +123,7 @@ MavLinkCommunicator::MavLinkCommunicator(quint8 systemId, quint8 componentId,
     d(new Impl())
 {
     qRegisterMetaType<mavlink_message_t>("mavlink_message_t");
+    qRegisterMetaType<MavLinkParseContextPtr>("comm::MavLinkParseContextPtr");
 
     d->systemId = systemId;
     d->componentId = componentId;
@@ -52,6 +137,8 @@ MavLinkCommunicator::MavLinkCommunicator(quint8 systemId, quint8 componentId,
 
 MavLinkCommunicator::~MavLinkCommunicator()
 {
+    d->stopParseThreads();
+
     while (!d->handlers.isEmpty())
     {
         delete d->handlers.takeLast();
@@ -83,6 +170,16 @@ quint8 MavLinkCommunicator::linkChannel(AbstractLink* link) const
     return d->linkChannels.value(link, 0);
 }
 
+int MavLinkCommunicator::parseThreads() const
+{
+    return d->parseThreads.count();
+}
+
+TlogRecorder* MavLinkCommunicator::recorder() const
+{
+    return d->recorder;
+}
+
 AbstractLink* MavLinkCommunicator::lastReceivedLink() const
 {
     return d->receivedLink;
@@ -98,6 +195,9 @@ void MavLinkCommunicator::addLink(AbstractLink* link)
     if (d->linkChannels.contains(link) || d->avalibleChannels.isEmpty()) return;
 
     d->linkChannels[link] = d->avalibleChannels.takeFirst();
+    d->linkContexts[link] = MavLinkParseContextPtr::create(link, d->linkChannels[link],
+                                                           ++d->linkGeneration);
+    d->assignWorker(link);
     if (d->avalibleChannels.isEmpty()) emit addLinkEnabledChanged(false);
 
     AbstractCommunicator::addLink(link);
@@ -110,6 +210,9 @@ void MavLinkCommunicator::removeLink(AbstractLink* link)
     quint8 channel = d->linkChannels.value(link);
     d->linkChannels.remove(link);
     d->avalibleChannels.prepend(channel);
+    // Parse thread may still hold the context, messages of old generation will be skipped
+    d->linkContexts.remove(link);
+    d->linkWorkers.remove(link);
 
     quint8 mavId = d->mavSystemLinks.key(link, 0);
     if (mavId) d->mavSystemLinks.remove(mavId);
@@ -167,9 +270,38 @@ void MavLinkCommunicator::setRetranslationEnabled(bool retranslationEnabled)
     emit retranslationEnabledChanged(retranslationEnabled);
 }
 
+void MavLinkCommunicator::setParseThreads(int count)
+{
+    d->stopParseThreads();
+
+    for (int i = 0; i < count; ++i)
+    {
+        QThread* thread = new QThread();
+        thread->setObjectName(QString("MAVLink parse thread %1").arg(i + 1));
+
+        MavLinkParseWorker* worker = new MavLinkParseWorker(&d->queue);
+        worker->moveToThread(thread);
+        connect(worker, &MavLinkParseWorker::messagesQueued,
+                this, &MavLinkCommunicator::onMessagesQueued, Qt::QueuedConnection);
+
+        thread->start();
+
+        d->parseThreads.append(thread);
+        d->parseWorkers.append(worker);
+    }
+
+    for (AbstractLink* link: d->linkContexts.keys()) d->assignWorker(link);
+}
+
+void MavLinkCommunicator::setRecorder(TlogRecorder* recorder)
+{
+    d->recorder = recorder;
+}
+
 void MavLinkCommunicator::addHandler(AbstractMavLinkHandler* handler)
 {
     d->handlers.append(handler);
+    d->registerHandler(handler);
 }
 
 void MavLinkCommunicator::sendMessage(mavlink_message_t& message, AbstractLink* link)
@@ -187,52 +319,109 @@ void MavLinkCommunicator::sendMessage(mavlink_message_t& message, AbstractLink*
 
 void MavLinkCommunicator::onDataReceived(const QByteArray& data)
 {
-    d->receivedLink = qobject_cast<AbstractLink*>(this->sender());
-    if (!d->receivedLink) return;
+    AbstractLink* link = qobject_cast<AbstractLink*>(this->sender());
+    if (!link) return;
+
+    MavLinkParseContextPtr context = d->linkContexts.value(link);
+    if (!context) return;
+
+    if (MavLinkParseWorker* worker = d->linkWorkers.value(link, nullptr))
+    {
+        QMetaObject::invokeMethod(worker, "parse", Qt::QueuedConnection,
+                                  Q_ARG(comm::MavLinkParseContextPtr, context),
+                                  Q_ARG(QByteArray, data),
+                                  Q_ARG(qint64, utils::LatencyMonitor::origin()));
+        return;
+    }
+
+    d->receivedLink = link;
+    context->protocolSwitched = false;
 
     mavlink_message_t message;
-    mavlink_status_t status;
+    context->parser.setData(data.constData(), data.size());
 
-    quint8 channel = this->linkChannel(d->receivedLink);
-    for (int pos = 0; pos < data.length(); ++pos)
+    while (context->parser.next(message))
     {
-        if (!mavlink_parse_char(channel, (quint8)data[pos], &message, &status)) continue;
+        utils::LatencyMonitor::record(utils::LatencyMonitor::Parse,
+                                      utils::LatencyMonitor::origin());
+        this->processMessage(context.data(), message);
+    }
+
+    context->publishStatistics();
+    this->reportStatistics(context.data());
+}
+
+void MavLinkCommunicator::onMessagesQueued()
+{
+    d->queue.drainStarted();
+
+    MavLinkMessageQueue::Item item;
+    while (d->queue.pop(item))
+    {
+        // Link could be removed or readded while message was in the queue
+        MavLinkParseContextPtr context = d->linkContexts.value(item.link);
+        if (!context || context->generation != item.generation) continue;
+
+        d->receivedLink = item.link;
+
+        utils::LatencyScope scope(item.origin);
+        this->processMessage(context.data(), item.message);
+    }
 
+    for (const MavLinkParseContextPtr& context: d->linkContexts)
+    {
+        context->protocolSwitched = false;
+        this->reportStatistics(context.data());
+    }
+}
+
+void MavLinkCommunicator::processMessage(MavLinkParseContext* context,
+                                         const mavlink_message_t& message)
+{
 #ifdef MAVLINK_V2
-       // if we got MavLink v2, switch to on it!
-       mavlink_status_t* channelStatus = mavlink_get_channel_status(channel);
-       if (!(channelStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1))
-       {
-           this->switchLinkProtocol(d->receivedLink, MavLink2);
-       }
+    // if we got MavLink v2, switch to on it!
+    if (!context->protocolSwitched && message.magic == MAVLINK_STX)
+    {
+        context->protocolSwitched = true;
+        this->switchLinkProtocol(context->link, MavLink2);
+    }
+#else
+    Q_UNUSED(context)
 #endif
 
-        d->mavSystemLinks[message.sysid] = d->receivedLink;
+    d->mavSystemLinks[message.sysid] = d->receivedLink;
 
-        for (AbstractMavLinkHandler* handler: d->handlers)
-        {
-            handler->processMessage(message);
-        }
+    if (d->recorder) d->recorder->record(message);
+
+    for (AbstractMavLinkHandler* handler: d->messageHandlers(message.msgid))
+    {
+        handler->processMessage(message);
+    }
+
+    utils::LatencyMonitor::record(utils::LatencyMonitor::HandlerDecode,
+                                  utils::LatencyMonitor::origin());
 
-        if (d->retranslationEnabled)
+    if (d->retranslationEnabled)
+    {
+        mavlink_message_t retranslated = message;
+        for (AbstractLink* link: this->links())
         {
-            for (AbstractLink* link: this->links())
-            {
-                if (link != d->receivedLink) this->sendMessage(message, link);
-            }
+            if (link != d->receivedLink) this->sendMessage(retranslated, link);
         }
     }
+}
 
-    if (d->oldPacketsReceived != status.packet_rx_success_count ||
-        d->oldPacketsDrops != status.packet_rx_drop_count)
-    {
-        emit mavLinkStatisticsChanged(d->receivedLink,
-                                      status.packet_rx_success_count,
-                                      status.packet_rx_drop_count);
+void MavLinkCommunicator::reportStatistics(MavLinkParseContext* context)
+{
+    int packetsReceived = context->packetsReceived.loadAcquire();
+    int packetsDrops = context->packetsDrops.loadAcquire();
 
-        d->oldPacketsReceived = status.packet_rx_success_count;
-        d->oldPacketsDrops = status.packet_rx_drop_count;
-    }
+    if (packetsReceived == context->reportedPacketsReceived &&
+        packetsDrops == context->reportedPacketsDrops) return;
+
+    context->reportedPacketsReceived = packetsReceived;
+    context->reportedPacketsDrops = packetsDrops;
+    emit mavLinkStatisticsChanged(context->link, packetsReceived, packetsDrops);
 }
 
 void MavLinkCommunicator::finalizeMessage(mavlink_message_t& message)
@@ -9,6 +9,8 @@
 namespace comm
 {
     class AbstractMavLinkHandler;
+    class MavLinkParseContext;
+    class TlogRecorder;
 
     class MavLinkCommunicator: public AbstractCommunicator
     {
@@ -27,6 +29,11 @@ namespace comm
 
         quint8 linkChannel(AbstractLink* link) const;
 
+        // Zero means links data is parsed in the communicator thread
+        int parseThreads() const;
+
+        TlogRecorder* recorder() const;
+
         AbstractLink* lastReceivedLink() const;
         AbstractLink* mavSystemLink(quint8 systemId);
 
@@ -40,6 +47,9 @@ namespace comm
         void setComponentId(quint8 componentId);
         void setRetranslationEnabled(bool retranslationEnabled);
 
+        void setParseThreads(int count);
+        void setRecorder(TlogRecorder* recorder); // Records received messages, if set
+
         void addHandler(AbstractMavLinkHandler* handler);
 
         void sendMessage(mavlink_message_t& message, AbstractLink* link);
@@ -55,7 +65,13 @@ namespace comm
     protected:
         virtual void finalizeMessage(mavlink_message_t& message);
 
+    private slots:
+        void onMessagesQueued();
+
     private:
+        void processMessage(MavLinkParseContext* context, const mavlink_message_t& message);
+        void reportStatistics(MavLinkParseContext* context);
+
         class Impl;
         QScopedPointer<Impl> const d;
     };
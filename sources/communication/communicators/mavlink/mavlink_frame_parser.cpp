@@ -0,0 +1,197 @@
+#include "mavlink_frame_parser.h"
+
+// MAVLink
+#include <mavlink.h>
+#include <mavlink_helpers.h>
+
+// Std
+#include <string.h>
+
+using namespace comm;
+
+MavLinkFrameParser::MavLinkFrameParser(quint8 channel):
+    m_channel(channel)
+{
+#ifdef MAVLINK_V2
+    ::memset(&m_rxMessage, 0, sizeof(m_rxMessage));
+    ::memset(&m_rxStatus, 0, sizeof(m_rxStatus));
+#endif
+}
+
+quint8 MavLinkFrameParser::channel() const
+{
+    return m_channel;
+}
+
+int MavLinkFrameParser::packetsReceived() const
+{
+    return m_packetsReceived;
+}
+
+int MavLinkFrameParser::packetsDrops() const
+{
+    return m_packetsDrops;
+}
+
+void MavLinkFrameParser::setData(const char* data, int size)
+{
+    m_data = reinterpret_cast<const quint8*>(data);
+    m_size = size;
+    m_position = 0;
+}
+
+bool MavLinkFrameParser::next(mavlink_message_t& message)
+{
+    while (m_position < m_size)
+    {
+#ifdef MAVLINK_V2
+        // Frame was started in the previous buffer, let byte parser finish it
+        if (m_rxStatus.parse_state > MAVLINK_PARSE_STATE_IDLE)
+        {
+            if (this->parseChar(message)) return true;
+            continue;
+        }
+
+        switch (this->parseFrame(message))
+        {
+        case Frame::Parsed:
+            return true;
+        case Frame::Incomplete:
+            // Feed STX to the byte parser, it will keep frame state till the next buffer
+            if (this->parseChar(message)) return true;
+            break;
+        case Frame::Skipped:
+        default:
+            break;
+        }
+#else
+        if (this->parseChar(message)) return true;
+#endif
+    }
+
+    return false;
+}
+
+#ifdef MAVLINK_V2
+MavLinkFrameParser::Frame MavLinkFrameParser::parseFrame(mavlink_message_t& message)
+{
+    // Skip garbage till the nearest frame start
+    while (m_data[m_position] != MAVLINK_STX && m_data[m_position] != MAVLINK_STX_MAVLINK1)
+    {
+        if (++m_position >= m_size) return Frame::Skipped;
+    }
+
+    const quint8* frame = m_data + m_position;
+    const int available = m_size - m_position;
+
+    const bool mavlink1 = frame[0] == MAVLINK_STX_MAVLINK1;
+    const int headerLength = mavlink1 ? MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 :
+                                        MAVLINK_NUM_HEADER_BYTES;
+    if (available < headerLength) return Frame::Incomplete;
+
+    const quint8 payloadLength = frame[1];
+    const quint8 incompatFlags = mavlink1 ? 0 : frame[2];
+
+    // Byte parser ignores frames with unknown incompatible features too
+    if (incompatFlags & ~MAVLINK_IFLAG_MASK)
+    {
+        m_position++;
+        return Frame::Skipped;
+    }
+
+    const int signatureLength = incompatFlags & MAVLINK_IFLAG_SIGNED ?
+                                    MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+    const int frameLength = headerLength + payloadLength + MAVLINK_NUM_CHECKSUM_BYTES +
+                            signatureLength;
+    if (available < frameLength) return Frame::Incomplete;
+
+    const quint32 msgId = mavlink1 ? frame[5] : frame[7] | (frame[8] << 8) |
+                                                (quint32(frame[9]) << 16);
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(msgId);
+
+    quint16 checksum;
+    crc_init(&checksum);
+    crc_accumulate_buffer(&checksum, reinterpret_cast<const char*>(frame + 1),
+                          headerLength - 1 + payloadLength);
+    crc_accumulate(entry ? entry->crc_extra : 0, &checksum);
+
+    const quint8* ck = frame + headerLength + payloadLength;
+    if (ck[0] != (checksum & 0xFF) || ck[1] != (checksum >> 8))
+    {
+        // False or broken frame start, resync from the next byte
+        m_packetsDrops++;
+        m_position++;
+        return Frame::Skipped;
+    }
+
+    message.magic = frame[0];
+    message.len = payloadLength;
+    message.incompat_flags = incompatFlags;
+    message.compat_flags = mavlink1 ? 0 : frame[3];
+    message.seq = frame[mavlink1 ? 2 : 4];
+    message.sysid = frame[mavlink1 ? 3 : 5];
+    message.compid = frame[mavlink1 ? 4 : 6];
+    message.msgid = msgId;
+    message.checksum = checksum;
+    message.ck[0] = ck[0];
+    message.ck[1] = ck[1];
+
+    char* payload = _MAV_PAYLOAD_NON_CONST(&message);
+    ::memcpy(payload, frame + headerLength, payloadLength);
+
+    // Zero-fill truncated payload, as byte parser does
+    if (entry && payloadLength < entry->max_msg_len)
+    {
+        ::memset(payload + payloadLength, 0, entry->max_msg_len - payloadLength);
+    }
+
+    if (signatureLength)
+    {
+        ::memcpy(message.signature, ck + MAVLINK_NUM_CHECKSUM_BYTES, signatureLength);
+    }
+
+    m_position += frameLength;
+    m_packetsReceived++;
+
+    return Frame::Parsed;
+}
+
+bool MavLinkFrameParser::parseChar(mavlink_message_t& message)
+{
+    const quint8 c = m_data[m_position++];
+
+    mavlink_status_t status;
+    switch (mavlink_frame_char_buffer(&m_rxMessage, &m_rxStatus, c, &message, &status))
+    {
+    case MAVLINK_FRAMING_OK:
+        m_packetsReceived++;
+        return true;
+    case MAVLINK_FRAMING_BAD_CRC:
+    case MAVLINK_FRAMING_BAD_SIGNATURE:
+        // Reset framing in the same way as mavlink_parse_char does
+        m_packetsDrops++;
+        m_rxStatus.msg_received = MAVLINK_FRAMING_INCOMPLETE;
+        m_rxStatus.parse_state = MAVLINK_PARSE_STATE_IDLE;
+        if (c == MAVLINK_STX)
+        {
+            m_rxStatus.parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+            m_rxMessage.len = 0;
+            mavlink_start_checksum(&m_rxMessage);
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+#else
+bool MavLinkFrameParser::parseChar(mavlink_message_t& message)
+{
+    mavlink_status_t status;
+    bool parsed = mavlink_parse_char(m_channel, m_data[m_position++], &message, &status);
+
+    m_packetsDrops += status.packet_rx_drop_count;
+    if (parsed) m_packetsReceived++;
+
+    return parsed;
+}
+#endif
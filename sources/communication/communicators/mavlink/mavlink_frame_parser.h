@@ -0,0 +1,57 @@
+#ifndef MAVLINK_FRAME_PARSER_H
+#define MAVLINK_FRAME_PARSER_H
+
+// Qt
+#include <QtGlobal>
+
+// MAVLink
+#include <mavlink_types.h>
+
+namespace comm
+{
+    // Scans whole frames in received buffer and validates them at once. Frames, splitted by
+    // buffer boundary, are finished by the byte parser with state kept between buffers.
+    class MavLinkFrameParser
+    {
+    public:
+        explicit MavLinkFrameParser(quint8 channel);
+
+        quint8 channel() const;
+
+        int packetsReceived() const;
+        int packetsDrops() const;
+
+        // Data must stay valid until next() returns false
+        void setData(const char* data, int size);
+        bool next(mavlink_message_t& message);
+
+    private:
+#ifdef MAVLINK_V2
+        enum class Frame
+        {
+            Parsed,
+            Skipped,
+            Incomplete
+        };
+
+        Frame parseFrame(mavlink_message_t& message);
+#endif
+        bool parseChar(mavlink_message_t& message);
+
+        const quint8 m_channel;
+
+        const quint8* m_data = nullptr;
+        int m_size = 0;
+        int m_position = 0;
+
+        int m_packetsReceived = 0;
+        int m_packetsDrops = 0;
+
+#ifdef MAVLINK_V2
+        mavlink_message_t m_rxMessage;
+        mavlink_status_t m_rxStatus;
+#endif
+    };
+}
+
+#endif // MAVLINK_FRAME_PARSER_H
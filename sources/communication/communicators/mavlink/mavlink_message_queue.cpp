@@ -0,0 +1,107 @@
+#include "mavlink_message_queue.h"
+
+namespace
+{
+    quint32 roundUpToPowerOfTwo(int value)
+    {
+        quint32 result = 1;
+        while (result < quint32(qMax(value, 2))) result <<= 1;
+        return result;
+    }
+}
+
+using namespace comm;
+
+MavLinkMessageQueue::MavLinkMessageQueue(int capacity):
+    m_mask(::roundUpToPowerOfTwo(capacity) - 1),
+    m_cells(new Cell[m_mask + 1]),
+    m_enqueuePosition(0),
+    m_drainRequested(0),
+    m_waiters(0)
+{
+    for (quint32 i = 0; i <= m_mask; ++i) m_cells[i].sequence.store(i);
+}
+
+MavLinkMessageQueue::~MavLinkMessageQueue()
+{}
+
+int MavLinkMessageQueue::capacity() const
+{
+    return m_mask + 1;
+}
+
+bool MavLinkMessageQueue::push(const Item& item)
+{
+    quint32 position = m_enqueuePosition.loadAcquire();
+    Cell* cell = nullptr;
+
+    forever
+    {
+        cell = &m_cells[position & m_mask];
+        qint32 difference = qint32(cell->sequence.loadAcquire() - position);
+
+        if (difference == 0)
+        {
+            // Cell is free, try to reserve it, on fail position is updated to the actual one
+            if (m_enqueuePosition.testAndSetRelaxed(position, position + 1, position)) break;
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.loadAcquire();
+        }
+    }
+
+    cell->item = item;
+    cell->sequence.storeRelease(position + 1);
+    return true;
+}
+
+bool MavLinkMessageQueue::pop(Item& item)
+{
+    Cell& cell = m_cells[m_dequeuePosition & m_mask];
+    if (qint32(cell.sequence.loadAcquire() - (m_dequeuePosition + 1)) < 0) return false;
+
+    item = cell.item;
+    cell.sequence.storeRelease(m_dequeuePosition + m_mask + 1);
+    ++m_dequeuePosition;
+
+    // Ordered read: waiter, which checked the cell before it was freed, is counted already
+    if (m_waiters.fetchAndAddOrdered(0)) this->wakeProducers();
+    return true;
+}
+
+void MavLinkMessageQueue::waitForSpace(int timeout)
+{
+    QMutexLocker locker(&m_spaceMutex);
+    m_waiters.fetchAndAddOrdered(1);
+
+    // Cell could be freed before the waiter was counted
+    quint32 position = m_enqueuePosition.loadAcquire();
+    if (qint32(m_cells[position & m_mask].sequence.loadAcquire() - position) < 0)
+    {
+        m_spaceFreed.wait(&m_spaceMutex, timeout);
+    }
+
+    m_waiters.fetchAndAddOrdered(-1);
+}
+
+void MavLinkMessageQueue::wakeProducers()
+{
+    QMutexLocker locker(&m_spaceMutex);
+    m_spaceFreed.wakeAll();
+}
+
+bool MavLinkMessageQueue::requestDrain()
+{
+    return m_drainRequested.testAndSetOrdered(0, 1);
+}
+
+void MavLinkMessageQueue::drainStarted()
+{
+    // Full barrier: pushes, that missed the request, must be visible to following pops
+    m_drainRequested.fetchAndStoreOrdered(0);
+}
@@ -0,0 +1,68 @@
+#ifndef MAVLINK_MESSAGE_QUEUE_H
+#define MAVLINK_MESSAGE_QUEUE_H
+
+// Qt
+#include <QAtomicInteger>
+#include <QScopedArrayPointer>
+#include <QMutex>
+#include <QWaitCondition>
+
+// MAVLink
+#include <mavlink_types.h>
+
+namespace comm
+{
+    class AbstractLink;
+
+    // Bounded lock-free queue, many parse threads push parsed messages, handlers stage pops them
+    class MavLinkMessageQueue
+    {
+    public:
+        struct Item
+        {
+            AbstractLink* link;
+            quint32 generation;
+            qint64 origin; // latency origin of the link data
+            mavlink_message_t message;
+        };
+
+        // Capacity is rounded up to the power of two
+        explicit MavLinkMessageQueue(int capacity = 4096);
+        ~MavLinkMessageQueue();
+
+        int capacity() const;
+
+        // Any thread, false if queue is full
+        bool push(const Item& item);
+        // Consumer thread only, false if queue is empty, wakes producers waiting for space
+        bool pop(Item& item);
+
+        // Producer of the full queue sleeps until a cell is freed, timeout (ms) or wake up
+        void waitForSpace(int timeout);
+        void wakeProducers();
+
+        // Returns true only for the first request after drainStarted(), so consumer is woken once
+        bool requestDrain();
+        void drainStarted();
+
+    private:
+        struct Cell
+        {
+            QAtomicInteger<quint32> sequence;
+            Item item;
+        };
+
+        const quint32 m_mask;
+        QScopedArrayPointer<Cell> m_cells;
+        QAtomicInteger<quint32> m_enqueuePosition;
+        quint32 m_dequeuePosition = 0;
+        QAtomicInt m_drainRequested;
+
+        // Lock-free path doesn't touch them, only the full queue does
+        QMutex m_spaceMutex;
+        QWaitCondition m_spaceFreed;
+        QAtomicInt m_waiters;
+    };
+}
+
+#endif // MAVLINK_MESSAGE_QUEUE_H
@@ -0,0 +1,81 @@
+#include "mavlink_parse_worker.h"
+
+// Qt
+#include <QThread>
+
+// Internal
+#include "mavlink_message_queue.h"
+#include "latency_monitor.h"
+
+namespace
+{
+    const int spaceTimeout = 10; // ms, interruption is checked at least that often
+}
+
+using namespace comm;
+
+MavLinkParseContext::MavLinkParseContext(AbstractLink* link, quint8 channel,
+                                         quint32 generation):
+    link(link),
+    generation(generation),
+    parser(channel),
+    packetsReceived(0),
+    packetsDrops(0)
+{}
+
+bool MavLinkParseContext::publishStatistics()
+{
+    bool changed = false;
+
+    if (packetsReceived.load() != parser.packetsReceived())
+    {
+        packetsReceived.storeRelease(parser.packetsReceived());
+        changed = true;
+    }
+
+    int drops = parser.packetsDrops() + queueDrops;
+    if (packetsDrops.load() != drops)
+    {
+        packetsDrops.storeRelease(drops);
+        changed = true;
+    }
+
+    return changed;
+}
+
+MavLinkParseWorker::MavLinkParseWorker(MavLinkMessageQueue* queue, QObject* parent):
+    QObject(parent),
+    m_queue(queue)
+{}
+
+void MavLinkParseWorker::parse(const MavLinkParseContextPtr& context, const QByteArray& data,
+                               qint64 origin)
+{
+    MavLinkMessageQueue::Item item;
+    item.link = context->link;
+    item.generation = context->generation;
+    item.origin = origin;
+
+    context->parser.setData(data.constData(), data.size());
+
+    while (context->parser.next(item.message))
+    {
+        utils::LatencyMonitor::record(utils::LatencyMonitor::Parse, origin);
+
+        while (!m_queue->push(item))
+        {
+            // Communicator, which is waiting for this thread to stop, drains nothing anymore
+            if (QThread::currentThread()->isInterruptionRequested())
+            {
+                context->queueDrops++;
+                break;
+            }
+
+            // Queue is full, sleep until the handlers stage frees a cell
+            if (m_queue->requestDrain()) emit messagesQueued();
+            m_queue->waitForSpace(::spaceTimeout);
+        }
+    }
+
+    if (context->publishStatistics() && m_queue->requestDrain()) emit messagesQueued();
+}
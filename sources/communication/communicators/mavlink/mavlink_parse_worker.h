@@ -0,0 +1,64 @@
+#ifndef MAVLINK_PARSE_WORKER_H
+#define MAVLINK_PARSE_WORKER_H
+
+// Qt
+#include <QObject>
+#include <QSharedPointer>
+
+// Internal
+#include "mavlink_frame_parser.h"
+
+namespace comm
+{
+    class AbstractLink;
+    class MavLinkMessageQueue;
+
+    // Parse state of a link. Parser is used by one thread at a time, counters are published
+    // by the parsing thread and reported by the communicator.
+    class MavLinkParseContext
+    {
+    public:
+        MavLinkParseContext(AbstractLink* link, quint8 channel, quint32 generation);
+
+        AbstractLink* const link;
+        const quint32 generation;
+
+        MavLinkFrameParser parser;
+
+        QAtomicInt packetsReceived;
+        QAtomicInt packetsDrops; // Parser drops and messages, dropped on stop of the thread
+
+        int queueDrops = 0; // Parsing thread side
+
+        // Communicator side
+        int reportedPacketsReceived = 0;
+        int reportedPacketsDrops = 0;
+        bool protocolSwitched = false;
+
+        // Returns true if parser counters changed since last publishing
+        bool publishStatistics();
+    };
+
+    using MavLinkParseContextPtr = QSharedPointer<MavLinkParseContext>;
+
+    // Lives in a parse thread, parses link data and pushes messages to the handlers stage queue
+    class MavLinkParseWorker: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit MavLinkParseWorker(MavLinkMessageQueue* queue, QObject* parent = nullptr);
+
+    public slots:
+        void parse(const comm::MavLinkParseContextPtr& context, const QByteArray& data,
+                   qint64 origin = 0);
+
+    signals:
+        void messagesQueued();
+
+    private:
+        MavLinkMessageQueue* const m_queue;
+    };
+}
+
+#endif // MAVLINK_PARSE_WORKER_H
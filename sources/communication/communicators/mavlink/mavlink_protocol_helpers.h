@@ -21,7 +21,7 @@ namespace comm
 
     inline int32_t encodeLatLon(double value)
     {
-        return value * 1e7;
+        return qRound(value * 1e7); // truncation loses the last 1e-7 digit
     }
 
     inline int32_t encodeAltitude(double value)
@@ -4,6 +4,14 @@
 #include <QAbstractSocket>
 #include <QDebug>
 
+// Internal
+#include "latency_monitor.h"
+
+namespace
+{
+    const int minReceiveBufferSize = 4096;
+}
+
 using namespace comm;
 
 AbstractLink::AbstractLink(QObject* parent):
@@ -37,9 +45,37 @@ void AbstractLink::sendData(const QByteArray& data)
     emit dataSent();
 }
 
+char* AbstractLink::receiveBuffer(int size)
+{
+    m_readStarted = utils::LatencyMonitor::now();
+
+    // Reserved capacity survives shrinking, so buffer reallocates only to grow or
+    // when previous data is still shared by some receiver
+    if (m_receiveBuffer.capacity() < size)
+    {
+        m_receiveBuffer.reserve(qMax(size, ::minReceiveBufferSize));
+    }
+
+    m_receiveBuffer.resize(size);
+    return m_receiveBuffer.data();
+}
+
+void AbstractLink::receiveBufferedData(int size)
+{
+    m_receiveBuffer.resize(size);
+    this->receiveData(m_receiveBuffer);
+}
+
 void AbstractLink::receiveData(const QByteArray& data)
 {
     m_bytesReceived += data.size();
+
+    // Links without receive buffer have no read start, their data originates here
+    qint64 origin = m_readStarted ? m_readStarted : utils::LatencyMonitor::now();
+    m_readStarted = 0;
+    utils::LatencyMonitor::record(utils::LatencyMonitor::LinkRead, origin);
+
+    utils::LatencyScope scope(origin);
     emit dataReceived(data);
 }
 
@@ -34,6 +34,10 @@ namespace comm
     protected:
         virtual bool sendDataImpl(const QByteArray& data) = 0;
 
+        // Reusable buffer for incoming data, it is passed to receivers without copying
+        char* receiveBuffer(int size);
+        void receiveBufferedData(int size);
+
     protected slots:
         void receiveData(const QByteArray& data);
 
@@ -43,6 +47,8 @@ namespace comm
     private:
         int m_bytesReceived = 0;
         int m_bytesSent = 0;
+        QByteArray m_receiveBuffer;
+        qint64 m_readStarted = 0; // latency origin
     };
 }
 
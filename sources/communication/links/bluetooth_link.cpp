@@ -68,7 +68,14 @@ void BluetoothLink::onReadyRead()
 {
     if (!m_socket->isReadable()) return;
 
-    while (m_socket->bytesAvailable()) this->receiveData(m_socket->readAll());
+    qint64 size = 0;
+    while ((size = m_socket->bytesAvailable()) > 0)
+    {
+        size = m_socket->read(this->receiveBuffer(size), size);
+        if (size <= 0) break;
+
+        this->receiveBufferedData(size);
+    }
 }
 
 void BluetoothLink::onError(int error)
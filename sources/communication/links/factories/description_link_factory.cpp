@@ -7,6 +7,7 @@
 #include "udp_link.h"
 #include "tcp_link.h"
 #include "bluetooth_link.h"
+#include "replay_link.h"
 
 using namespace dto;
 using namespace comm;
@@ -63,6 +64,14 @@ namespace
 
         return link;
     }
+
+    ReplayLink* updateReplay(ReplayLink* link, const LinkDescriptionPtr& description)
+    {
+        link->setFileName(description->parameter(LinkDescription::FileName).toString());
+        link->setSpeed(description->parameter(LinkDescription::ReplaySpeed, 1.0).toDouble());
+
+        return link;
+    }
 }
 
 DescriptionLinkFactory::DescriptionLinkFactory(
@@ -81,6 +90,7 @@ AbstractLink* DescriptionLinkFactory::create()
     case LinkDescription::Udp: return ::updateUdp(new UdpLink(), m_description);
     case LinkDescription::Tcp: return ::updateTcp(new TcpLink(), m_description);
     case LinkDescription::Bluetooth: return ::updateBluetooth(new BluetoothLink(), m_description);
+    case LinkDescription::Replay: return ::updateReplay(new ReplayLink(), m_description);
     default:
         return nullptr;
     }
@@ -124,6 +134,14 @@ void DescriptionLinkFactory::update(AbstractLink* link)
        }
        break;
     }
+    case LinkDescription::Replay:
+    {
+       if (ReplayLink* replayLink = qobject_cast<ReplayLink*>(link))
+       {
+           ::updateReplay(replayLink, m_description);
+       }
+       break;
+    }
     default:
         break;
     }
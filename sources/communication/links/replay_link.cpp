@@ -0,0 +1,243 @@
+#include "replay_link.h"
+
+// Qt
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVarLengthArray>
+
+// Std
+#include <string.h>
+#include <limits>
+
+// Internal
+#include "tlog_reader.h"
+
+namespace
+{
+    const int replayInterval = 10; // ms
+    const int maxChunkSize = 64 * 1024;
+    const int maxReplaySlice = 20; // ms, event loop is not blocked longer in fast replay
+}
+
+using namespace comm;
+
+class ReplayLink::Impl
+{
+public:
+    QString fileName;
+    double speed = 1.0;
+    bool paused = false;
+
+    QScopedPointer<TlogReader> reader;
+    QTimer timer;
+
+    // Log time is bound to the wall clock since last start, seek or speed change
+    QElapsedTimer clock;
+    quint64 clockLogTime = 0;
+
+    // Record read ahead, but not replayed yet
+    bool hasRecord = false;
+    quint64 recordTime = 0;
+    const char* recordFrame = nullptr;
+    int recordSize = 0;
+
+    bool readRecord()
+    {
+        hasRecord = reader->next(&recordTime, &recordFrame, &recordSize);
+        return hasRecord;
+    }
+
+    quint64 logTime() const
+    {
+        if (!hasRecord) return reader->endTime();
+        return recordTime;
+    }
+};
+
+ReplayLink::ReplayLink(const QString& fileName, QObject* parent):
+    AbstractLink(parent),
+    d(new Impl())
+{
+    d->fileName = fileName;
+
+    d->timer.setTimerType(Qt::PreciseTimer);
+    connect(&d->timer, &QTimer::timeout, this, &ReplayLink::replay);
+}
+
+ReplayLink::~ReplayLink()
+{}
+
+bool ReplayLink::isConnected() const
+{
+    return d->reader;
+}
+
+QString ReplayLink::fileName() const
+{
+    return d->fileName;
+}
+
+double ReplayLink::speed() const
+{
+    return d->speed;
+}
+
+bool ReplayLink::isPaused() const
+{
+    return d->paused;
+}
+
+qint64 ReplayLink::position() const
+{
+    if (!d->reader) return 0;
+
+    return (d->logTime() - d->reader->startTime()) / 1000;
+}
+
+qint64 ReplayLink::duration() const
+{
+    if (!d->reader) return 0;
+
+    return (d->reader->endTime() - d->reader->startTime()) / 1000;
+}
+
+void ReplayLink::connectLink()
+{
+    if (this->isConnected()) return;
+
+    d->reader.reset(new TlogReader(d->fileName));
+    if (!d->reader->open())
+    {
+        d->reader.reset();
+        emit errored(tr("Can't open replay file %1").arg(d->fileName));
+        return;
+    }
+
+    d->readRecord();
+    this->restartClock();
+    if (!d->paused) d->timer.start(d->speed > 0 ? ::replayInterval : 0);
+
+    emit connectedChanged(true);
+}
+
+void ReplayLink::disconnectLink()
+{
+    if (!this->isConnected()) return;
+
+    d->timer.stop();
+    d->hasRecord = false;
+    d->reader.reset();
+
+    emit connectedChanged(false);
+}
+
+void ReplayLink::setFileName(const QString& fileName)
+{
+    if (d->fileName == fileName) return;
+
+    d->fileName = fileName;
+
+    if (this->isConnected())
+    {
+        this->disconnectLink();
+        this->connectLink();
+    }
+}
+
+void ReplayLink::setSpeed(double speed)
+{
+    d->speed = qMax(speed, 0.0);
+    this->restartClock();
+
+    if (d->timer.isActive()) d->timer.start(d->speed > 0 ? ::replayInterval : 0);
+}
+
+void ReplayLink::setPaused(bool paused)
+{
+    if (d->paused == paused) return;
+
+    d->paused = paused;
+    if (!this->isConnected()) return;
+
+    if (paused)
+    {
+        d->timer.stop();
+    }
+    else
+    {
+        this->restartClock();
+        d->timer.start(d->speed > 0 ? ::replayInterval : 0);
+    }
+}
+
+void ReplayLink::seek(qint64 position)
+{
+    if (!d->reader) return;
+
+    d->reader->seek(d->reader->startTime() + quint64(qMax(position, qint64(0))) * 1000);
+    d->readRecord();
+    this->restartClock();
+
+    if (!d->paused && !d->timer.isActive()) d->timer.start(d->speed > 0 ? ::replayInterval : 0);
+}
+
+bool ReplayLink::sendDataImpl(const QByteArray& data)
+{
+    Q_UNUSED(data)
+    return this->isConnected();
+}
+
+void ReplayLink::replay()
+{
+    QElapsedTimer slice;
+    slice.start();
+
+    // Frames are taken in the mapped log, they are copied once to the receive buffer
+    QVarLengthArray<const char*, 512> frames;
+    QVarLengthArray<int, 512> sizes;
+
+    while (d->hasRecord)
+    {
+        const quint64 replayTime = d->speed > 0 ?
+                                       d->clockLogTime + d->clock.nsecsElapsed() / 1000 * d->speed :
+                                       std::numeric_limits<quint64>::max();
+
+        int chunkSize = 0;
+        frames.clear();
+        sizes.clear();
+
+        while (d->hasRecord && d->recordTime <= replayTime &&
+               chunkSize + d->recordSize <= ::maxChunkSize)
+        {
+            frames.append(d->recordFrame);
+            sizes.append(d->recordSize);
+            chunkSize += d->recordSize;
+
+            d->readRecord();
+        }
+
+        if (!chunkSize) break;
+
+        char* buffer = this->receiveBuffer(chunkSize);
+        for (int i = 0; i < frames.count(); ++i)
+        {
+            ::memcpy(buffer, frames.at(i), sizes.at(i));
+            buffer += sizes.at(i);
+        }
+        this->receiveBufferedData(chunkSize);
+
+        if (slice.hasExpired(::maxReplaySlice)) break;
+    }
+
+    // Link could be disconnected by a receiver
+    if (d->hasRecord || !d->reader) return;
+
+    d->timer.stop();
+    emit finished();
+}
+
+void ReplayLink::restartClock()
+{
+    d->clockLogTime = d->reader ? d->logTime() : 0;
+    d->clock.start();
+}
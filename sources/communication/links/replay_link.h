@@ -0,0 +1,57 @@
+#ifndef REPLAY_LINK_H
+#define REPLAY_LINK_H
+
+// Internal
+#include "abstract_link.h"
+
+namespace comm
+{
+    class TlogReader;
+
+    // Replays recorded tlog as received data, so it goes through the same parsers and handlers
+    // as data of live links. Sent data is dropped.
+    class ReplayLink: public AbstractLink
+    {
+        Q_OBJECT
+
+    public:
+        explicit ReplayLink(const QString& fileName = QString(), QObject* parent = nullptr);
+        ~ReplayLink() override;
+
+        bool isConnected() const override;
+
+        QString fileName() const;
+        double speed() const;
+        bool isPaused() const;
+
+        // Milliseconds from the log start
+        qint64 position() const;
+        qint64 duration() const;
+
+    public slots:
+        void connectLink() override;
+        void disconnectLink() override;
+
+        void setFileName(const QString& fileName);
+        void setSpeed(double speed); // 1 is real time, zero replays as fast as possible
+        void setPaused(bool paused);
+        void seek(qint64 position);
+
+    signals:
+        void finished();
+
+    protected:
+        bool sendDataImpl(const QByteArray& data) override;
+
+    private slots:
+        void replay();
+
+    private:
+        void restartClock();
+
+        class Impl;
+        QScopedPointer<Impl> const d;
+    };
+}
+
+#endif // REPLAY_LINK_H
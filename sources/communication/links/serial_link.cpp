@@ -74,7 +74,13 @@ bool SerialLink::sendDataImpl(const QByteArray& data)
 
 void SerialLink::readSerialData()
 {
-    if (m_port->isReadable()) this->receiveData(m_port->readAll());
+    if (!m_port->isReadable()) return;
+
+    qint64 size = m_port->bytesAvailable();
+    if (size <= 0) return;
+
+    size = m_port->read(this->receiveBuffer(size), size);
+    if (size > 0) this->receiveBufferedData(size);
 }
 
 void SerialLink::onError(int error)
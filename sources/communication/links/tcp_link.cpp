@@ -71,5 +71,12 @@ bool TcpLink::sendDataImpl(const QByteArray& data)
 
 void TcpLink::onReadyRead()
 {
-    while (m_socket->bytesAvailable()) this->receiveData(m_socket->readAll());
+    qint64 size = 0;
+    while ((size = m_socket->bytesAvailable()) > 0)
+    {
+        size = m_socket->read(this->receiveBuffer(size), size);
+        if (size <= 0) break;
+
+        this->receiveBufferedData(size);
+    }
 }
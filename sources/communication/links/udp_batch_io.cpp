@@ -0,0 +1,422 @@
+#include "udp_batch_io.h"
+
+// Qt
+#include <QVector>
+#include <QQueue>
+#include <QSocketNotifier>
+
+#ifdef Q_OS_LINUX
+// Std
+#include <cerrno>
+#include <cstring>
+
+// Linux
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+
+namespace
+{
+    const int batchSize = 16;
+    const int slotSize = 2048; // Ethernet MTU with margin, MAVLink datagrams are not larger
+    const int maxPayload = 65536; // UDP payload can't be larger
+    const int overflowSize = maxPayload - slotSize;
+    const int maxQueued = 256; // datagrams, waiting for the full send buffer
+}
+
+using namespace comm;
+
+#ifdef Q_OS_LINUX
+
+class UdpBatchIo::Impl
+{
+public:
+    int socket = -1;
+    int family = AF_UNSPEC;
+
+    // Datagram goes to its slot, the tail of the rare larger one goes to the overflow,
+    // which is never handed out, so held slots don't pin more than the MTU
+    QVector<QByteArray> rxSlots;
+    QByteArray rxOverflow;
+    QVector<mmsghdr> rxHeaders;
+    QVector<iovec> rxVectors;
+    QVector<sockaddr_storage> rxAddresses;
+
+    // Rest of the batch, which didn't fit the send buffer, goes on the write notification
+    struct QueuedSend
+    {
+        QByteArray data;
+        int index; // first endpoint, not sent yet
+    };
+
+    QVector<mmsghdr> txHeaders;
+    QVector<sockaddr_storage> txAddresses;
+    QQueue<QueuedSend> txQueue;
+    QScopedPointer<QSocketNotifier> txNotifier;
+    bool txValid = false;
+    EndpointList endpoints;
+
+    void prepareReceive()
+    {
+        if (!rxHeaders.isEmpty()) return;
+
+        rxSlots.resize(::batchSize);
+        rxOverflow.resize(::batchSize * ::overflowSize);
+        rxHeaders.resize(::batchSize);
+        rxVectors.resize(::batchSize * 2);
+        rxAddresses.resize(::batchSize);
+    }
+
+    bool toNative(const Endpoint& endpoint, sockaddr_storage& storage, socklen_t& length) const
+    {
+        std::memset(&storage, 0, sizeof(storage));
+
+        bool ipv4 = false;
+        quint32 address4 = endpoint.address().toIPv4Address(&ipv4);
+
+        if (family == AF_INET)
+        {
+            if (!ipv4) return false;
+
+            sockaddr_in* address = reinterpret_cast<sockaddr_in*>(&storage);
+            address->sin_family = AF_INET;
+            address->sin_port = htons(endpoint.port());
+            address->sin_addr.s_addr = htonl(address4);
+            length = sizeof(sockaddr_in);
+            return true;
+        }
+
+        if (family == AF_INET6)
+        {
+            sockaddr_in6* address = reinterpret_cast<sockaddr_in6*>(&storage);
+            address->sin6_family = AF_INET6;
+            address->sin6_port = htons(endpoint.port());
+
+            if (ipv4) // IPv4 mapped address for dual-stack socket
+            {
+                address->sin6_addr.s6_addr[10] = 0xff;
+                address->sin6_addr.s6_addr[11] = 0xff;
+                quint32 network = htonl(address4);
+                std::memcpy(&address->sin6_addr.s6_addr[12], &network, sizeof(network));
+            }
+            else
+            {
+                Q_IPV6ADDR address6 = endpoint.address().toIPv6Address();
+                std::memcpy(&address->sin6_addr, &address6, sizeof(address6));
+            }
+
+            length = sizeof(sockaddr_in6);
+            return true;
+        }
+
+        return false;
+    }
+
+    void prepareSend()
+    {
+        // Queued datagrams are addressed by the endpoint index, so they are dropped
+        txQueue.clear();
+        if (txNotifier) txNotifier->setEnabled(false);
+
+        txValid = socket >= 0;
+        txHeaders.resize(endpoints.count());
+        txAddresses.resize(endpoints.count());
+
+        for (int i = 0; i < endpoints.count() && txValid; ++i)
+        {
+            socklen_t length = 0;
+            txValid = this->toNative(endpoints.at(i), txAddresses[i], length);
+
+            std::memset(&txHeaders[i], 0, sizeof(mmsghdr));
+            txHeaders[i].msg_hdr.msg_name = &txAddresses[i];
+            txHeaders[i].msg_hdr.msg_namelen = length;
+        }
+    }
+
+    // Sends data to endpoints from index on, stops at the full send buffer
+    int sendFrom(const QByteArray& data, int& index)
+    {
+        iovec vector;
+        vector.iov_base = const_cast<char*>(data.constData());
+        vector.iov_len = data.size();
+
+        for (mmsghdr& header: txHeaders)
+        {
+            header.msg_hdr.msg_iov = &vector;
+            header.msg_hdr.msg_iovlen = 1;
+        }
+
+        int sent = 0;
+        while (index < txHeaders.count())
+        {
+            int count = ::sendmmsg(socket, txHeaders.data() + index, txHeaders.count() - index, 0);
+            if (count < 0)
+            {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+                // Hard error of the endpoint, skip it like writeDatagram loop does
+                index++;
+                continue;
+            }
+
+            index += count;
+            sent += count;
+        }
+
+        return sent;
+    }
+
+    void enqueue(const QByteArray& data, int index)
+    {
+        txQueue.enqueue({ data, index });
+        if (txNotifier) txNotifier->setEnabled(true);
+    }
+
+    void sendQueued()
+    {
+        while (!txQueue.isEmpty())
+        {
+            QueuedSend& queued = txQueue.head();
+            this->sendFrom(queued.data, queued.index);
+            if (queued.index < txHeaders.count()) return;
+
+            txQueue.dequeue();
+        }
+
+        txNotifier->setEnabled(false);
+    }
+};
+
+UdpBatchIo::UdpBatchIo():
+    d(new Impl())
+{}
+
+UdpBatchIo::~UdpBatchIo()
+{}
+
+bool UdpBatchIo::isSupported()
+{
+    return true;
+}
+
+void UdpBatchIo::setSocket(qintptr socket)
+{
+    d->socket = socket;
+    d->family = AF_UNSPEC;
+    d->txNotifier.reset();
+
+    if (socket >= 0)
+    {
+        sockaddr_storage address;
+        socklen_t length = sizeof(address);
+        if (::getsockname(socket, reinterpret_cast<sockaddr*>(&address), &length) == 0)
+        {
+            d->family = address.ss_family;
+        }
+
+        d->txNotifier.reset(new QSocketNotifier(socket, QSocketNotifier::Write));
+        d->txNotifier->setEnabled(false);
+        QObject::connect(d->txNotifier.data(), &QSocketNotifier::activated,
+                         d->txNotifier.data(), [this]() { d->sendQueued(); });
+    }
+
+    d->prepareSend();
+}
+
+void UdpBatchIo::setEndpoints(const EndpointList& endpoints)
+{
+    d->endpoints = endpoints;
+    d->prepareSend();
+}
+
+int UdpBatchIo::receive()
+{
+    if (d->socket < 0) return -1;
+
+    d->prepareReceive();
+
+    for (int i = 0; i < ::batchSize; ++i)
+    {
+        // Slot, held by a receiver, is left to it, so its data is not copied on detach
+        QByteArray& slot = d->rxSlots[i];
+        if (!slot.isDetached()) slot = QByteArray();
+        if (slot.capacity() < ::slotSize) slot.reserve(::slotSize);
+        slot.resize(::slotSize);
+
+        iovec* vectors = &d->rxVectors[i * 2];
+        vectors[0].iov_base = slot.data();
+        vectors[0].iov_len = ::slotSize;
+        vectors[1].iov_base = d->rxOverflow.data() + i * ::overflowSize;
+        vectors[1].iov_len = ::overflowSize;
+
+        std::memset(&d->rxHeaders[i], 0, sizeof(mmsghdr));
+        d->rxHeaders[i].msg_hdr.msg_iov = vectors;
+        d->rxHeaders[i].msg_hdr.msg_iovlen = 2;
+        d->rxHeaders[i].msg_hdr.msg_name = &d->rxAddresses[i];
+        d->rxHeaders[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+
+    int count = 0;
+    do
+    {
+        count = ::recvmmsg(d->socket, d->rxHeaders.data(), ::batchSize, MSG_DONTWAIT, nullptr);
+    }
+    while (count < 0 && errno == EINTR);
+
+    if (count < 0) return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+
+    // Reserved capacity survives shrinking, so the next receive doesn't reallocate
+    for (int i = 0; i < count; ++i)
+    {
+        int length = d->rxHeaders[i].msg_len;
+        if (length <= ::slotSize)
+        {
+            d->rxSlots[i].resize(length);
+            continue;
+        }
+
+        // Larger datagram gets its own exact copy, the slot keeps the MTU size
+        QByteArray datagram(length, Qt::Uninitialized);
+        std::memcpy(datagram.data(), d->rxSlots[i].constData(), ::slotSize);
+        std::memcpy(datagram.data() + ::slotSize, d->rxOverflow.constData() + i * ::overflowSize,
+                    length - ::slotSize);
+        d->rxSlots[i] = datagram;
+    }
+
+    return count;
+}
+
+int UdpBatchIo::batchSize() const
+{
+    return ::batchSize;
+}
+
+QByteArray UdpBatchIo::datagram(int index) const
+{
+    return d->rxSlots.at(index);
+}
+
+Endpoint UdpBatchIo::sender(int index) const
+{
+    const sockaddr_storage& storage = d->rxAddresses.at(index);
+
+    if (storage.ss_family == AF_INET)
+    {
+        const sockaddr_in* address = reinterpret_cast<const sockaddr_in*>(&storage);
+        return Endpoint(QHostAddress(ntohl(address->sin_addr.s_addr)), ntohs(address->sin_port));
+    }
+
+    if (storage.ss_family == AF_INET6)
+    {
+        // Same conversion as Qt does for it's own datagram sender
+        const sockaddr_in6* address = reinterpret_cast<const sockaddr_in6*>(&storage);
+        Q_IPV6ADDR address6;
+        std::memcpy(&address6, &address->sin6_addr, sizeof(address6));
+
+        QHostAddress hostAddress;
+        hostAddress.setAddress(address6);
+        if (address->sin6_scope_id) hostAddress.setScopeId(QString::number(address->sin6_scope_id));
+
+        return Endpoint(hostAddress, ntohs(address->sin6_port));
+    }
+
+    return Endpoint();
+}
+
+bool UdpBatchIo::isSameSender(int index, int other) const
+{
+    const mmsghdr& first = d->rxHeaders.at(index);
+    const mmsghdr& second = d->rxHeaders.at(other);
+
+    return first.msg_hdr.msg_namelen == second.msg_hdr.msg_namelen &&
+            std::memcmp(first.msg_hdr.msg_name, second.msg_hdr.msg_name,
+                        first.msg_hdr.msg_namelen) == 0;
+}
+
+int UdpBatchIo::send(const QByteArray& data)
+{
+    if (!d->txValid) return -1;
+
+    // Datagrams are sent in order, so new one waits behind the queued ones
+    if (!d->txQueue.isEmpty())
+    {
+        if (d->txQueue.count() >= ::maxQueued) return 0;
+
+        d->enqueue(data, 0);
+        return d->txHeaders.count();
+    }
+
+    int index = 0;
+    int sent = d->sendFrom(data, index);
+    if (index == d->txHeaders.count()) return sent;
+
+    // Send buffer is full, the rest goes as soon as it drains
+    d->enqueue(data, index);
+    return sent + d->txHeaders.count() - index;
+}
+
+#else
+
+class UdpBatchIo::Impl
+{};
+
+UdpBatchIo::UdpBatchIo():
+    d(new Impl())
+{}
+
+UdpBatchIo::~UdpBatchIo()
+{}
+
+bool UdpBatchIo::isSupported()
+{
+    return false;
+}
+
+void UdpBatchIo::setSocket(qintptr socket)
+{
+    Q_UNUSED(socket)
+}
+
+void UdpBatchIo::setEndpoints(const EndpointList& endpoints)
+{
+    Q_UNUSED(endpoints)
+}
+
+int UdpBatchIo::receive()
+{
+    return -1;
+}
+
+int UdpBatchIo::batchSize() const
+{
+    return 0;
+}
+
+QByteArray UdpBatchIo::datagram(int index) const
+{
+    Q_UNUSED(index)
+    return QByteArray();
+}
+
+Endpoint UdpBatchIo::sender(int index) const
+{
+    Q_UNUSED(index)
+    return Endpoint();
+}
+
+bool UdpBatchIo::isSameSender(int index, int other) const
+{
+    Q_UNUSED(index)
+    Q_UNUSED(other)
+    return false;
+}
+
+int UdpBatchIo::send(const QByteArray& data)
+{
+    Q_UNUSED(data)
+    return -1;
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef UDP_BATCH_IO_H
+#define UDP_BATCH_IO_H
+
+// Qt
+#include <QScopedPointer>
+#include <QByteArray>
+
+// Internal
+#include "endpoint.h"
+
+namespace comm
+{
+    // Batched datagram I/O over native socket descriptor (recvmmsg/sendmmsg), Linux only
+    class UdpBatchIo
+    {
+    public:
+        UdpBatchIo();
+        ~UdpBatchIo();
+
+        static bool isSupported();
+
+        void setSocket(qintptr socket);
+        void setEndpoints(const EndpointList& endpoints);
+
+        // Receives up to batch size pending datagrams without blocking, -1 on error
+        int receive();
+        int batchSize() const;
+
+        // Datagram shares the slot memory. Slots, still held by receivers on the next receive,
+        // are replaced, so datagrams up to the MTU are never copied.
+        QByteArray datagram(int index) const;
+        Endpoint sender(int index) const;
+        bool isSameSender(int index, int other) const;
+
+        // Sends data to every endpoint with one call, the rest is queued if the send buffer is
+        // full and goes on the socket write notification. Returns sent and queued datagrams,
+        // -1 if batch sending is not possible.
+        int send(const QByteArray& data);
+
+    private:
+        class Impl;
+        QScopedPointer<Impl> const d;
+    };
+}
+
+#endif // UDP_BATCH_IO_H
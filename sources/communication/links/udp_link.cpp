@@ -3,6 +3,9 @@
 // Qt
 #include <QUdpSocket>
 
+// Internal
+#include "udp_batch_io.h"
+
 using namespace comm;
 
 UdpLink::UdpLink(quint16 port, QObject* parent):
@@ -16,8 +19,13 @@ UdpLink::UdpLink(quint16 port, QObject* parent):
     connect(m_socket, static_cast<void (QUdpSocket::*)
             (QUdpSocket::SocketError)>(&QUdpSocket::error),
             this, &AbstractLink::onSocketError);
+
+    if (UdpBatchIo::isSupported()) m_batchIo.reset(new UdpBatchIo());
 }
 
+UdpLink::~UdpLink()
+{}
+
 bool UdpLink::isConnected() const
 {
     return m_socket->state() == QAbstractSocket::BoundState;
@@ -58,6 +66,7 @@ void UdpLink::connectLink()
     }
     else
     {
+        if (m_batchIo) m_batchIo->setSocket(m_socket->socketDescriptor());
         emit connectedChanged(true);
     }
 }
@@ -66,6 +75,7 @@ void UdpLink::disconnectLink()
 {
     if (!this->isConnected()) return;
 
+    if (m_batchIo) m_batchIo->setSocket(-1);
     m_socket->close();
     emit connectedChanged(false);
 }
@@ -88,18 +98,21 @@ void UdpLink::setPort(quint16 port)
 void UdpLink::addEndpoint(const Endpoint& endpoint)
 {
     m_endpoints.append(endpoint);
+    if (m_batchIo) m_batchIo->setEndpoints(m_endpoints);
     emit endpointsChanged(m_endpoints);
 }
 
 void UdpLink::removeEndpoint(const Endpoint& endpoint)
 {
     m_endpoints.removeOne(endpoint);
+    if (m_batchIo) m_batchIo->setEndpoints(m_endpoints);
     emit endpointsChanged(m_endpoints);
 }
 
 void UdpLink::clearEndpoints()
 {
     m_endpoints.clear();
+    if (m_batchIo) m_batchIo->setEndpoints(m_endpoints);
     emit endpointsChanged(m_endpoints);
 }
 
@@ -113,6 +126,13 @@ void UdpLink::setAutoResponse(bool autoResponse)
 
 bool UdpLink::sendDataImpl(const QByteArray& data)
 {
+    // Fan out to all endpoints with one syscall when possible
+    if (m_batchIo)
+    {
+        int sent = m_batchIo->send(data);
+        if (sent >= 0) return sent > 0;
+    }
+
     bool ok = false;
     for (const Endpoint& endpoint: m_endpoints)
     {
@@ -125,19 +145,52 @@ void UdpLink::onReadyRead()
 {
     while (m_socket->hasPendingDatagrams())
     {
-        QByteArray datagram;
-        datagram.resize(m_socket->pendingDatagramSize());
+        qint64 size = m_socket->pendingDatagramSize();
+        if (size < 0) break;
 
-        QHostAddress address;
-        quint16 port;
-        m_socket->readDatagram(datagram.data(), datagram.size(), &address, &port);
+        char* buffer = this->receiveBuffer(size);
 
-        Endpoint endpoint(address, port);
-        if (m_autoResponse && !m_endpoints.contains(endpoint))
+        if (m_autoResponse)
         {
-            this->addEndpoint(endpoint);
+            QHostAddress address;
+            quint16 port;
+            size = m_socket->readDatagram(buffer, size, &address, &port);
+
+            Endpoint endpoint(address, port);
+            if (size >= 0 && !m_endpoints.contains(endpoint)) this->addEndpoint(endpoint);
         }
+        else
+        {
+            // Sender is not needed, read without sender address allocation
+            size = m_socket->readDatagram(buffer, size);
+        }
+
+        if (size < 0) break;
 
-        this->receiveData(datagram);
+        this->receiveBufferedData(size);
+
+        // Qt read above rearms socket notifier, the rest of queue is drained in batches
+        if (m_batchIo) this->readDatagramBatches();
+    }
+}
+
+void UdpLink::readDatagramBatches()
+{
+    int count = 0;
+    do
+    {
+        count = m_batchIo->receive();
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (m_autoResponse && (i == 0 || !m_batchIo->isSameSender(i, i - 1)))
+            {
+                Endpoint endpoint = m_batchIo->sender(i);
+                if (!m_endpoints.contains(endpoint)) this->addEndpoint(endpoint);
+            }
+
+            this->receiveData(m_batchIo->datagram(i));
+        }
     }
+    while (count == m_batchIo->batchSize() && this->isConnected());
 }
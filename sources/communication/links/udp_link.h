@@ -1,6 +1,9 @@
 #ifndef UDP_LINK_H
 #define UDP_LINK_H
 
+// Qt
+#include <QScopedPointer>
+
 // Internal
 #include "abstract_link.h"
 #include "endpoint.h"
@@ -9,12 +12,15 @@ class QUdpSocket;
 
 namespace comm
 {
+    class UdpBatchIo;
+
     class UdpLink: public AbstractLink
     {
         Q_OBJECT
 
     public:
         UdpLink(quint16 port = 0, QObject* parent = nullptr);
+        ~UdpLink() override;
 
         bool isConnected() const override;
 
@@ -47,7 +53,10 @@ namespace comm
         void onReadyRead();
 
     private:
+        void readDatagramBatches();
+
         QUdpSocket* m_socket;
+        QScopedPointer<UdpBatchIo> m_batchIo;
         quint16 m_port;
         EndpointList m_endpoints;
         bool m_autoResponse;
@@ -0,0 +1,24 @@
+#include "tlog_format.h"
+
+// MAVLink
+#include <mavlink_types.h>
+
+using namespace comm;
+
+int tlog::frameLength(const quint8* data, qint64 available)
+{
+    if (available < 3) return 0;
+
+    switch (data[0])
+    {
+    case 0xFE: // MAVLink 1
+        return MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + data[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+#ifdef MAVLINK_V2
+    case MAVLINK_STX:
+        return MAVLINK_NUM_HEADER_BYTES + data[1] + MAVLINK_NUM_CHECKSUM_BYTES +
+                (data[2] & MAVLINK_IFLAG_SIGNED ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+#endif
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef TLOG_FORMAT_H
+#define TLOG_FORMAT_H
+
+// Qt
+#include <QString>
+
+// Tlog is a sequence of records: big-endian microseconds since epoch and a raw MAVLink frame.
+// Sparse index is kept aside in "<tlog>.idx": header and pairs of time and record offset.
+namespace comm
+{
+    namespace tlog
+    {
+        const int timestampSize = sizeof(quint64);
+
+        const char indexMagic[4] = { 'T', 'L', 'I', 'X' };
+        const quint32 indexVersion = 1;
+        const int indexHeaderSize = sizeof(indexMagic) + sizeof(indexVersion);
+
+        const quint64 defaultIndexInterval = 1000000; // one index entry per second
+
+        struct IndexEntry
+        {
+            quint64 time;
+            quint64 offset;
+        };
+
+        inline QString indexFileName(const QString& fileName)
+        {
+            return fileName + ".idx";
+        }
+
+        // Length of MAVLink frame at data or zero if there is no frame start
+        int frameLength(const quint8* data, qint64 available);
+    }
+}
+
+#endif // TLOG_FORMAT_H
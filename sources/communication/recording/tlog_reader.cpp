@@ -0,0 +1,200 @@
+#include "tlog_reader.h"
+
+// Qt
+#include <QtEndian>
+#include <QDebug>
+
+// Std
+#include <algorithm>
+
+using namespace comm;
+
+TlogReader::TlogReader(const QString& fileName):
+    m_file(fileName)
+{}
+
+TlogReader::~TlogReader()
+{
+    this->close();
+}
+
+bool TlogReader::open()
+{
+    this->close();
+
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+
+    m_size = m_file.size();
+    m_data = m_size ? m_file.map(0, m_size) : nullptr;
+    if (m_size && !m_data)
+    {
+        qWarning() << "Can't map tlog" << m_file.fileName();
+        m_file.close();
+        return false;
+    }
+
+    if (!this->readIndex()) this->buildIndex();
+
+    // Tail after the last index entry is short, scan it for the end time
+    m_endTime = m_index.isEmpty() ? 0 : m_index.last().time;
+    m_position = m_index.isEmpty() ? 0 : m_index.last().offset;
+
+    quint64 time;
+    const char* frame;
+    int size;
+    while (this->next(&time, &frame, &size)) m_endTime = time;
+
+    this->rewind();
+    return true;
+}
+
+void TlogReader::close()
+{
+    if (!m_file.isOpen()) return;
+
+    if (m_data) m_file.unmap(const_cast<uchar*>(m_data));
+    m_file.close();
+
+    m_data = nullptr;
+    m_size = 0;
+    m_position = 0;
+    m_endTime = 0;
+    m_index.clear();
+}
+
+bool TlogReader::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+QString TlogReader::fileName() const
+{
+    return m_file.fileName();
+}
+
+qint64 TlogReader::size() const
+{
+    return m_size;
+}
+
+qint64 TlogReader::position() const
+{
+    return m_position;
+}
+
+quint64 TlogReader::startTime() const
+{
+    return m_index.isEmpty() ? 0 : m_index.first().time;
+}
+
+quint64 TlogReader::endTime() const
+{
+    return m_endTime;
+}
+
+void TlogReader::seek(quint64 timeUsec)
+{
+    // Last index entry not later than time, records are scanned from it
+    auto it = std::upper_bound(m_index.constBegin(), m_index.constEnd(), timeUsec,
+                               [](quint64 time, const tlog::IndexEntry& entry) {
+        return time < entry.time;
+    });
+    m_position = it == m_index.constBegin() ? 0 : (it - 1)->offset;
+
+    quint64 time;
+    int frameSize;
+    while (this->recordAt(m_position, &time, &frameSize) && time < timeUsec)
+    {
+        m_position += tlog::timestampSize + frameSize;
+    }
+}
+
+void TlogReader::rewind()
+{
+    m_position = 0;
+}
+
+bool TlogReader::next(quint64* timeUsec, const char** frame, int* size)
+{
+    while (m_position < m_size)
+    {
+        if (this->recordAt(m_position, timeUsec, size))
+        {
+            *frame = reinterpret_cast<const char*>(m_data + m_position + tlog::timestampSize);
+            m_position += tlog::timestampSize + *size;
+            return true;
+        }
+
+        m_position++; // broken record, resync byte by byte
+    }
+
+    return false;
+}
+
+bool TlogReader::readIndex()
+{
+    QFile indexFile(tlog::indexFileName(m_file.fileName()));
+    if (!indexFile.open(QIODevice::ReadOnly)) return false;
+
+    QByteArray data = indexFile.readAll();
+    if (data.size() < tlog::indexHeaderSize ||
+        !data.startsWith(QByteArray(tlog::indexMagic, sizeof(tlog::indexMagic))) ||
+        qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(data.constData()) +
+                                   sizeof(tlog::indexMagic)) != tlog::indexVersion)
+    {
+        return false;
+    }
+
+    int count = (data.size() - tlog::indexHeaderSize) / int(sizeof(tlog::IndexEntry));
+    const uchar* entries = reinterpret_cast<const uchar*>(data.constData()) +
+                           tlog::indexHeaderSize;
+
+    m_index.clear();
+    m_index.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const uchar* entry = entries + i * sizeof(tlog::IndexEntry);
+        tlog::IndexEntry indexEntry = { qFromLittleEndian<quint64>(entry),
+                                        qFromLittleEndian<quint64>(entry + sizeof(quint64)) };
+
+        // Index may be longer than the log, if the log was cut
+        if (qint64(indexEntry.offset) >= m_size) break;
+        m_index.append(indexEntry);
+    }
+
+    return true;
+}
+
+void TlogReader::buildIndex()
+{
+    m_index.clear();
+    m_position = 0;
+
+    quint64 time;
+    const char* frame;
+    int size;
+    qint64 offset = m_position;
+
+    while (this->next(&time, &frame, &size))
+    {
+        offset = m_position - tlog::timestampSize - size;
+
+        if (m_index.isEmpty() || time - m_index.last().time >= tlog::defaultIndexInterval)
+        {
+            m_index.append({ time, quint64(offset) });
+        }
+    }
+}
+
+bool TlogReader::recordAt(qint64 offset, quint64* timeUsec, int* frameSize) const
+{
+    qint64 available = m_size - offset - tlog::timestampSize;
+    if (available <= 0) return false;
+
+    int length = tlog::frameLength(m_data + offset + tlog::timestampSize, available);
+    if (!length || length > available) return false;
+
+    *timeUsec = qFromBigEndian<quint64>(m_data + offset);
+    *frameSize = length;
+    return true;
+}
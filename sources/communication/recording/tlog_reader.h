@@ -0,0 +1,53 @@
+#ifndef TLOG_READER_H
+#define TLOG_READER_H
+
+// Qt
+#include <QFile>
+#include <QVector>
+
+// Internal
+#include "tlog_format.h"
+
+namespace comm
+{
+    // Reads tlog through memory mapping, seeks by the sparse index. Index is rebuilt in memory
+    // if index file is missing, e.g. for logs of other ground stations.
+    class TlogReader
+    {
+    public:
+        explicit TlogReader(const QString& fileName);
+        ~TlogReader();
+
+        bool open();
+        void close();
+        bool isOpen() const;
+
+        QString fileName() const;
+        qint64 size() const;
+        qint64 position() const;
+
+        quint64 startTime() const;
+        quint64 endTime() const;
+
+        // Moves to the first record not earlier than time
+        void seek(quint64 timeUsec);
+        void rewind();
+
+        // Frame points to the mapped file and stays valid until close
+        bool next(quint64* timeUsec, const char** frame, int* size);
+
+    private:
+        bool readIndex();
+        void buildIndex();
+        bool recordAt(qint64 offset, quint64* timeUsec, int* frameSize) const;
+
+        QFile m_file;
+        const uchar* m_data = nullptr;
+        qint64 m_size = 0;
+        qint64 m_position = 0;
+        quint64 m_endTime = 0;
+        QVector<tlog::IndexEntry> m_index;
+    };
+}
+
+#endif // TLOG_READER_H
@@ -0,0 +1,269 @@
+#include "tlog_recorder.h"
+
+// MAVLink
+#include <mavlink.h>
+#include <mavlink_helpers.h>
+
+// Qt
+#include <QThread>
+#include <QMutex>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+#include <QDateTime>
+#include <QtEndian>
+#include <QDebug>
+
+// Internal
+#include "tlog_format.h"
+
+namespace
+{
+    const int flushInterval = 100; // ms
+    const int maxBufferSize = 16 * 1024 * 1024;
+    const int reservedBufferSize = 256 * 1024;
+
+    // Records, not written yet, recording threads append them under the mutex
+    class TlogBuffer
+    {
+    public:
+        QMutex mutex;
+        bool recording = false;
+        QByteArray data;
+        QVector<comm::tlog::IndexEntry> index;
+        quint64 offset = 0;
+        quint64 lastIndexTime = 0;
+    };
+
+    // Lives in the writer thread, takes the buffer on timer and writes it out
+    class TlogWriter: public QObject
+    {
+    public:
+        TlogWriter(TlogBuffer* buffer, const QString& fileName):
+            m_buffer(buffer),
+            m_file(fileName),
+            m_indexFile(comm::tlog::indexFileName(fileName))
+        {}
+
+        bool open()
+        {
+            if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+                !m_indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+            m_indexFile.write(comm::tlog::indexMagic, sizeof(comm::tlog::indexMagic));
+            quint32 version = qToLittleEndian(comm::tlog::indexVersion);
+            m_indexFile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+
+            m_data.reserve(::reservedBufferSize);
+            return true;
+        }
+
+        QString fileName() const
+        {
+            return m_file.fileName();
+        }
+
+        void startTimer()
+        {
+            m_timer = new QTimer(this);
+            QObject::connect(m_timer, &QTimer::timeout, this, [this]() { this->flush(); });
+            m_timer->start(::flushInterval);
+        }
+
+        // Called in the writer thread when it is finishing
+        void close()
+        {
+            delete m_timer;
+            m_timer = nullptr;
+
+            this->flush();
+            m_file.close();
+            m_indexFile.close();
+        }
+
+        void flush()
+        {
+            {
+                QMutexLocker locker(&m_buffer->mutex);
+                m_buffer->data.swap(m_data);
+                m_buffer->index.swap(m_index);
+            }
+
+            if (!m_data.isEmpty() && m_file.write(m_data) != m_data.size())
+            {
+                qWarning() << "Tlog write error" << m_file.errorString();
+            }
+            m_data.resize(0); // reserved capacity goes back to the buffer with the next swap
+
+            for (const comm::tlog::IndexEntry& entry: m_index)
+            {
+                comm::tlog::IndexEntry data = { qToLittleEndian(entry.time),
+                                                qToLittleEndian(entry.offset) };
+                m_indexFile.write(reinterpret_cast<const char*>(&data), sizeof(data));
+            }
+            m_index.clear();
+
+            m_file.flush();
+            m_indexFile.flush();
+        }
+
+    private:
+        TlogBuffer* const m_buffer;
+        QFile m_file;
+        QFile m_indexFile;
+        QByteArray m_data;
+        QVector<comm::tlog::IndexEntry> m_index;
+        QTimer* m_timer = nullptr;
+    };
+}
+
+using namespace comm;
+
+class TlogRecorder::Impl
+{
+public:
+    TlogBuffer buffer;
+    QThread thread;
+    TlogWriter* writer = nullptr;
+
+    QAtomicInt recording;
+    QAtomicInteger<quint64> recordedFrames;
+    QAtomicInteger<quint64> droppedFrames;
+};
+
+TlogRecorder::TlogRecorder(QObject* parent):
+    QObject(parent),
+    d(new Impl())
+{
+    d->thread.setObjectName("Tlog writer thread");
+}
+
+TlogRecorder::~TlogRecorder()
+{
+    this->stop();
+}
+
+bool TlogRecorder::isRecording() const
+{
+    return d->recording.load();
+}
+
+QString TlogRecorder::fileName() const
+{
+    return d->writer ? d->writer->fileName() : QString();
+}
+
+quint64 TlogRecorder::recordedFrames() const
+{
+    return d->recordedFrames.load();
+}
+
+quint64 TlogRecorder::droppedFrames() const
+{
+    return d->droppedFrames.load();
+}
+
+void TlogRecorder::record(const mavlink_message_t& message)
+{
+    if (!d->recording.load()) return;
+
+    quint8 frame[MAVLINK_MAX_PACKET_LEN];
+    int size = mavlink_msg_to_send_buffer(frame, &message);
+    if (!size) return;
+
+    this->record(QDateTime::currentMSecsSinceEpoch() * 1000,
+                 reinterpret_cast<const char*>(frame), size);
+}
+
+void TlogRecorder::record(quint64 timeUsec, const char* frame, int size)
+{
+    if (!d->recording.load()) return;
+
+    TlogBuffer& buffer = d->buffer;
+    QMutexLocker locker(&buffer.mutex);
+
+    if (!buffer.recording) return;
+
+    if (buffer.data.size() + tlog::timestampSize + size > ::maxBufferSize)
+    {
+        d->droppedFrames.fetchAndAddRelaxed(1);
+        return;
+    }
+
+    // Wall clock can step back, index times are clamped to keep the seek working
+    quint64 indexTime = qMax(timeUsec, buffer.lastIndexTime);
+    if (buffer.index.isEmpty() && buffer.offset == 0)
+    {
+        buffer.index.append({ timeUsec, 0 });
+        buffer.lastIndexTime = timeUsec;
+    }
+    else if (indexTime - buffer.lastIndexTime >= tlog::defaultIndexInterval)
+    {
+        buffer.index.append({ indexTime, buffer.offset });
+        buffer.lastIndexTime = indexTime;
+    }
+
+    quint64 timestamp = qToBigEndian(timeUsec);
+    buffer.data.append(reinterpret_cast<const char*>(&timestamp), tlog::timestampSize);
+    buffer.data.append(frame, size);
+    buffer.offset += tlog::timestampSize + size;
+
+    d->recordedFrames.fetchAndAddRelaxed(1);
+}
+
+bool TlogRecorder::start(const QString& fileName)
+{
+    this->stop();
+
+    TlogWriter* writer = new TlogWriter(&d->buffer, fileName);
+    if (!writer->open())
+    {
+        qWarning() << "Can't open tlog" << fileName;
+        delete writer;
+        return false;
+    }
+
+    writer->moveToThread(&d->thread);
+    connect(&d->thread, &QThread::started, writer, [writer]() { writer->startTimer(); });
+    connect(&d->thread, &QThread::finished, writer, [writer]() { writer->close(); },
+            Qt::DirectConnection);
+
+    {
+        QMutexLocker locker(&d->buffer.mutex);
+        d->buffer.data.clear();
+        d->buffer.data.reserve(::reservedBufferSize);
+        d->buffer.index.clear();
+        d->buffer.offset = 0;
+        d->buffer.lastIndexTime = 0;
+        d->buffer.recording = true;
+    }
+
+    d->writer = writer;
+    d->recordedFrames.store(0);
+    d->droppedFrames.store(0);
+    d->recording.store(1);
+    d->thread.start();
+
+    emit recordingChanged(true);
+    return true;
+}
+
+void TlogRecorder::stop()
+{
+    if (!d->writer) return;
+
+    d->recording.store(0);
+    {
+        QMutexLocker locker(&d->buffer.mutex);
+        d->buffer.recording = false;
+    }
+
+    // Writer flushes the rest of the buffer on thread finishing
+    d->thread.quit();
+    d->thread.wait();
+
+    delete d->writer;
+    d->writer = nullptr;
+
+    emit recordingChanged(false);
+}
@@ -0,0 +1,45 @@
+#ifndef TLOG_RECORDER_H
+#define TLOG_RECORDER_H
+
+// Qt
+#include <QObject>
+
+// MAVLink
+#include <mavlink_types.h>
+
+namespace comm
+{
+    // Appends received frames to a tlog file. Frames are copied to a memory buffer by the
+    // recording thread and written out by a dedicated writer thread together with the index.
+    class TlogRecorder: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit TlogRecorder(QObject* parent = nullptr);
+        ~TlogRecorder() override;
+
+        bool isRecording() const;
+        QString fileName() const;
+
+        quint64 recordedFrames() const;
+        quint64 droppedFrames() const; // writer could not keep up with the stream
+
+        // Thread safe, cheap enough for the communication thread
+        void record(const mavlink_message_t& message);
+        void record(quint64 timeUsec, const char* frame, int size);
+
+    public slots:
+        bool start(const QString& fileName);
+        void stop();
+
+    signals:
+        void recordingChanged(bool recording);
+
+    private:
+        class Impl;
+        QScopedPointer<Impl> const d;
+    };
+}
+
+#endif // TLOG_RECORDER_H
@@ -3,8 +3,16 @@
 
 // Qt
 #include <QSqlQuery>
+#include <QSqlError>
+#include <QMetaProperty>
+#include <QVector>
 #include <QHash>
 #include <QSharedPointer>
+#include <QPointer>
+#include <QMutex>
+
+// Internal
+#include "db_writer.h"
 
 namespace db
 {
@@ -21,27 +29,92 @@ namespace db
         bool remove(const QSharedPointer<T>& entity);
 
         bool save(const QSharedPointer<T>& entity);
+
+        // Bulk writes in one transaction, new entities are inserted with multi-row statements.
+        // Joins the outer transaction if there is one, otherwise rolls back all on error.
+        bool saveAll(const QList< QSharedPointer<T> >& entities);
+        bool removeAll(const QList< QSharedPointer<T> >& entities);
+
+        // Loaded entities are changed at once, rows are updated by DB writer later. Without
+        // the writer updates are synchronous. Reads see queued values through the overlay,
+        // only writes of the rows with queued updates and conditional selects wait for them.
+        void updateAsync(const QSharedPointer<T>& entity, QObject* context = nullptr,
+                         const DbWriter::Callback& callback = DbWriter::Callback());
+        void updateAllAsync(const QList< QSharedPointer<T> >& entities,
+                            QObject* context = nullptr,
+                            const DbWriter::Callback& callback = DbWriter::Callback());
+
         bool contains(int id);
         void unload(int id);
         void clear();
 
         QList<int> selectId(const QString& condition = QString());
 
+        // Reads every matching row in one pass, loaded entities are refreshed in place
+        QList< QSharedPointer<T> > loadAll(const QString& condition = QString());
+
         QList<int> loadedIds() const;
         QList< QSharedPointer<T> > loadedEntities() const;
 
     protected:
+        // Query is prepared once per connection and reused with positional binding
+        struct Statement
+        {
+            QString sql;
+            QSqlQuery query;
+            bool prepared = false;
+            quint64 connectionId = 0;
+        };
+
+        // Waits for queued updates of the table, or of the rows if ids are given
+        void flushWriter();
+        void flushWriter(const QList<int>& ids);
+        void applyPending(T* entity) const;
+
         bool runQuerry();
-        QStringList propertyNames(const QMetaObject& meta);
+        bool runStatement(Statement& statement, const QVariantList& values);
+        bool prepareStatement(Statement& statement);
+        void logError(const QSqlError& error, const QString& sql) const;
+
+        bool insertAll(const QList< QSharedPointer<T> >& entities);
+        QString insertSql(int rows) const;
 
-        void bindQuery(QSqlQuery& query, const QMetaObject& meta, T* entity);
-        void updateFromQuery(const QSqlQuery& query, const QMetaObject& meta, T* entity);
+        QVariantList values(const T* entity) const;
+        void updateFromQuery(const QSqlQuery& query, T* entity, int offset = 0);
+        void updateFromValues(const QVariantList& values, T* entity) const;
+        void writeProperty(int index, const QVariant& value, T* entity) const;
 
     private:
         QSqlQuery m_query;
         const QString m_tableName;
         QStringList m_columnNames;
+        QString m_selectSql; // Without condition
+        QVector<QMetaProperty> m_properties; // Properties, stored in columns
+
+        Statement m_insertStatement;
+        Statement m_updateStatement;
+        Statement m_readStatement;
+        Statement m_removeStatement;
+        Statement m_batchInsertStatement;
+        int m_batchSize;
+
         QHash<int, QSharedPointer<T> > m_map;
+
+        // Values of the queued updates, until the writer reports the last one of the row.
+        // Updates are queued and the writer reports on the different threads.
+        struct PendingWrite
+        {
+            quint64 sequence;
+            QVariantList values;
+        };
+        struct PendingWrites
+        {
+            QMutex mutex;
+            QHash<int, PendingWrite> writes;
+        };
+
+        QSharedPointer<PendingWrites> m_pending;
+        quint64 m_sequence = 0;
     };
 }
 
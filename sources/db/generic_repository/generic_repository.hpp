@@ -4,45 +4,77 @@
 #include "generic_repository.h"
 
 // Qt
-#include <QMetaProperty>
+#include <QSqlDatabase>
 #include <QSqlError>
 #include <QDebug>
 
+// Internal
+#include "db_manager.h"
+
+namespace db
+{
+    // SQLITE_MAX_VARIABLE_NUMBER of older SQLite builds
+    const int maxBoundValues = 999;
+
+    // SQLite result codes of the statement, which must be prepared again
+    const QString schemaChanged = "17"; // SQLITE_SCHEMA
+    const QString finalizedStatement = "21"; // SQLITE_MISUSE
+}
+
 using namespace db;
 
 template<class T>
 GenericRepository<T>::GenericRepository(const QString& tableName):
-    m_tableName(tableName)
+    m_tableName(tableName),
+    m_pending(QSharedPointer<PendingWrites>::create())
 {
+    m_query.setForwardOnly(true);
     m_query.exec("PRAGMA table_info(" + m_tableName + ")");
     while (m_query.next()) m_columnNames.append(m_query.value(1).toString());
-}
+    m_query.finish();
 
-template<class T>
-GenericRepository<T>::~GenericRepository()
-{}
-
-template<class T>
-bool GenericRepository<T>::insert(const QSharedPointer<T>& entity)
-{
+    // Column to property mapping is resolved once, queries use the same order
+    const QMetaObject& meta = T::staticMetaObject;
     QStringList names;
-    QStringList values;
+    QStringList placeholders;
+    QStringList assignments;
 
-    for (const QString& name: this->propertyNames(T::staticMetaObject))
+    for (int i = meta.propertyOffset(); i < meta.propertyCount(); ++i)
     {
+        QString name = meta.property(i).name();
         if (!m_columnNames.contains(name)) continue;
 
+        m_properties.append(meta.property(i));
         names.append(name);
-        values.append(":" + name);
+        placeholders.append("?");
+        assignments.append(name + " = ?");
     }
 
-    m_query.prepare("INSERT INTO " + m_tableName + " (" +
-                    names.join(", ") + ") VALUES (" + values.join(", ") + ")");
-    this->bindQuery(m_query, T::staticMetaObject, entity.data());
+    m_insertStatement.sql = "INSERT INTO " + m_tableName + " (" + names.join(", ") +
+                            ") VALUES (" + placeholders.join(", ") + ")";
+    m_updateStatement.sql = "UPDATE " + m_tableName + " SET " + assignments.join(", ") +
+                            " WHERE id = ?";
+    m_readStatement.sql = "SELECT " + (names.isEmpty() ? QString("id") : names.join(", ")) +
+                          " FROM " + m_tableName + " WHERE id = ?";
+    m_removeStatement.sql = "DELETE FROM " + m_tableName + " WHERE id = ?";
+    m_selectSql = "SELECT id" + (names.isEmpty() ? QString() : ", " + names.join(", ")) +
+                  " FROM " + m_tableName;
+
+    // Batch rows carry explicit ids besides the properties
+    m_batchSize = qMax(1, ::maxBoundValues / (m_properties.count() + 1));
+    m_batchInsertStatement.sql = this->insertSql(m_batchSize);
+}
+
+template<class T>
+GenericRepository<T>::~GenericRepository()
+{}
 
-    if (this->runQuerry())
+template<class T>
+bool GenericRepository<T>::insert(const QSharedPointer<T>& entity)
+{
+    if (this->runStatement(m_insertStatement, this->values(entity.data())))
     {
-        entity->setId(m_query.lastInsertId().toInt());
+        entity->setId(m_insertStatement.query.lastInsertId().toInt());
         m_map[entity->id()] = entity;
         return true;
     }
@@ -56,19 +88,21 @@ QSharedPointer<T> GenericRepository<T>::read(int id, bool reload)
 
     if (!contains || reload)
     {
-        m_query.prepare("SELECT * FROM " + m_tableName + " WHERE id = :id");
-        m_query.bindValue(":id", id);
+        QSqlQuery& query = m_readStatement.query;
 
-        if (this->runQuerry() && m_query.next())
+        QSharedPointer<T> entity;
+        if (this->runStatement(m_readStatement, { id }) && query.next())
         {
-            QSharedPointer<T> entity = contains ? m_map[id] :
-                                                  QSharedPointer<T>::create();
+            entity = contains ? m_map[id] : QSharedPointer<T>::create();
             entity->setId(id);
-            this->updateFromQuery(m_query, T::staticMetaObject, entity.data());
+            this->updateFromQuery(query, entity.data());
+            this->applyPending(entity.data());
             m_map[id] = entity;
-            return entity;
         }
-        return QSharedPointer<T>();
+
+        // Reused select must not keep the read lock
+        query.finish();
+        return entity;
     }
     return m_map[id];
 }
@@ -76,20 +110,12 @@ QSharedPointer<T> GenericRepository<T>::read(int id, bool reload)
 template<class T>
 bool GenericRepository<T>::update(const QSharedPointer<T>& entity)
 {
-    QStringList placeholders;
-
-    for (const QString& name: this->propertyNames(T::staticMetaObject))
-    {
-        if (m_columnNames.contains(name)) placeholders.append(name + " = :" + name);
-    }
-
-    m_query.prepare("UPDATE " + m_tableName + " SET " +
-                    placeholders.join(", ") + " WHERE id = :id");
+    this->flushWriter({ entity->id() });
 
-    m_query.bindValue(":id", entity->id());
-    this->bindQuery(m_query, T::staticMetaObject, entity.data());
+    QVariantList values = this->values(entity.data());
+    values.append(entity->id());
 
-    if (!this->runQuerry()) return false;
+    if (!this->runStatement(m_updateStatement, values)) return false;
     m_map[entity->id()] = entity;
     return true;
 }
@@ -97,9 +123,10 @@ bool GenericRepository<T>::update(const QSharedPointer<T>& entity)
 template<class T>
 bool GenericRepository<T>::remove(const QSharedPointer<T>& entity)
 {
-    m_query.prepare("DELETE FROM " + m_tableName + " WHERE id = :id");
-    m_query.bindValue(":id", entity->id());
-    if (!this->runQuerry()) return false;
+    // Id of the removed row can be taken by the next insert, queued update must not reach it
+    this->flushWriter({ entity->id() });
+
+    if (!this->runStatement(m_removeStatement, { entity->id() })) return false;
     this->unload(entity->id());
     // Don't set id to 0, it can be usefull for someone else
     return true;
@@ -119,6 +146,141 @@ bool GenericRepository<T>::save(const QSharedPointer<T>& entity)
     return true;
 }
 
+template<class T>
+bool GenericRepository<T>::saveAll(const QList<QSharedPointer<T> >& entities)
+{
+    if (entities.isEmpty()) return true;
+
+    QList<int> ids;
+    for (const QSharedPointer<T>& entity: entities) ids.append(entity->id());
+    this->flushWriter(ids);
+
+    // Fails inside the outer transaction, so writes just join it
+    QSqlDatabase database = QSqlDatabase::database();
+    bool ownTransaction = database.transaction();
+
+    QList<QSharedPointer<T> > inserted;
+    bool ok = true;
+
+    for (const QSharedPointer<T>& entity: entities)
+    {
+        if (entity->id() > 0)
+        {
+            ok = this->update(entity);
+            if (!ok) break;
+        }
+        else inserted.append(entity);
+    }
+
+    if (ok) ok = this->insertAll(inserted);
+    if (!ownTransaction) return ok;
+
+    if (ok) ok = database.commit();
+    if (ok) return true;
+
+    database.rollback();
+    for (const QSharedPointer<T>& entity: inserted)
+    {
+        if (entity->id() == 0) continue;
+
+        this->unload(entity->id());
+        entity->setId(0);
+    }
+    return false;
+}
+
+template<class T>
+bool GenericRepository<T>::removeAll(const QList<QSharedPointer<T> >& entities)
+{
+    if (entities.isEmpty()) return true;
+
+    QList<int> ids;
+    for (const QSharedPointer<T>& entity: entities) ids.append(entity->id());
+    this->flushWriter(ids);
+
+    QSqlDatabase database = QSqlDatabase::database();
+    bool ownTransaction = database.transaction();
+
+    bool ok = true;
+    for (const QSharedPointer<T>& entity: entities)
+    {
+        ok = this->runStatement(m_removeStatement, { entity->id() });
+        if (!ok) break;
+    }
+
+    if (ownTransaction)
+    {
+        if (ok) ok = database.commit();
+        if (!ok) database.rollback();
+    }
+    if (!ok) return false;
+
+    for (const QSharedPointer<T>& entity: entities) this->unload(entity->id());
+    return true;
+}
+
+template<class T>
+void GenericRepository<T>::updateAsync(const QSharedPointer<T>& entity, QObject* context,
+                                       const DbWriter::Callback& callback)
+{
+    this->updateAllAsync({ entity }, context, callback);
+}
+
+template<class T>
+void GenericRepository<T>::updateAllAsync(const QList<QSharedPointer<T> >& entities,
+                                          QObject* context,
+                                          const DbWriter::Callback& callback)
+{
+    if (!dbWriter || !dbWriter->isOpen())
+    {
+        bool ok = this->saveAll(entities);
+        if (callback) callback(ok);
+        return;
+    }
+
+    // Values are taken now, later changes go with the next update
+    QMutexLocker locker(&m_pending->mutex);
+    quint64 sequence = ++m_sequence;
+    QList<int> ids;
+    QList<DbWriter::Write> writes;
+    for (const QSharedPointer<T>& entity: entities)
+    {
+        DbWriter::Write write;
+        write.sql = m_updateStatement.sql;
+        write.values = this->values(entity.data());
+        m_pending->writes[entity->id()] = { sequence, write.values };
+        write.values.append(entity->id());
+        writes.append(write);
+
+        ids.append(entity->id());
+        m_map[entity->id()] = entity;
+    }
+    locker.unlock();
+
+    // Overlay is kept until the writer is done, even if the caller's context is gone
+    QWeakPointer<PendingWrites> pending = m_pending;
+    QPointer<QObject> guard = context;
+    bool hasContext = context;
+
+    dbWriter->enqueue(writes, nullptr,
+                      [pending, sequence, ids, guard, hasContext, callback](bool ok) {
+        if (QSharedPointer<PendingWrites> overlay = pending.toStrongRef())
+        {
+            QMutexLocker locker(&overlay->mutex);
+            for (int id: ids)
+            {
+                auto it = overlay->writes.find(id);
+                if (it != overlay->writes.end() && it->sequence == sequence)
+                {
+                    overlay->writes.erase(it);
+                }
+            }
+        }
+
+        if (callback && !(hasContext && guard.isNull())) callback(ok);
+    });
+}
+
 template<class T>
 bool GenericRepository<T>::contains(int id)
 {
@@ -142,17 +304,56 @@ QList<int> GenericRepository<T>::selectId(const QString& condition)
 {
     QList<int> idList;
 
+    // Queued updates don't change ids, but the condition can depend on their values
+    if (!condition.isEmpty()) this->flushWriter();
+
     QString string("SELECT id FROM " + m_tableName);
     if (!condition.isEmpty()) string += (" " + condition);
     m_query.prepare(string);
 
     if (!this->runQuerry()) return idList;
 
-    while (m_query.next()) idList.append(m_query.value("id").toInt());
+    while (m_query.next()) idList.append(m_query.value(0).toInt());
+    m_query.finish();
 
     return idList;
 }
 
+template<class T>
+QList<QSharedPointer<T> > GenericRepository<T>::loadAll(const QString& condition)
+{
+    QList<QSharedPointer<T> > entities;
+
+    // Condition can depend on queued values, all rows are just overlaid with them
+    if (!condition.isEmpty()) this->flushWriter();
+
+    QString string(m_selectSql);
+    if (!condition.isEmpty()) string += (" " + condition);
+    m_query.prepare(string);
+
+    if (!this->runQuerry()) return entities;
+
+    while (m_query.next())
+    {
+        int id = m_query.value(0).toInt();
+
+        QSharedPointer<T> entity = m_map.value(id);
+        if (entity.isNull())
+        {
+            entity = QSharedPointer<T>::create();
+            entity->setId(id);
+            m_map[id] = entity;
+        }
+
+        this->updateFromQuery(m_query, entity.data(), 1);
+        this->applyPending(entity.data());
+        entities.append(entity);
+    }
+    m_query.finish();
+
+    return entities;
+}
+
 template<class T>
 QList<int> GenericRepository<T>::loadedIds() const
 {
@@ -165,56 +366,210 @@ QList<QSharedPointer<T> > GenericRepository<T>::loadedEntities() const
     return m_map.values();
 }
 
+template<class T>
+void GenericRepository<T>::flushWriter()
+{
+    QMutexLocker locker(&m_pending->mutex);
+    if (m_pending->writes.isEmpty()) return;
+
+    // Everything queued before is written, callbacks of the writes come later
+    quint64 flushed = m_sequence;
+    locker.unlock();
+
+    if (dbWriter) dbWriter->flush();
+
+    // Updates, queued by other thread meanwhile, stay in the overlay
+    locker.relock();
+    for (auto it = m_pending->writes.begin(); it != m_pending->writes.end();)
+    {
+        if (it->sequence <= flushed) it = m_pending->writes.erase(it);
+        else ++it;
+    }
+}
+
+template<class T>
+void GenericRepository<T>::flushWriter(const QList<int>& ids)
+{
+    // Keeps order of queued and synchronous writes of the same rows
+    bool pending = false;
+    {
+        QMutexLocker locker(&m_pending->mutex);
+        for (int id: ids) pending = pending || m_pending->writes.contains(id);
+    }
+
+    if (pending) this->flushWriter();
+}
+
+template<class T>
+void GenericRepository<T>::applyPending(T* entity) const
+{
+    QVariantList values;
+    {
+        QMutexLocker locker(&m_pending->mutex);
+        auto it = m_pending->writes.constFind(entity->id());
+        if (it == m_pending->writes.constEnd()) return;
+
+        values = it->values;
+    }
+
+    this->updateFromValues(values, entity);
+}
+
 template<class T>
 bool GenericRepository<T>::runQuerry()
 {
     if (m_query.exec()) return true;
 
-    // TODO: log with db log level
-    qDebug() << m_query.lastError() << m_query.executedQuery();
+    this->logError(m_query.lastError(), m_query.executedQuery());
     return false;
 }
 
 template<class T>
-QStringList GenericRepository<T>::propertyNames(const QMetaObject& meta)
+bool GenericRepository<T>::runStatement(Statement& statement, const QVariantList& values)
 {
-    QStringList list;
+    // Statements are finalized when the connection is closed, so they are prepared again
+    bool stale = !statement.prepared || statement.connectionId != DbManager::connectionId();
+    if (stale && !this->prepareStatement(statement)) return false;
 
-    for (int i = meta.propertyOffset(); i < meta.propertyCount(); ++i)
+    for (int i = 0; i < values.count(); ++i) statement.query.bindValue(i, values.at(i));
+    if (statement.query.exec()) return true;
+
+    // Only invalidated statement runs again, failed write, e.g. constraint one, must not repeat
+    QString code = statement.query.lastError().nativeErrorCode();
+    if (!stale && (code == ::schemaChanged || code == ::finalizedStatement))
     {
-        list.append(meta.property(i).name());
+        if (!this->prepareStatement(statement)) return false;
+
+        for (int i = 0; i < values.count(); ++i) statement.query.bindValue(i, values.at(i));
+        if (statement.query.exec()) return true;
     }
 
-    return list;
+    this->logError(statement.query.lastError(), statement.sql);
+    return false;
 }
 
 template<class T>
-void GenericRepository<T>::bindQuery(QSqlQuery& query, const QMetaObject& meta, T* entity)
+bool GenericRepository<T>::prepareStatement(Statement& statement)
 {
-    for (int i = meta.propertyOffset(); i < meta.propertyCount(); ++i)
-    {
-        QString name = meta.property(i).name();
-        if (!m_columnNames.contains(name)) continue;
+    statement.query = QSqlQuery();
+    statement.query.setForwardOnly(true);
+    statement.prepared = statement.query.prepare(statement.sql);
+    statement.connectionId = DbManager::connectionId();
 
-        query.bindValue(QString(":") + name, meta.property(i).readOnGadget(entity));
-    }
+    if (!statement.prepared) this->logError(statement.query.lastError(), statement.sql);
+    return statement.prepared;
 }
 
 template<class T>
-void GenericRepository<T>::updateFromQuery(const QSqlQuery& query, const QMetaObject& meta, T* entity)
+void GenericRepository<T>::logError(const QSqlError& error, const QString& sql) const
 {
-    for (int i = meta.propertyOffset(); i < meta.propertyCount(); ++i)
+    // TODO: log with db log level
+    qDebug() << error << sql;
+}
+
+template<class T>
+bool GenericRepository<T>::insertAll(const QList<QSharedPointer<T> >& entities)
+{
+    if (entities.isEmpty()) return true;
+
+    // Ids are given explicitly, multi-row insert does not report every rowid
+    m_query.prepare("SELECT MAX(id) FROM " + m_tableName);
+    if (!this->runQuerry()) return false;
+
+    int nextId = m_query.next() ? m_query.value(0).toInt() + 1 : 1;
+    m_query.finish();
+
+    for (int first = 0; first < entities.count(); first += m_batchSize)
     {
-        QString name = meta.property(i).name();
-        if (!m_columnNames.contains(name)) continue;
+        int rows = qMin(m_batchSize, entities.count() - first);
+
+        Statement tail;
+        Statement& statement = rows == m_batchSize ? m_batchInsertStatement : tail;
+        if (rows != m_batchSize) tail.sql = this->insertSql(rows);
 
-        QVariant value = query.value(meta.property(i).name());
+        QVariantList values;
+        values.reserve(rows * (m_properties.count() + 1));
 
-        // workaround for enums
-        if (!meta.property(i).writeOnGadget(entity, value) && !value.isNull())
+        for (int i = first; i < first + rows; ++i)
         {
-            meta.property(i).writeOnGadget(entity, value.toInt());
+            values.append(nextId + i);
+            values.append(this->values(entities.at(i).data()));
         }
+
+        if (!this->runStatement(statement, values)) return false;
+
+        for (int i = first; i < first + rows; ++i)
+        {
+            const QSharedPointer<T>& entity = entities.at(i);
+            entity->setId(nextId + i);
+            m_map[entity->id()] = entity;
+        }
+    }
+
+    return true;
+}
+
+template<class T>
+QString GenericRepository<T>::insertSql(int rows) const
+{
+    QStringList names({ "id" });
+    QStringList placeholders({ "?" });
+
+    for (const QMetaProperty& property: m_properties)
+    {
+        names.append(property.name());
+        placeholders.append("?");
+    }
+
+    QString row = "(" + placeholders.join(", ") + ")";
+    QStringList values;
+    for (int i = 0; i < rows; ++i) values.append(row);
+
+    return "INSERT INTO " + m_tableName + " (" + names.join(", ") + ") VALUES " +
+            values.join(", ");
+}
+
+template<class T>
+QVariantList GenericRepository<T>::values(const T* entity) const
+{
+    QVariantList values;
+    values.reserve(m_properties.count() + 1);
+
+    for (const QMetaProperty& property: m_properties)
+    {
+        values.append(property.readOnGadget(entity));
+    }
+
+    return values;
+}
+
+template<class T>
+void GenericRepository<T>::updateFromQuery(const QSqlQuery& query, T* entity, int offset)
+{
+    for (int i = 0; i < m_properties.count(); ++i)
+    {
+        this->writeProperty(i, query.value(offset + i), entity);
+    }
+}
+
+template<class T>
+void GenericRepository<T>::updateFromValues(const QVariantList& values, T* entity) const
+{
+    for (int i = 0; i < m_properties.count() && i < values.count(); ++i)
+    {
+        this->writeProperty(i, values.at(i), entity);
+    }
+}
+
+template<class T>
+void GenericRepository<T>::writeProperty(int index, const QVariant& value, T* entity) const
+{
+    const QMetaProperty& property = m_properties.at(index);
+
+    // workaround for enums
+    if (!property.writeOnGadget(entity, value) && !value.isNull())
+    {
+        property.writeOnGadget(entity, value.toInt());
     }
 }
 
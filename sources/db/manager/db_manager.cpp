@@ -2,19 +2,33 @@
 
 // Qt
 #include <QFileInfo>
+#include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 
 // Internal
 #include "db_migrator.h"
+#include "db_writer.h"
 
 namespace
 {
     const QString connectionType = "QSQLITE";
+
+    // WAL lets the writer connection commit while others read, NORMAL sync is durable
+    // in WAL mode except for power loss, busy timeout covers writes of other connection
+    const QStringList pragmas = {
+        "PRAGMA journal_mode = WAL",
+        "PRAGMA synchronous = NORMAL",
+        "PRAGMA busy_timeout = 5000",
+        "PRAGMA temp_store = MEMORY",
+        "PRAGMA cache_size = -8192"
+    };
 }
 
 using namespace db;
 
+quint64 DbManager::openCount = 0;
+
 DbManager::DbManager(QObject* parent):
     QObject(parent),
     m_db(QSqlDatabase::contains() ? QSqlDatabase::database() :
@@ -36,6 +50,7 @@ bool DbManager::open(const QString& dbName)
 
     m_db.setDatabaseName(dbName);
     bool ok = m_db.open();
+    DbManager::openCount++;
 
     if (ok && exist)
     {
@@ -48,7 +63,13 @@ bool DbManager::open(const QString& dbName)
         return false;
     }
 
-    return m_migrator->migrate();
+    // Tuning is not critical, database works with defaults
+    DbManager::configure(m_db);
+
+    if (!m_migrator->migrate()) return false;
+
+    if (dbWriter) dbWriter->open(dbName);
+    return true;
 }
 
 bool DbManager::migrateLastVersion()
@@ -69,10 +90,32 @@ void DbManager::clarify()
 
 void DbManager::close()
 {
+    if (dbWriter) dbWriter->close();
+
     m_migrator->reset();
     m_db.close();
 }
 
+bool DbManager::configure(QSqlDatabase& database)
+{
+    QSqlQuery query(database);
+
+    for (const QString& pragma: ::pragmas)
+    {
+        if (query.exec(pragma)) continue;
+
+        qWarning() << query.lastError() << pragma;
+        return false;
+    }
+
+    return true;
+}
+
+quint64 DbManager::connectionId()
+{
+    return DbManager::openCount;
+}
+
 void DbManager::clearLog()
 {
     m_dbLog.clear();
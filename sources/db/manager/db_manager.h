@@ -27,6 +27,12 @@ namespace db
         void clearLog();
 
         bool isOpen() const;
+
+        // WAL journal and connection pragmas, for every connection to the database
+        static bool configure(QSqlDatabase& database);
+
+        // Changes on every open, statements prepared before are finalized by the driver
+        static quint64 connectionId();
         QDateTime migrationVersion() const;
 
         QStringList dbLog() const;
@@ -41,6 +47,8 @@ namespace db
         QSqlDatabase m_db;
         DbMigrator* m_migrator;
         QStringList m_dbLog;
+
+        static quint64 openCount;
     };
 }
 
@@ -0,0 +1,240 @@
+#include "db_writer.h"
+
+// Qt
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QPointer>
+#include <QTimer>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+// Internal
+#include "db_manager.h"
+
+namespace
+{
+    const QString connectionType = "QSQLITE";
+    const QString connectionName = "db_writer";
+
+    struct Task
+    {
+        QList<db::DbWriter::Write> writes;
+        QPointer<QObject> context;
+        db::DbWriter::Callback callback;
+    };
+
+    class WriterThread: public QThread
+    {
+    public:
+        WriterThread(db::DbWriter* writer, const QString& dbName):
+            m_writer(writer),
+            m_dbName(dbName)
+        {}
+
+        void enqueue(const Task& task)
+        {
+            QMutexLocker locker(&m_mutex);
+
+            m_tasks.enqueue(task);
+            m_wakeup.wakeOne();
+        }
+
+        void flush()
+        {
+            QMutexLocker locker(&m_mutex);
+
+            while (!m_tasks.isEmpty() && this->isRunning()) m_drained.wait(&m_mutex, 100);
+        }
+
+        void stop()
+        {
+            {
+                QMutexLocker locker(&m_mutex);
+
+                m_stopping = true;
+                m_wakeup.wakeOne();
+            }
+
+            this->wait();
+        }
+
+        int pending() const
+        {
+            QMutexLocker locker(&m_mutex);
+            return m_tasks.count();
+        }
+
+    protected:
+        void run() override
+        {
+            {
+                QSqlDatabase database = QSqlDatabase::addDatabase(::connectionType,
+                                                                  ::connectionName);
+                database.setDatabaseName(m_dbName);
+                if (database.open()) db::DbManager::configure(database);
+                else qWarning() << "DB writer:" << database.lastError().text();
+
+                this->process(database);
+
+                database.close();
+            }
+
+            QSqlDatabase::removeDatabase(::connectionName);
+        }
+
+    private:
+        void process(QSqlDatabase& database)
+        {
+            forever
+            {
+                Task task;
+                {
+                    QMutexLocker locker(&m_mutex);
+
+                    while (m_tasks.isEmpty() && !m_stopping) m_wakeup.wait(&m_mutex);
+                    if (m_tasks.isEmpty()) return; // Stopping, everything is written
+
+                    // Task stays in the queue until it is done, so flush waits for it
+                    task = m_tasks.head();
+                }
+
+                bool ok = this->execute(database, task.writes);
+
+                if (task.callback)
+                {
+                    QPointer<QObject> context = task.context;
+                    db::DbWriter::Callback callback = task.callback;
+                    bool hasContext = !context.isNull();
+
+                    QTimer::singleShot(0, m_writer, [context, hasContext, callback, ok]() {
+                        if (hasContext && context.isNull()) return;
+                        callback(ok);
+                    });
+                }
+
+                QMutexLocker locker(&m_mutex);
+                m_tasks.dequeue();
+                if (m_tasks.isEmpty()) m_drained.wakeAll();
+            }
+        }
+
+        bool execute(QSqlDatabase& database, const QList<db::DbWriter::Write>& writes)
+        {
+            bool transaction = writes.count() > 1 && database.transaction();
+            bool ok = database.isOpen();
+
+            QSqlQuery query(database);
+            for (const db::DbWriter::Write& write: writes)
+            {
+                if (!ok) break;
+
+                ok = query.prepare(write.sql);
+                for (int i = 0; ok && i < write.values.count(); ++i)
+                {
+                    query.bindValue(i, write.values.at(i));
+                }
+
+                if (ok) ok = query.exec();
+                if (!ok) qDebug() << "DB writer:" << query.lastError() << write.sql;
+            }
+
+            if (!transaction) return ok;
+
+            if (ok) ok = database.commit();
+            if (!ok) database.rollback();
+
+            return ok;
+        }
+
+        db::DbWriter* const m_writer;
+        const QString m_dbName;
+
+        mutable QMutex m_mutex;
+        QWaitCondition m_wakeup;
+        QWaitCondition m_drained;
+        QQueue<Task> m_tasks;
+        bool m_stopping = false;
+    };
+}
+
+using namespace db;
+
+DbWriter* DbWriter::lastCreatedWriter = nullptr;
+
+class DbWriter::Impl
+{
+public:
+    QScopedPointer<WriterThread> thread;
+};
+
+DbWriter::DbWriter(QObject* parent):
+    QObject(parent),
+    d(new Impl())
+{
+    DbWriter::lastCreatedWriter = this;
+}
+
+DbWriter::~DbWriter()
+{
+    this->close();
+
+    if (DbWriter::lastCreatedWriter == this) DbWriter::lastCreatedWriter = nullptr;
+}
+
+DbWriter* DbWriter::instance()
+{
+    return DbWriter::lastCreatedWriter;
+}
+
+bool DbWriter::isOpen() const
+{
+    return !d->thread.isNull();
+}
+
+int DbWriter::pending() const
+{
+    return d->thread ? d->thread->pending() : 0;
+}
+
+void DbWriter::open(const QString& dbName)
+{
+    this->close();
+
+    d->thread.reset(new WriterThread(this, dbName));
+    d->thread->start();
+}
+
+void DbWriter::close()
+{
+    if (d->thread.isNull()) return;
+
+    // Queued writes are done before the connection goes down
+    d->thread->stop();
+    d->thread.reset();
+}
+
+void DbWriter::enqueue(const QList<Write>& writes, QObject* context, const Callback& callback)
+{
+    if (d->thread.isNull())
+    {
+        qWarning() << "DB writer is not open, writes are lost";
+        if (callback) callback(false);
+        return;
+    }
+
+    Task task;
+    task.writes = writes;
+    task.context = context;
+    task.callback = callback;
+
+    d->thread->enqueue(task);
+}
+
+void DbWriter::flush()
+{
+    if (d->thread) d->thread->flush();
+}
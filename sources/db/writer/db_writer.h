@@ -0,0 +1,60 @@
+#ifndef DB_WRITER_H
+#define DB_WRITER_H
+
+// Qt
+#include <QObject>
+#include <QVariantList>
+#include <QScopedPointer>
+
+// Std
+#include <functional>
+
+namespace db
+{
+    // Executes writes in own thread with own connection, so callers never wait on disk sync
+    class DbWriter: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        using Callback = std::function<void (bool ok)>;
+
+        struct Write
+        {
+            QString sql;
+            QVariantList values; // Positional
+        };
+
+        explicit DbWriter(QObject* parent = nullptr);
+        ~DbWriter() override;
+
+        static DbWriter* instance();
+
+        bool isOpen() const;
+        int pending() const;
+
+        // Connection follows the main one, see DbManager
+        void open(const QString& dbName);
+        void close();
+
+        // Any thread. Writes of one call run in one transaction. Callback is posted to the
+        // thread of this object, it is skipped if the context is already destroyed.
+        void enqueue(const QList<Write>& writes, QObject* context = nullptr,
+                     const Callback& callback = Callback());
+
+        // Any thread except the writer one, waits until queued writes are done
+        void flush();
+
+    private:
+        class Impl;
+        QScopedPointer<Impl> const d;
+
+        static DbWriter* lastCreatedWriter;
+
+        Q_DISABLE_COPY(DbWriter)
+    };
+}
+
+#define dbWriter (db::DbWriter::instance())
+
+#endif // DB_WRITER_H
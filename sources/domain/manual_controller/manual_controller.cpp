@@ -8,10 +8,11 @@
 // Interval
 #include "settings_provider.h"
 
-#include "command.h"
+#include "latency_monitor.h"
 
 #include "service_registry.h"
 #include "command_service.h"
+#include "manual_control_channel.h"
 
 #ifdef WITH_GAMEPAD
 #include "joystick_controller.h"
@@ -204,6 +205,9 @@ void ManualController::setImpact(Axis axis, double impact)
 
     d->impacts[axis] = impactScaled;
     emit impactChanged(axis, impactScaled);
+
+    // Input goes out at once, the timer only keeps the stream alive
+    if (this->enabled()) this->sendImpacts();
 }
 
 void ManualController::addImpact(ManualController::Axis axis, double impact)
@@ -223,12 +227,15 @@ void ManualController::sendImpacts()
 {
     if (d->vehicleId == 0) return;
 
-    dto::CommandPtr command = dto::CommandPtr::create();
-    command->setType(dto::Command::ManualImpacts);
-
-    for (Axis axis: axes) command->addArgument(this->impact(axis));
+    ManualControlChannel::Sample sample;
+    sample.vehicleId = d->vehicleId;
+    sample.pitch = this->impact(Pitch);
+    sample.roll = this->impact(Roll);
+    sample.yaw = this->impact(Yaw);
+    sample.thrust = this->impact(Throttle);
+    sample.origin = utils::LatencyMonitor::now();
 
-    d->service->executeCommand(d->vehicleId, command);
+    d->service->manualControl()->post(sample);
 }
 
 void ManualController::onTimeout()
@@ -1,14 +1,26 @@
 #include "abstract_command_handler.h"
 
 // Qt
-#include <QMap>
+#include <QHash>
 #include <QTimerEvent>
+#include <QElapsedTimer>
 #include <QDebug>
 
+// Internal
+#include "rtt_estimator.h"
+#include "timing_wheel.h"
+
 namespace
 {
-    const int interval = 500;
+    const int interval = 500; // Retry timeout until the round trip is measured
+    const int minInterval = 500; // COMMAND_LONG is often acked after it is executed
+    const int maxInterval = 3000;
     const int maxAttemps = 5;
+
+    quint64 commandKey(int vehicleId, dto::Command::CommandType type)
+    {
+        return (quint64(quint32(vehicleId)) << 32) | quint32(type);
+    }
 }
 
 using namespace domain;
@@ -16,9 +28,37 @@ using namespace domain;
 class AbstractCommandHandler::Impl
 {
 public:
-    QMultiMap<int, dto::CommandPtr> vehicleCommands;
-    QMap <dto::CommandPtr, int> attemps;
-    QMap <dto::CommandPtr, int> commandTimers;
+    // Vehicle has only one command of a type in flight, new one cancels the previous
+    struct InFlight
+    {
+        int vehicleId = 0;
+        dto::CommandPtr command;
+        int attempt = 0;
+        qint64 sent = 0; // first sending, zero after the round trip is sampled
+    };
+
+    QHash<quint64, InFlight> commands;
+    QHash<int, utils::RttEstimator> vehicleRtts;
+
+    utils::TimingWheel wheel;
+    int wheelTimer = 0;
+    QElapsedTimer clock;
+
+    Impl()
+    {
+        clock.start();
+    }
+
+    utils::RttEstimator& rtt(int vehicleId)
+    {
+        auto it = vehicleRtts.find(vehicleId);
+        if (it == vehicleRtts.end())
+        {
+            it = vehicleRtts.insert(vehicleId, utils::RttEstimator(::interval, ::minInterval,
+                                                                   ::maxInterval));
+        }
+        return it.value();
+    }
 };
 
 AbstractCommandHandler::AbstractCommandHandler(QObject* parent):
@@ -29,28 +69,41 @@ AbstractCommandHandler::AbstractCommandHandler(QObject* parent):
 AbstractCommandHandler::~AbstractCommandHandler()
 {}
 
-void AbstractCommandHandler::executeCommand(int vehicleId, const dto::CommandPtr& command)
+int AbstractCommandHandler::retryTimeout(int vehicleId) const
 {
-    for (const dto::CommandPtr& timedCommand: d->commandTimers.keys())
-    {
-        if (timedCommand->type() != command->type() ||
-            !d->vehicleCommands.values(vehicleId).contains(timedCommand)) continue;
+    return d->rtt(vehicleId).timeout();
+}
 
-        this->stopCommand(vehicleId, timedCommand);
+void AbstractCommandHandler::executeCommand(int vehicleId, const dto::CommandPtr& command)
+{
+    quint64 key = ::commandKey(vehicleId, command->type());
 
-        timedCommand->setStatus(dto::Command::Canceled);
-        emit commandChanged(timedCommand);
+    auto it = d->commands.find(key);
+    if (it != d->commands.end())
+    {
+        dto::CommandPtr previous = it->command;
+        this->stopCommand(vehicleId, previous);
 
-        break;
+        previous->setStatus(dto::Command::Canceled);
+        emit commandChanged(previous);
     }
 
-    d->vehicleCommands.insert(vehicleId, command);
-    d->attemps[command] = 0;
-    d->commandTimers[command] = this->startTimer(::interval);
+    Impl::InFlight& inFlight = d->commands[key];
+    inFlight.vehicleId = vehicleId;
+    inFlight.command = command;
+    inFlight.sent = qMax(d->clock.elapsed(), qint64(1));
     command->setStatus(dto::Command::Sending);
 
     this->sendCommand(vehicleId, command);
 
+    // Commands without answer are done at once and don't get into the wheel
+    it = d->commands.find(key);
+    if (it != d->commands.end() && it->command == command)
+    {
+        d->wheel.schedule(key, d->clock.elapsed() + this->retryTimeout(vehicleId));
+        if (!d->wheelTimer) d->wheelTimer = this->startTimer(d->wheel.tick());
+    }
+
     emit commandChanged(command);
 }
 
@@ -62,39 +115,80 @@ void AbstractCommandHandler::cancelCommand(int vehicleId, dto::Command::CommandT
 void AbstractCommandHandler::ackCommand(int vehicleId, dto::Command::CommandType type,
                                         dto::Command::CommandStatus status)
 {
-    for (const dto::CommandPtr& command: d->vehicleCommands.values(vehicleId))
-    {
-        if (command->type() != type) continue;
+    auto it = d->commands.constFind(::commandKey(vehicleId, type));
+    if (it == d->commands.constEnd()) return;
 
-        command->setStatus(status);
-        if (command->isFinished()) this->stopCommand(vehicleId, command);
+    dto::CommandPtr command = it->command;
 
-        emit commandChanged(command);
-    }
+    command->setStatus(status);
+    if (command->isFinished()) this->stopCommand(vehicleId, command);
+
+    emit commandChanged(command);
 }
 
 void AbstractCommandHandler::stopCommand(int vehicleId, const dto::CommandPtr& command)
 {
-    if (d->commandTimers.contains(command))
-    {
-        this->killTimer(d->commandTimers.take(command));
-    }
-    d->vehicleCommands.remove(vehicleId, command);
-    d->attemps.remove(command);
+    quint64 key = ::commandKey(vehicleId, command->type());
+
+    auto it = d->commands.find(key);
+    if (it == d->commands.end() || it->command != command) return;
+
+    d->commands.erase(it);
+    d->wheel.cancel(key);
+}
+
+void AbstractCommandHandler::sampleRoundTrip(int vehicleId, dto::Command::CommandType type)
+{
+    auto it = d->commands.find(::commandKey(vehicleId, type));
+    if (it == d->commands.end() || !it->sent) return;
+
+    // Answers of the retransmitted commands are ambiguous
+    if (!it->attempt) d->rtt(vehicleId).addSample(d->clock.elapsed() - it->sent);
+    it->sent = 0;
+}
+
+void AbstractCommandHandler::addRoundTrip(int vehicleId, qint64 rtt)
+{
+    d->rtt(vehicleId).addSample(rtt);
 }
 
 void AbstractCommandHandler::timerEvent(QTimerEvent* event)
 {
-    dto::CommandPtr command = d->commandTimers.key(event->timerId());
-    if (command.isNull()) return QObject::timerEvent(event);
+    if (event->timerId() != d->wheelTimer) return QObject::timerEvent(event);
+
+    qint64 now = d->clock.elapsed();
+    for (quint64 key: d->wheel.advance(now))
+    {
+        auto it = d->commands.find(key);
+        if (it == d->commands.end()) continue;
 
-    int vehicleId = d->vehicleCommands.key(command, 0);
-    this->sendCommand(vehicleId, command, ++d->attemps[command]);
+        int vehicleId = it->vehicleId;
+        dto::CommandPtr command = it->command;
+        int attempt = ++it->attempt;
 
-    if (d->attemps[command] < ::maxAttemps) return;
+        this->sendCommand(vehicleId, command, attempt);
 
-    this->stopCommand(vehicleId, command);
+        // Command can be answered while it is sent
+        it = d->commands.find(key);
+        if (it == d->commands.end() || it->command != command) continue;
 
-    command->setStatus(dto::Command::Rejected);
-    emit commandChanged(command);
+        // Timeout doubles on every retry until the vehicle answers, RFC 6298 (5.5)
+        if (attempt < ::maxAttemps)
+        {
+            d->rtt(vehicleId).backOff();
+            d->wheel.schedule(key, now + this->retryTimeout(vehicleId));
+            continue;
+        }
+
+        this->stopCommand(vehicleId, command);
+
+        command->setStatus(dto::Command::Rejected);
+        emit commandChanged(command);
+    }
+
+    if (d->wheel.isEmpty())
+    {
+        this->killTimer(d->wheelTimer);
+        d->wheelTimer = 0;
+    }
 }
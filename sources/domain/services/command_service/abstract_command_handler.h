@@ -17,6 +17,9 @@ namespace domain
         explicit AbstractCommandHandler(QObject* parent = nullptr);
         ~AbstractCommandHandler() override;
 
+        // Retry timeout of the vehicle commands, from the measured round trip
+        int retryTimeout(int vehicleId) const;
+
     public slots:
         void executeCommand(int vehicleId, const dto::CommandPtr& command);
         void cancelCommand(int vehicleId, dto::Command::CommandType type);
@@ -29,6 +32,10 @@ namespace domain
         void stopCommand(int vehicleId, const dto::CommandPtr& command);
         void timerEvent(QTimerEvent* event) override;
 
+        // Vehicle answered the command, time from the first sending is a round trip
+        void sampleRoundTrip(int vehicleId, dto::Command::CommandType type);
+        void addRoundTrip(int vehicleId, qint64 rtt);
+
         virtual void sendCommand(int vehicleId, const dto::CommandPtr& command, int attempt = 0) = 0;
 
     private:
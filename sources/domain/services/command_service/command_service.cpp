@@ -5,17 +5,24 @@
 
 // Internal
 #include "abstract_command_handler.h"
+#include "manual_control_channel.h"
 
 using namespace domain;
 
 CommandService::CommandService(QObject* parent):
-    QObject(parent)
+    QObject(parent),
+    m_manualControl(new ManualControlChannel(this))
 {
     qRegisterMetaType<dto::CommandPtr>("dto::CommandPtr");
     qRegisterMetaType<dto::Command::CommandType>("dto::Command::CommandType");
     qRegisterMetaType<dto::Command::CommandStatus>("dto::Command::CommandStatus");
 }
 
+ManualControlChannel* CommandService::manualControl() const
+{
+    return m_manualControl;
+}
+
 void CommandService::addHandler(AbstractCommandHandler* handler)
 {
     connect(this, &CommandService::executeCommand, handler, &AbstractCommandHandler::executeCommand);
@@ -11,6 +11,7 @@
 namespace domain
 {
     class AbstractCommandHandler;
+    class ManualControlChannel;
 
     class CommandService: public QObject
     {
@@ -19,6 +20,8 @@ namespace domain
     public:
         explicit CommandService(QObject* parent = nullptr);
 
+        ManualControlChannel* manualControl() const;
+
     public slots:
         void addHandler(AbstractCommandHandler* handler);
         void removeHandler(AbstractCommandHandler* handler);
@@ -28,6 +31,9 @@ namespace domain
         void cancelCommand(int vehicleId, dto::Command::CommandType type);
 
         void commandChanged(dto::CommandPtr command);
+
+    private:
+        ManualControlChannel* const m_manualControl;
     };
 }
 
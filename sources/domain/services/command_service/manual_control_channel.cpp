@@ -0,0 +1,36 @@
+#include "manual_control_channel.h"
+
+// Qt
+#include <QMutexLocker>
+
+using namespace domain;
+
+ManualControlChannel::ManualControlChannel(QObject* parent):
+    QObject(parent)
+{}
+
+void ManualControlChannel::post(const Sample& sample)
+{
+    bool wasFresh;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        wasFresh = m_fresh;
+        m_sample = sample;
+        m_fresh = true;
+    }
+
+    // Consumer, which is notified already, takes the newest sample anyway
+    if (!wasFresh) emit posted();
+}
+
+bool ManualControlChannel::take(Sample* sample)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_fresh) return false;
+
+    *sample = m_sample;
+    m_fresh = false;
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef MANUAL_CONTROL_CHANNEL_H
+#define MANUAL_CONTROL_CHANNEL_H
+
+// Qt
+#include <QObject>
+#include <QMutex>
+
+namespace domain
+{
+    // Stick inputs go past the command bookkeeping: producer overwrites the latest sample and
+    // the communication thread takes it when it is ready to send. Samples, which are not taken
+    // in time, are stale and dropped, so a busy link never gets a backlog of them.
+    class ManualControlChannel: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        struct Sample
+        {
+            int vehicleId = 0;
+            float pitch = 0;
+            float roll = 0;
+            float yaw = 0;
+            float thrust = 0;
+            qint64 origin = 0; // LatencyMonitor time of the input, zero if unknown
+        };
+
+        explicit ManualControlChannel(QObject* parent = nullptr);
+
+        // Thread safe
+        void post(const Sample& sample);
+        bool take(Sample* sample); // false if there is no new sample
+
+    signals:
+        void posted(); // Once until the sample is taken
+
+    private:
+        QMutex m_mutex;
+        Sample m_sample;
+        bool m_fresh = false;
+    };
+}
+
+#endif // MANUAL_CONTROL_CHANNEL_H
@@ -3,6 +3,9 @@
 // Qt
 #include <QThread>
 #include <QMap>
+#include <QDir>
+#include <QDateTime>
+#include <QStandardPaths>
 #include <QDebug>
 
 // Internal
@@ -18,6 +21,8 @@
 #include "description_link_factory.h"
 #include "mavlink_communicator_factory.h"
 #include "communicator_worker.h"
+#include "tlog_recorder.h"
+#include "latency_monitor.h"
 
 #include "notification_bus.h"
 
@@ -33,6 +38,7 @@ public:
     QThread* commThread;
     CommunicatorWorker* commWorker;
     comm::MavLinkCommunicator* communicator = nullptr;
+    comm::TlogRecorder recorder;
 
     GenericRepository<dto::LinkDescription> linkRepository;
 
@@ -42,7 +48,22 @@ public:
 
     void loadDescriptions(const QString& condition = QString())
     {
-        for (int id: linkRepository.selectId(condition)) linkRepository.read(id);
+        linkRepository.loadAll(condition);
+    }
+
+    void startRecording()
+    {
+        QString path = settings::Provider::value(settings::communication::tlogPath).toString();
+        if (path.isEmpty())
+        {
+            path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/tlogs";
+        }
+
+        QDir dir(path);
+        if (!dir.exists() && !dir.mkpath(".")) return;
+
+        recorder.start(dir.filePath(QDateTime::currentDateTime().toString(
+                                        "yyyy-MM-dd_hh-mm-ss") + ".tlog"));
     }
 
     dto::LinkStatisticsPtr getlinkStatistics(int linkId)
@@ -96,11 +117,15 @@ CommunicationService::CommunicationService(SerialPortService* serialPortService,
 
 CommunicationService::~CommunicationService()
 {
+    // Only autoconnect flags are stored on exit, links are going down anyway
     for (const dto::LinkDescriptionPtr& description: this->descriptions())
     {
         description->setAutoConnect(description->isConnected());
-        this->save(description);
+    }
+    d->linkRepository.saveAll(this->descriptions());
 
+    for (const dto::LinkDescriptionPtr& description: this->descriptions())
+    {
         if (d->descriptedDevices.contains(description))
         {
             d->serialPortService->releaseDevice(d->descriptedDevices.take(description));
@@ -109,6 +134,11 @@ CommunicationService::~CommunicationService()
 
     d->commThread->quit();
     d->commThread->wait();
+
+    if (utils::LatencyMonitor::isEnabled())
+    {
+        qDebug().noquote() << "Telemetry latency:\n" + utils::LatencyMonitor::report();
+    }
 }
 
 dto::LinkDescriptionPtr CommunicationService::description(int id) const
@@ -170,7 +200,14 @@ void CommunicationService::init()
                 settings::Provider::boolValue(settings::communication::retranslationEnabled));
 
     d->communicator = commFactory.create();
+    d->communicator->setParseThreads(
+                settings::Provider::value(settings::communication::parseThreads).toInt());
+    d->communicator->setRecorder(&d->recorder);
     d->communicator->moveToThread(d->commThread);
+
+    if (settings::Provider::boolValue(settings::communication::recordTlog)) d->startRecording();
+    utils::LatencyMonitor::setEnabled(
+                settings::Provider::boolValue(settings::diagnostics::latency));
     d->commWorker->setCommunicator(d->communicator);
 
     for (const dto::LinkDescriptionPtr& description: this->descriptions())
@@ -2,6 +2,7 @@
 
 // Qt
 #include <QMap>
+#include <QHash>
 #include <QMutexLocker>
 #include <QGeoCoordinate>
 
@@ -28,6 +29,19 @@ public:
 
     QMap <int, MissionItemPtr> currentItems;
 
+    // Loaded items of a mission, ordered by sequence
+    struct ItemIndex
+    {
+        QMap<int, MissionItemPtr> sequences;
+        MissionItemPtrList items; // Built on demand from sequences
+        bool dirty = false;
+    };
+
+    QHash<int, ItemIndex> itemIndexes;
+    QHash<int, QPair<int, int> > itemKeys; // Item id to indexed mission id and sequence
+
+    QHash<int, QVector<uint> > vehicleHashes; // Vehicle id to hashes of items onboard
+
     Impl():
         mutex(QMutex::Recursive),
         missionRepository("missions"),
@@ -37,17 +51,47 @@ public:
 
     void loadMissions(const QString& condition = QString())
     {
-        for (int id: missionRepository.selectId(condition)) missionRepository.read(id);
+        missionRepository.loadAll(condition);
     }
 
     void loadMissionItems(const QString& condition = QString())
     {
-        for (int id: itemRepository.selectId(condition)) itemRepository.read(id);
+        for (const MissionItemPtr& item: itemRepository.loadAll(condition))
+        {
+            this->indexItem(item);
+        }
+    }
+
+    void indexItem(const MissionItemPtr& item)
+    {
+        this->unindexItem(item);
+
+        ItemIndex& index = itemIndexes[item->missionId()];
+        index.sequences[item->sequence()] = item;
+        index.dirty = true;
+
+        itemKeys[item->id()] = qMakePair(item->missionId(), item->sequence());
+    }
+
+    void unindexItem(const MissionItemPtr& item)
+    {
+        if (!itemKeys.contains(item->id())) return;
+
+        QPair<int, int> key = itemKeys.take(item->id());
+        auto it = itemIndexes.find(key.first);
+        if (it == itemIndexes.end()) return;
+
+        // Key can be already taken by another item with the same sequence
+        if (it->sequences.value(key.second) != item) return;
+
+        it->sequences.remove(key.second);
+        it->dirty = true;
+        if (it->sequences.isEmpty()) itemIndexes.erase(it);
     }
 
     void loadMissionAssignments(const QString& condition = QString())
     {
-        for (int id: assignmentRepository.selectId(condition)) assignmentRepository.read(id);
+        assignmentRepository.loadAll(condition);
     }
 };
 
@@ -79,8 +123,11 @@ MissionItemPtr MissionService::missionItem(int id) const
 {
     QMutexLocker locker(&d->mutex);
 
-    if (id) return d->itemRepository.read(id);
-    return MissionItemPtr();
+    if (!id) return MissionItemPtr();
+
+    MissionItemPtr item = d->itemRepository.read(id);
+    if (item && !d->itemKeys.contains(id)) d->indexItem(item);
+    return item;
 }
 
 MissionAssignmentPtr MissionService::assignment(int id) const
@@ -124,6 +171,52 @@ int MissionService::isCurrentForVehicle(const MissionItemPtr& item) const
     return d->currentItems.key(item, 0);
 }
 
+uint MissionService::itemHash(const MissionItemPtr& item)
+{
+    // Coordinates are compared in the precision of MAVLink integer items
+    auto degrees = [](double value) {
+        return qIsNaN(value) ? 0 : qHash(qRound64(value * 1e7));
+    };
+
+    uint seed = qHash(int(item->command()));
+    seed ^= qHash(item->isAltitudeRelative()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= qHash(qRound(item->altitude() * 100)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= degrees(item->latitude()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= degrees(item->longitude()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= qHash(item->parameters()) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+QVector<uint> MissionService::vehicleItemHashes(int vehicleId) const
+{
+    QMutexLocker locker(&d->mutex);
+
+    return d->vehicleHashes.value(vehicleId);
+}
+
+void MissionService::setVehicleItemHashes(int vehicleId, const QVector<uint>& hashes)
+{
+    QMutexLocker locker(&d->mutex);
+
+    d->vehicleHashes[vehicleId] = hashes;
+}
+
+void MissionService::setVehicleItems(int vehicleId, const MissionItemPtrList& items)
+{
+    QVector<uint> hashes;
+    hashes.reserve(items.count());
+    for (const MissionItemPtr& item: items) hashes.append(MissionService::itemHash(item));
+
+    this->setVehicleItemHashes(vehicleId, hashes);
+}
+
+void MissionService::resetVehicleItems(int vehicleId)
+{
+    QMutexLocker locker(&d->mutex);
+
+    d->vehicleHashes.remove(vehicleId);
+}
+
 dto::MissionItemPtr MissionService::addNewMissionItem(int missionId,
                                                       dto::MissionItem::Command command,
                                                       int sequence,
@@ -178,16 +271,18 @@ dto::MissionItemPtr MissionService::addNewMissionItem(int missionId,
     }
 
     // TODO: querry by sequence
+    dto::MissionItemPtrList changed;
     for (const dto::MissionItemPtr& other: this->missionItems(missionId))
     {
         if (other->sequence() < sequence) continue;
 
         other->setSequence(other->sequence() + 1);
         other->setStatus(dto::MissionItem::NotActual);
-        this->save(other);
+        changed.append(other);
     }
+    changed.append(item);
 
-    if (!this->save(item)) return dto::MissionItemPtr();
+    if (!this->save(changed)) return dto::MissionItemPtr();
 
     dto::MissionAssignmentPtr assignment = this->missionAssignment(missionId);
     if (assignment)
@@ -238,23 +333,25 @@ MissionItemPtrList MissionService::missionItems(int missionId) const
 {
     QMutexLocker locker(&d->mutex);
 
-    QMap<int, MissionItemPtr> items;
-    for (const MissionItemPtr& item: d->itemRepository.loadedEntities())
+    auto it = d->itemIndexes.find(missionId);
+    if (it == d->itemIndexes.end()) return MissionItemPtrList();
+
+    if (it->dirty)
     {
-        if (item->missionId() == missionId) items[item->sequence()] = item;
+        it->items = it->sequences.values();
+        it->dirty = false;
     }
-    return items.values();
+    return it->items;
 }
 
 MissionItemPtr MissionService::missionItem(int missionId, int sequence) const
 {
     QMutexLocker locker(&d->mutex);
 
-    for (const MissionItemPtr& item: d->itemRepository.loadedEntities())
-    {
-        if (item->missionId() == missionId && item->sequence() == sequence) return item;
-    }
-    return MissionItemPtr();
+    auto it = d->itemIndexes.constFind(missionId);
+    if (it == d->itemIndexes.constEnd()) return MissionItemPtr();
+
+    return it->sequences.value(sequence);
 }
 
 bool MissionService::save(const MissionPtr& mission)
@@ -284,7 +381,18 @@ bool MissionService::save(const MissionItemPtr& item)
 
     bool isNew = item->id() == 0;
     item->clearSuperfluousParameters();
-    if (!d->itemRepository.save(item)) return false;
+
+    if (isNew)
+    {
+        if (!d->itemRepository.insert(item)) return false;
+    }
+    else
+    {
+        d->itemRepository.updateAsync(item, this, [this, item](bool ok) {
+            if (!ok) this->restore({ item });
+        });
+    }
+    d->indexItem(item);
 
     emit (isNew ? missionItemAdded(item) : missionItemChanged(item));
     if (isNew) this->fixMissionItemCount(item->missionId());
@@ -303,6 +411,47 @@ bool MissionService::save(const MissionAssignmentPtr& assignment)
     return true;
 }
 
+bool MissionService::save(const MissionItemPtrList& items)
+{
+    QMutexLocker locker(&d->mutex);
+
+    QList<bool> added;
+    for (const MissionItemPtr& item: items)
+    {
+        added.append(item->id() == 0);
+        item->clearSuperfluousParameters();
+    }
+
+    // New items need ids at once, updates only are stored by DB writer
+    if (added.contains(true))
+    {
+        if (!d->itemRepository.saveAll(items)) return false;
+    }
+    else
+    {
+        d->itemRepository.updateAllAsync(items, this, [this, items](bool ok) {
+            if (!ok) this->restore(items);
+        });
+    }
+    for (const MissionItemPtr& item: items) d->indexItem(item);
+
+    QList<int> resizedMissions;
+    for (int i = 0; i < items.count(); ++i)
+    {
+        const MissionItemPtr& item = items.at(i);
+        emit (added.at(i) ? missionItemAdded(item) : missionItemChanged(item));
+
+        if (added.at(i) && !resizedMissions.contains(item->missionId()))
+        {
+            resizedMissions.append(item->missionId());
+        }
+    }
+
+    for (int missionId: resizedMissions) this->fixMissionItemCount(missionId);
+
+    return true;
+}
+
 bool MissionService::remove(const MissionPtr& mission)
 {
     QMutexLocker locker(&d->mutex);
@@ -310,10 +459,7 @@ bool MissionService::remove(const MissionPtr& mission)
     MissionAssignmentPtr assignment = this->missionAssignment(mission->id());
     if (assignment && !this->remove(assignment)) return false;
 
-    for (const MissionItemPtr& item: this->missionItems(mission->id()))
-    {
-        if (!this->remove(item)) return false;
-    }
+    if (!this->remove(this->missionItems(mission->id()))) return false;
 
     if (!d->missionRepository.remove(mission)) return false;
 
@@ -329,12 +475,32 @@ bool MissionService::remove(const MissionItemPtr& item)
 
     // TODO: remove from current
     if (!d->itemRepository.remove(item)) return false;
+    d->unindexItem(item);
 
     this->fixMissionItemOrder(item->missionId());
     emit missionItemRemoved(item);
     return true;
 }
 
+bool MissionService::remove(const MissionItemPtrList& items)
+{
+    QMutexLocker locker(&d->mutex);
+
+    if (!d->itemRepository.removeAll(items)) return false;
+    for (const MissionItemPtr& item: items) d->unindexItem(item);
+
+    QList<int> missionIds;
+    for (const MissionItemPtr& item: items)
+    {
+        if (!missionIds.contains(item->missionId())) missionIds.append(item->missionId());
+    }
+
+    for (int missionId: missionIds) this->fixMissionItemOrder(missionId);
+    for (const MissionItemPtr& item: items) emit missionItemRemoved(item);
+
+    return true;
+}
+
 bool MissionService::remove(const MissionAssignmentPtr& assignment)
 {
     QMutexLocker locker(&d->mutex);
@@ -371,6 +537,7 @@ void MissionService::unload(const MissionItemPtr& item)
     QMutexLocker locker(&d->mutex);
 
     d->itemRepository.unload(item->id());
+    d->unindexItem(item);
 }
 
 void MissionService::unload(const MissionAssignmentPtr& assignment)
@@ -380,22 +547,37 @@ void MissionService::unload(const MissionAssignmentPtr& assignment)
     d->assignmentRepository.unload(assignment->id());
 }
 
+void MissionService::restore(const MissionItemPtrList& items)
+{
+    QMutexLocker locker(&d->mutex);
+
+    for (const MissionItemPtr& item: items)
+    {
+        if (d->itemRepository.read(item->id(), true).isNull()) continue;
+
+        d->indexItem(item);
+        emit missionItemChanged(item);
+    }
+}
+
 void MissionService::fixMissionItemOrder(int missionId)
 {
     QMutexLocker locker(&d->mutex);
 
     int counter = 0;
+    MissionItemPtrList changed;
     for (const MissionItemPtr& item : this->missionItems(missionId))
     {
         if (item->sequence() != counter)
         {
             item->setSequence(counter);
             item->setStatus(MissionItem::NotActual);
-            this->save(item);
+            changed.append(item);
         }
         counter++;
     }
 
+    this->save(changed);
     this->fixMissionItemCount(missionId);
 }
 
@@ -484,6 +666,9 @@ void MissionService::swapItems(const MissionItemPtr& first, const MissionItemPtr
     if (!d->itemRepository.save(first)) return;
     if (!d->itemRepository.save(second)) return;
 
+    d->indexItem(first);
+    d->indexItem(second);
+
     emit missionItemChanged(first);
     emit missionItemChanged(second);
 }
@@ -492,6 +677,9 @@ void MissionService::onVehicleChanged(const VehiclePtr& vehicle)
 {
     if (vehicle->isOnline()) return;
 
+    // Mission can be changed by another station while the vehicle is out of sight
+    this->resetVehicleItems(vehicle->id());
+
     dto::MissionAssignmentPtr assignment = this->vehicleAssignment(vehicle->id());
     if (assignment &&
         (assignment->status() == dto::MissionAssignment::Downloading ||
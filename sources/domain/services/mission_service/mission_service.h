@@ -3,6 +3,7 @@
 
 // Qt
 #include <QObject>
+#include <QVector>
 
 // Internal
 #include "dto_traits.h"
@@ -35,6 +36,15 @@ namespace domain
         dto::MissionItemPtr currentWaypoint(int vehicleId) const;
         int isCurrentForVehicle(const dto::MissionItemPtr& item) const;
 
+        // Content hash of the item as it is sent to a vehicle
+        static uint itemHash(const dto::MissionItemPtr& item);
+
+        // Hashes of the items, acknowledged by the vehicle last, empty if the state is unknown
+        QVector<uint> vehicleItemHashes(int vehicleId) const;
+        void setVehicleItemHashes(int vehicleId, const QVector<uint>& hashes);
+        void setVehicleItems(int vehicleId, const dto::MissionItemPtrList& items);
+        void resetVehicleItems(int vehicleId);
+
         dto::MissionItemPtr addNewMissionItem(int missionId,
                                               dto::MissionItem::Command command,
                                               int sequence,
@@ -44,16 +54,19 @@ namespace domain
         bool save(const dto::MissionPtr& mission);
         bool save(const dto::MissionItemPtr& item);
         bool save(const dto::MissionAssignmentPtr& assignment);
+        bool save(const dto::MissionItemPtrList& items); // In one transaction
 
         bool remove(const dto::MissionPtr& mission);
         bool remove(const dto::MissionItemPtr& item);
         bool remove(const dto::MissionAssignmentPtr& assignment);
+        bool remove(const dto::MissionItemPtrList& items);
 
 public slots:
         void unload(const dto::MissionPtr& mission);
         void unload(const dto::MissionItemPtr& item);
         void unload(const dto::MissionAssignmentPtr& assignment);
 
+        void restore(const dto::MissionItemPtrList& items); // Reloads stored state
         void fixMissionItemOrder(int missionId);
         void fixMissionItemCount(int missionId);
 
@@ -16,6 +16,7 @@ Telemetry* VehicleTelemetryFactory::create()
 {
     Telemetry* root = new Telemetry(Telemetry::Root);
 
+    new Telemetry(Telemetry::Flight, root);
     new Telemetry(Telemetry::System, root);
     new Telemetry(Telemetry::Position, root);
     new Telemetry(Telemetry::HomePosition, root);
@@ -23,6 +24,7 @@ Telemetry* VehicleTelemetryFactory::create()
     new Telemetry(Telemetry::Accel, ahrs);
     new Telemetry(Telemetry::Gyro, ahrs);
     new Telemetry(Telemetry::Compass, ahrs);
+    new Telemetry(Telemetry::Ekf, ahrs);
     new Telemetry(Telemetry::Satellite, root);
     new Telemetry(Telemetry::Barometric, root);
     new Telemetry(Telemetry::Pitot, root);
@@ -32,6 +34,7 @@ Telemetry* VehicleTelemetryFactory::create()
     new Telemetry(Telemetry::PowerSystem, root);
     new Telemetry(Telemetry::Battery, root);
     new Telemetry(Telemetry::Wind, root);
+    new Telemetry(Telemetry::LandingSystem, root);
 
     return root;
 }
@@ -0,0 +1,555 @@
+#include "telemetry_history.h"
+
+// Qt
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QFile>
+#include <QDir>
+#include <QHash>
+#include <QBitArray>
+#include <QDateTime>
+#include <QtEndian>
+#include <QDebug>
+
+// Internal
+#include "telemetry_schema.h"
+#include "time_series_codec.h"
+
+// Std
+#include <cstring>
+
+using namespace domain;
+
+namespace
+{
+    const char blockMagic[4] = { 'T', 'S', 'B', '1' };
+    // magic, vehicle, node, leaf, count, first and last times, sizes of time and value columns
+    const int headerSize = 40;
+
+    const QString fileSuffix = ".tsd";
+
+    const int maxBlockSamples = 1024;
+    const qint64 maxBlockSpan = 60000; // block of a rare series is written at least once a minute
+
+    int leafSlot(Telemetry::TelemetryId node, Telemetry::TelemetryId id)
+    {
+        int count = 0;
+        const telemetry_schema::Leaf* leaves = telemetry_schema::nodeLeaves(node, &count);
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (leaves[i].id == id) return leaves[i].slot;
+        }
+
+        return -1;
+    }
+
+    void decode(TimeSeriesDecoder& decoder, qint64 from, qint64 to,
+                QVector<TelemetryHistory::Sample>& samples)
+    {
+        TelemetryHistory::Sample sample;
+        while (decoder.next(&sample.time, &sample.value))
+        {
+            if (sample.time > to) break;
+            if (sample.time >= from) samples.append(sample);
+        }
+    }
+
+    // Appends sealed blocks to the session file, so disk latency never stalls the telemetry
+    class WriterThread: public QThread
+    {
+    public:
+        bool open(const QString& fileName)
+        {
+            m_file.setFileName(fileName);
+            return m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered);
+        }
+
+        void enqueue(const QByteArray& block)
+        {
+            QMutexLocker locker(&m_mutex);
+
+            m_blocks.enqueue(block);
+            m_wakeup.wakeOne();
+        }
+
+        // Queued blocks are written before the thread ends
+        void stop()
+        {
+            {
+                QMutexLocker locker(&m_mutex);
+
+                m_stopping = true;
+                m_wakeup.wakeOne();
+            }
+
+            this->wait();
+        }
+
+        qint64 written() const
+        {
+            QMutexLocker locker(&m_mutex);
+            return m_written;
+        }
+
+        bool isFailed() const
+        {
+            QMutexLocker locker(&m_mutex);
+            return m_failed;
+        }
+
+    protected:
+        void run() override
+        {
+            forever
+            {
+                QByteArray block;
+                {
+                    QMutexLocker locker(&m_mutex);
+
+                    while (m_blocks.isEmpty() && !m_stopping) m_wakeup.wait(&m_mutex);
+                    if (m_blocks.isEmpty()) return;
+
+                    block = m_blocks.dequeue();
+                }
+
+                bool ok = m_file.write(block) == block.size();
+
+                QMutexLocker locker(&m_mutex);
+                if (ok)
+                {
+                    m_written += block.size();
+                    continue;
+                }
+
+                // Partly written block breaks the file, so the session is not continued
+                qWarning() << "Can't write telemetry history" << m_file.errorString();
+                m_failed = true;
+                m_blocks.clear();
+                return;
+            }
+        }
+
+    private:
+        QFile m_file;
+
+        mutable QMutex m_mutex;
+        QWaitCondition m_wakeup;
+        QQueue<QByteArray> m_blocks;
+        qint64 m_written = 0;
+        bool m_failed = false;
+        bool m_stopping = false;
+    };
+}
+
+class TelemetryHistory::Impl
+{
+public:
+    struct File
+    {
+        QFile* file;
+        uchar* data;
+        qint64 mapped;
+    };
+
+    struct Block
+    {
+        int file;
+        qint64 offset; // of the time column
+        int count;
+        qint64 firstTime;
+        qint64 lastTime;
+        int timesSize;
+        int valuesSize;
+        QByteArray data; // whole block, until the writer thread puts it to the file
+    };
+
+    struct Series
+    {
+        TimeSeriesEncoder encoder; // open block
+        QVector<Block> archived; // of the earlier sessions, indexed on the first query
+        QVector<Block> blocks; // of the current session
+    };
+
+    // Block of the current session, which data is held until it is written
+    struct Unwritten
+    {
+        int vehicleId;
+        int slot;
+        int index;
+        qint64 end;
+    };
+
+    QString path;
+    QVector<File> files; // session file is the first one, then the archive ones
+    int session = -1;
+    qint64 sessionSize = 0;
+    QScopedPointer<WriterThread> writer;
+    QQueue<Unwritten> unwritten;
+
+    QStringList archive; // files of the earlier sessions, in time order
+    qint64 archiveSize = 0; // of the session file, if it was started in the same second
+    bool archiveIndexed = false;
+    int maxSessions = 0;
+
+    QBitArray recorded;
+    QHash<int, QVector<Series> > vehicleSeries; // series are indexed by schema slot
+
+    QVector<Series>& seriesOf(int vehicleId)
+    {
+        QVector<Series>& series = vehicleSeries[vehicleId];
+        if (series.isEmpty()) series.resize(telemetry_schema::SlotCount);
+        return series;
+    }
+
+    bool addFile(const QString& fileName)
+    {
+        QFile* file = new QFile(fileName);
+        if (!file->open(QIODevice::ReadOnly))
+        {
+            qWarning() << "Can't open telemetry history" << fileName;
+            delete file;
+            return false;
+        }
+
+        files.append({ file, nullptr, 0 });
+        return true;
+    }
+
+    // Names start with the session time, so blocks of a series are indexed in time order
+    void indexArchive()
+    {
+        if (archiveIndexed) return;
+        archiveIndexed = true;
+
+        for (const QString& fileName: archive)
+        {
+            if (!this->addFile(fileName)) continue;
+
+            int index = files.count() - 1;
+            this->indexFile(index, files[index].file->size());
+        }
+
+        if (archiveSize) this->indexFile(0, archiveSize);
+    }
+
+    // Only headers are read, columns are mapped when a query reaches them.
+    // Broken tail of the file, e.g. after crash, is skipped
+    void indexFile(int index, qint64 size)
+    {
+        QFile* file = files[index].file;
+
+        uchar header[::headerSize];
+        qint64 offset = 0;
+        while (offset + ::headerSize <= size)
+        {
+            if (!file->seek(offset) ||
+                file->read(reinterpret_cast<char*>(header), ::headerSize) != ::headerSize ||
+                std::memcmp(header, ::blockMagic, sizeof(::blockMagic))) break;
+
+            int vehicleId = qFromLittleEndian<qint32>(header + 4);
+            auto node = Telemetry::TelemetryId(qFromLittleEndian<quint16>(header + 8));
+            auto id = Telemetry::TelemetryId(qFromLittleEndian<quint16>(header + 10));
+
+            Block block;
+            block.file = index;
+            block.offset = offset + ::headerSize;
+            block.count = qFromLittleEndian<qint32>(header + 12);
+            block.firstTime = qFromLittleEndian<qint64>(header + 16);
+            block.lastTime = qFromLittleEndian<qint64>(header + 24);
+            block.timesSize = qFromLittleEndian<qint32>(header + 32);
+            block.valuesSize = qFromLittleEndian<qint32>(header + 36);
+
+            if (block.count < 0 || block.timesSize < 0 || block.valuesSize < 0) break;
+
+            qint64 end = block.offset + block.timesSize + block.valuesSize;
+            if (end > size) break;
+
+            // Leaves, removed from the schema, are skipped
+            int slot = ::leafSlot(node, id);
+            if (slot > -1) this->seriesOf(vehicleId)[slot].archived.append(block);
+
+            offset = end;
+        }
+    }
+
+    // Session file grows, so it is mapped again to reach the end
+    const uchar* map(int index, qint64 end)
+    {
+        File& file = files[index];
+        if (end <= file.mapped) return file.data;
+
+        if (file.data) file.file->unmap(file.data);
+
+        qint64 size = file.file->size();
+        file.data = size ? file.file->map(0, size) : nullptr;
+        file.mapped = file.data ? size : 0;
+
+        return end <= file.mapped ? file.data : nullptr;
+    }
+
+    // Time column of the block, held one or mapped from the file
+    const uchar* blockTimes(const Block& block)
+    {
+        if (!block.data.isEmpty())
+        {
+            return reinterpret_cast<const uchar*>(block.data.constData()) + ::headerSize;
+        }
+
+        const uchar* data = this->map(block.file,
+                                      block.offset + block.timesSize + block.valuesSize);
+        return data ? data + block.offset : nullptr;
+    }
+
+    // Written blocks are read from the file, so their data is not held anymore
+    void releaseWritten()
+    {
+        if (unwritten.isEmpty()) return;
+
+        qint64 written = writer->written();
+        while (!unwritten.isEmpty() && unwritten.head().end <= written)
+        {
+            Unwritten block = unwritten.dequeue();
+            auto it = vehicleSeries.find(block.vehicleId);
+            if (it != vehicleSeries.end()) it.value()[block.slot].blocks[block.index].data.clear();
+        }
+    }
+
+    void seal(int vehicleId, int slot, Series& series)
+    {
+        TimeSeriesEncoder& encoder = series.encoder;
+        if (!encoder.count() || session < 0) return;
+
+        if (writer->isFailed())
+        {
+            session = -1;
+            return;
+        }
+
+        const telemetry_schema::Leaf& leaf = telemetry_schema::slotLeaf(slot);
+        QByteArray times = encoder.times();
+        QByteArray values = encoder.values();
+
+        QByteArray data;
+        data.resize(::headerSize);
+
+        uchar* header = reinterpret_cast<uchar*>(data.data());
+        std::memcpy(header, ::blockMagic, sizeof(::blockMagic));
+        qToLittleEndian<qint32>(vehicleId, header + 4);
+        qToLittleEndian<quint16>(leaf.node, header + 8);
+        qToLittleEndian<quint16>(leaf.id, header + 10);
+        qToLittleEndian<qint32>(encoder.count(), header + 12);
+        qToLittleEndian<qint64>(encoder.firstTime(), header + 16);
+        qToLittleEndian<qint64>(encoder.lastTime(), header + 24);
+        qToLittleEndian<qint32>(times.size(), header + 32);
+        qToLittleEndian<qint32>(values.size(), header + 36);
+
+        data.append(times);
+        data.append(values);
+
+        Block block = { session, sessionSize + ::headerSize, encoder.count(),
+                        encoder.firstTime(), encoder.lastTime(), times.size(), values.size(),
+                        data };
+        encoder.clear();
+
+        sessionSize += data.size();
+        unwritten.enqueue({ vehicleId, slot, series.blocks.count(), sessionSize });
+        series.blocks.append(block);
+
+        writer->enqueue(data);
+        this->releaseWritten();
+    }
+
+    void removeOldSessions(const QDir& dir, QStringList& names)
+    {
+        if (maxSessions < 1) return;
+
+        // Current session is counted too
+        while (!names.isEmpty() && names.count() >= maxSessions)
+        {
+            QString name = names.takeFirst();
+            if (!dir.remove(name)) qWarning() << "Can't remove telemetry history" << name;
+        }
+    }
+};
+
+TelemetryHistory::TelemetryHistory():
+    d(new Impl())
+{
+    d->recorded.resize(telemetry_schema::SlotCount);
+}
+
+TelemetryHistory::~TelemetryHistory()
+{
+    this->close();
+}
+
+bool TelemetryHistory::open(const QString& path)
+{
+    this->close();
+
+    QDir dir(path);
+    if (!dir.exists() && !dir.mkpath(".")) return false;
+
+    QString sessionName = QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss") +
+                          ::fileSuffix;
+
+    QStringList names = dir.entryList({ "*" + ::fileSuffix }, QDir::Files, QDir::Name);
+    names.removeAll(sessionName);
+    d->removeOldSessions(dir, names);
+
+    d->writer.reset(new WriterThread());
+    if (!d->writer->open(dir.filePath(sessionName)) || !d->addFile(dir.filePath(sessionName)))
+    {
+        qWarning() << "Can't open telemetry history" << dir.filePath(sessionName);
+        this->close();
+        return false;
+    }
+
+    for (const QString& name: names) d->archive.append(dir.filePath(name));
+
+    d->session = 0;
+    d->sessionSize = d->files[d->session].file->size();
+    d->archiveSize = d->sessionSize;
+    d->path = path;
+    d->writer->start();
+    return true;
+}
+
+void TelemetryHistory::close()
+{
+    this->flush();
+
+    if (d->writer)
+    {
+        if (d->writer->isRunning()) d->writer->stop();
+        d->writer.reset();
+    }
+
+    for (Impl::File& file: d->files)
+    {
+        if (file.data) file.file->unmap(file.data);
+        delete file.file;
+    }
+
+    d->files.clear();
+    d->unwritten.clear();
+    d->archive.clear();
+    d->archiveSize = 0;
+    d->archiveIndexed = false;
+    d->vehicleSeries.clear();
+    d->session = -1;
+    d->sessionSize = 0;
+    d->path.clear();
+}
+
+bool TelemetryHistory::isOpen() const
+{
+    return d->session > -1;
+}
+
+QString TelemetryHistory::path() const
+{
+    return d->path;
+}
+
+int TelemetryHistory::maxSessions() const
+{
+    return d->maxSessions;
+}
+
+void TelemetryHistory::setMaxSessions(int maxSessions)
+{
+    d->maxSessions = maxSessions;
+}
+
+bool TelemetryHistory::isRecorded(int slot) const
+{
+    return d->recorded.testBit(slot);
+}
+
+void TelemetryHistory::setRecorded(int slot, bool recorded)
+{
+    if (telemetry_schema::slotLeaf(slot).type == telemetry_schema::Variant) return;
+
+    d->recorded.setBit(slot, recorded);
+}
+
+void TelemetryHistory::append(int vehicleId, const telemetry_schema::Leaf& leaf, double value,
+                              qint64 time)
+{
+    if (d->session < 0 || !d->recorded.testBit(leaf.slot)) return;
+
+    if (!time) time = QDateTime::currentMSecsSinceEpoch();
+
+    Impl::Series& series = d->seriesOf(vehicleId)[leaf.slot];
+    if (series.encoder.count() && time - series.encoder.firstTime() > ::maxBlockSpan)
+    {
+        d->seal(vehicleId, leaf.slot, series);
+    }
+
+    series.encoder.append(time, value);
+    if (series.encoder.count() >= ::maxBlockSamples) d->seal(vehicleId, leaf.slot, series);
+}
+
+QVector<TelemetryHistory::Sample> TelemetryHistory::query(int vehicleId,
+                                                          Telemetry::TelemetryId node,
+                                                          Telemetry::TelemetryId leaf,
+                                                          qint64 from, qint64 to) const
+{
+    QVector<Sample> samples;
+
+    int slot = ::leafSlot(node, leaf);
+    if (slot < 0) return samples;
+
+    d->indexArchive();
+
+    auto it = d->vehicleSeries.constFind(vehicleId);
+    if (it == d->vehicleSeries.constEnd()) return samples;
+
+    const Impl::Series& series = it.value().at(slot);
+    for (const QVector<Impl::Block>* blocks: { &series.archived, &series.blocks })
+    {
+        for (const Impl::Block& block: *blocks)
+        {
+            if (block.lastTime < from) continue;
+            if (block.firstTime > to) break;
+
+            const uchar* times = d->blockTimes(block);
+            if (!times) continue;
+
+            TimeSeriesDecoder decoder(times, block.timesSize, times + block.timesSize,
+                                      block.valuesSize, block.count, block.firstTime);
+            ::decode(decoder, from, to, samples);
+        }
+    }
+
+    const TimeSeriesEncoder& encoder = series.encoder;
+    if (encoder.count() && encoder.lastTime() >= from && encoder.firstTime() <= to)
+    {
+        QByteArray times = encoder.times();
+        QByteArray values = encoder.values();
+
+        TimeSeriesDecoder decoder(reinterpret_cast<const uchar*>(times.constData()), times.size(),
+                                  reinterpret_cast<const uchar*>(values.constData()),
+                                  values.size(), encoder.count(), encoder.firstTime());
+        ::decode(decoder, from, to, samples);
+    }
+
+    return samples;
+}
+
+void TelemetryHistory::flush()
+{
+    if (d->session < 0) return;
+
+    for (auto it = d->vehicleSeries.begin(); it != d->vehicleSeries.end(); ++it)
+    {
+        for (int slot = 0; slot < it.value().count(); ++slot)
+        {
+            d->seal(it.key(), slot, it.value()[slot]);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+// Qt
+#include <QScopedPointer>
+#include <QVector>
+
+// Internal
+#include "telemetry.h"
+
+namespace domain
+{
+    namespace telemetry_schema
+    {
+        struct Leaf;
+    }
+
+    // Append-only store of the numeric and boolean schema leaves, a series per vehicle and leaf.
+    // Samples are collected into Gorilla-compressed blocks in memory, full blocks are appended to
+    // the session file of the history directory by the writer thread. Block is a little-endian
+    // header and columns of times and values. Files of earlier sessions are indexed on the first
+    // query and read through memory mapping, queries never touch the data base. Used from the
+    // thread of telemetry nodes only.
+    class TelemetryHistory
+    {
+    public:
+        struct Sample
+        {
+            qint64 time; // milliseconds since epoch
+            double value;
+        };
+
+        TelemetryHistory();
+        ~TelemetryHistory();
+
+        // Starts a new session file, oldest session files over the limit are removed
+        bool open(const QString& path);
+        void close();
+        bool isOpen() const;
+
+        QString path() const;
+
+        // Sessions kept in the directory with the current one, zero keeps all of them
+        int maxSessions() const;
+        void setMaxSessions(int maxSessions);
+
+        // Nothing is recorded by default, only Number and Bool leaves can be
+        bool isRecorded(int slot) const;
+        void setRecorded(int slot, bool recorded);
+
+        // Values are dropped if history is not open, zero time is the current one
+        void append(int vehicleId, const telemetry_schema::Leaf& leaf, double value,
+                    qint64 time = 0);
+
+        // Samples of the leaf within the inclusive time window, in time order
+        QVector<Sample> query(int vehicleId, Telemetry::TelemetryId node,
+                              Telemetry::TelemetryId leaf, qint64 from, qint64 to) const;
+
+        // Queues incomplete blocks for writing, next samples start new blocks
+        void flush();
+
+    private:
+        class Impl;
+        QScopedPointer<Impl> const d;
+
+        Q_DISABLE_COPY(TelemetryHistory)
+    };
+}
+
+#endif // TELEMETRY_HISTORY_H
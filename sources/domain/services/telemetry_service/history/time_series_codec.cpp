@@ -0,0 +1,275 @@
+#include "time_series_codec.h"
+
+// Qt
+#include <QtAlgorithms>
+
+// Std
+#include <cstring>
+
+using namespace domain;
+
+namespace
+{
+    const int valueBits = 64;
+    const int maxLeading = 31; // fits 5 bits
+
+    inline quint64 mask(int bits)
+    {
+        return bits >= 64 ? ~quint64(0) : (quint64(1) << bits) - 1;
+    }
+
+    inline quint64 toBits(double value)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline double fromBits(quint64 bits)
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+TimeSeriesEncoder::TimeSeriesEncoder()
+{
+    this->clear();
+}
+
+int TimeSeriesEncoder::count() const
+{
+    return m_count;
+}
+
+qint64 TimeSeriesEncoder::firstTime() const
+{
+    return m_firstTime;
+}
+
+qint64 TimeSeriesEncoder::lastTime() const
+{
+    return m_lastTime;
+}
+
+void TimeSeriesEncoder::append(qint64 time, double value)
+{
+    quint64 bits = ::toBits(value);
+
+    // First sample goes as is, time is kept aside in the block header
+    if (!m_count)
+    {
+        m_firstTime = m_lastTime = time;
+        m_values.write(bits, ::valueBits);
+        m_lastValue = bits;
+        m_count = 1;
+        return;
+    }
+
+    time = qMax(time, m_lastTime);
+    qint64 delta = time - m_lastTime;
+    qint64 deltaOfDelta = delta - m_lastDelta;
+
+    if (deltaOfDelta == 0)
+    {
+        m_times.write(0, 1);
+    }
+    else if (deltaOfDelta >= -63 && deltaOfDelta <= 64)
+    {
+        m_times.write(0x2, 2);
+        m_times.write(quint64(deltaOfDelta + 63), 7);
+    }
+    else if (deltaOfDelta >= -255 && deltaOfDelta <= 256)
+    {
+        m_times.write(0x6, 3);
+        m_times.write(quint64(deltaOfDelta + 255), 9);
+    }
+    else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048)
+    {
+        m_times.write(0xE, 4);
+        m_times.write(quint64(deltaOfDelta + 2047), 12);
+    }
+    else
+    {
+        m_times.write(0xF, 4);
+        m_times.write(quint64(deltaOfDelta), 64);
+    }
+
+    quint64 xored = bits ^ m_lastValue;
+    if (!xored)
+    {
+        m_values.write(0, 1);
+    }
+    else
+    {
+        int leading = qMin(int(qCountLeadingZeroBits(xored)), ::maxLeading);
+        int trailing = int(qCountTrailingZeroBits(xored));
+
+        // Meaningful bits are inside the previous window, so the window is not repeated
+        if (m_leading >= 0 && leading >= m_leading && trailing >= m_trailing)
+        {
+            m_values.write(0x2, 2);
+            m_values.write(xored >> m_trailing, ::valueBits - m_leading - m_trailing);
+        }
+        else
+        {
+            int meaningful = ::valueBits - leading - trailing;
+
+            m_values.write(0x3, 2);
+            m_values.write(quint64(leading), 5);
+            m_values.write(quint64(meaningful - 1), 6);
+            m_values.write(xored >> trailing, meaningful);
+
+            m_leading = leading;
+            m_trailing = trailing;
+        }
+    }
+
+    m_lastTime = time;
+    m_lastDelta = delta;
+    m_lastValue = bits;
+    m_count++;
+}
+
+void TimeSeriesEncoder::clear()
+{
+    m_times.clear();
+    m_values.clear();
+    m_count = 0;
+    m_firstTime = 0;
+    m_lastTime = 0;
+    m_lastDelta = 0;
+    m_lastValue = 0;
+    m_leading = -1;
+    m_trailing = 0;
+}
+
+QByteArray TimeSeriesEncoder::times() const
+{
+    return m_times.bytes();
+}
+
+QByteArray TimeSeriesEncoder::values() const
+{
+    return m_values.bytes();
+}
+
+void TimeSeriesEncoder::BitWriter::write(quint64 value, int bits)
+{
+    value &= ::mask(bits);
+
+    int free = 64 - m_pendingBits;
+    if (bits < free)
+    {
+        m_pending = (m_pending << bits) | value;
+        m_pendingBits += bits;
+        return;
+    }
+
+    // Whole word is moved to the data, most significant bits first
+    int rest = bits - free;
+    quint64 word = m_pendingBits ? (m_pending << free) | (value >> rest) : value >> rest;
+    for (int shift = 56; shift >= 0; shift -= 8) m_data.append(char(word >> shift));
+
+    m_pending = value & ::mask(rest);
+    m_pendingBits = rest;
+}
+
+QByteArray TimeSeriesEncoder::BitWriter::bytes() const
+{
+    QByteArray bytes = m_data;
+    if (!m_pendingBits) return bytes;
+
+    quint64 word = m_pending << (64 - m_pendingBits);
+    for (int i = 0; i < (m_pendingBits + 7) / 8; ++i) bytes.append(char(word >> (56 - i * 8)));
+
+    return bytes;
+}
+
+void TimeSeriesEncoder::BitWriter::clear()
+{
+    m_data.clear();
+    m_pending = 0;
+    m_pendingBits = 0;
+}
+
+TimeSeriesDecoder::TimeSeriesDecoder(const uchar* times, int timesSize, const uchar* values,
+                                     int valuesSize, int count, qint64 firstTime):
+    m_times(times, timesSize),
+    m_values(values, valuesSize),
+    m_left(count),
+    m_index(0),
+    m_lastTime(firstTime),
+    m_lastDelta(0),
+    m_lastValue(0),
+    m_leading(0),
+    m_trailing(0)
+{}
+
+bool TimeSeriesDecoder::next(qint64* time, double* value)
+{
+    if (m_left <= 0) return false;
+
+    if (m_index)
+    {
+        qint64 deltaOfDelta;
+        if (!m_times.read(1)) deltaOfDelta = 0;
+        else if (!m_times.read(1)) deltaOfDelta = qint64(m_times.read(7)) - 63;
+        else if (!m_times.read(1)) deltaOfDelta = qint64(m_times.read(9)) - 255;
+        else if (!m_times.read(1)) deltaOfDelta = qint64(m_times.read(12)) - 2047;
+        else deltaOfDelta = qint64(m_times.read(64));
+
+        m_lastDelta += deltaOfDelta;
+        m_lastTime += m_lastDelta;
+
+        if (m_values.read(1))
+        {
+            if (m_values.read(1))
+            {
+                m_leading = int(m_values.read(5));
+                m_trailing = ::valueBits - m_leading - int(m_values.read(6)) - 1;
+            }
+
+            int meaningful = ::valueBits - m_leading - m_trailing;
+            m_lastValue ^= m_values.read(meaningful) << m_trailing;
+        }
+    }
+    else
+    {
+        m_lastValue = m_values.read(::valueBits);
+    }
+
+    *time = m_lastTime;
+    *value = ::fromBits(m_lastValue);
+
+    m_index++;
+    m_left--;
+    return true;
+}
+
+TimeSeriesDecoder::BitReader::BitReader(const uchar* data, int size):
+    m_data(data),
+    m_bitCount(qint64(size) * 8)
+{}
+
+quint64 TimeSeriesDecoder::BitReader::read(int bits)
+{
+    quint64 value = 0;
+
+    while (bits > 0)
+    {
+        // Broken block is read as zeros instead of going out of data
+        if (m_position >= m_bitCount) return bits < 64 ? value << bits : 0;
+
+        int offset = int(m_position & 7);
+        int take = qMin(8 - offset, bits);
+        quint8 byte = m_data[m_position >> 3];
+
+        value = (value << take) | ((byte >> (8 - offset - take)) & ::mask(take));
+        m_position += take;
+        bits -= take;
+    }
+
+    return value;
+}
@@ -0,0 +1,89 @@
+#ifndef TIME_SERIES_CODEC_H
+#define TIME_SERIES_CODEC_H
+
+// Qt
+#include <QByteArray>
+
+namespace domain
+{
+    // Gorilla compression of one series block. Columns are separate bit streams: timestamps are
+    // delta-of-delta coded, values are XOR with the previous one. Regular sampling of the slowly
+    // changing value takes about two bits per sample.
+    class TimeSeriesEncoder
+    {
+    public:
+        TimeSeriesEncoder();
+
+        int count() const;
+        qint64 firstTime() const;
+        qint64 lastTime() const;
+
+        // Time is milliseconds, earlier time is clamped to the last one
+        void append(qint64 time, double value);
+        void clear();
+
+        // Streams are padded with zero bits to the whole byte
+        QByteArray times() const;
+        QByteArray values() const;
+
+    private:
+        class BitWriter
+        {
+        public:
+            void write(quint64 value, int bits);
+            QByteArray bytes() const;
+            void clear();
+
+        private:
+            QByteArray m_data;
+            quint64 m_pending = 0;
+            int m_pendingBits = 0;
+        };
+
+        BitWriter m_times;
+        BitWriter m_values;
+        int m_count;
+        qint64 m_firstTime;
+        qint64 m_lastTime;
+        qint64 m_lastDelta;
+        quint64 m_lastValue;
+        int m_leading;
+        int m_trailing;
+    };
+
+    class TimeSeriesDecoder
+    {
+    public:
+        // Data must stay valid while decoding, e.g. mapped file of the block
+        TimeSeriesDecoder(const uchar* times, int timesSize, const uchar* values, int valuesSize,
+                          int count, qint64 firstTime);
+
+        bool next(qint64* time, double* value);
+
+    private:
+        class BitReader
+        {
+        public:
+            BitReader(const uchar* data, int size);
+
+            quint64 read(int bits);
+
+        private:
+            const uchar* const m_data;
+            const qint64 m_bitCount;
+            qint64 m_position = 0;
+        };
+
+        BitReader m_times;
+        BitReader m_values;
+        int m_left;
+        int m_index;
+        qint64 m_lastTime;
+        qint64 m_lastDelta;
+        quint64 m_lastValue;
+        int m_leading;
+        int m_trailing;
+    };
+}
+
+#endif // TIME_SERIES_CODEC_H
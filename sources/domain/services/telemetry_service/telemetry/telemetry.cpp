@@ -1,15 +1,26 @@
 #include "telemetry.h"
 
 // Qt
+#include <QMetaMethod>
 #include <QDebug>
 
+// Internal
+#include "telemetry_store.h"
+#include "telemetry_notifier.h"
+#include "telemetry_history.h"
+#include "latency_monitor.h"
+
 using namespace domain;
 
 Telemetry::Telemetry(TelemetryId id, Telemetry* parentNode):
     QObject(parentNode),
     m_id(id),
-    m_parentNode(parentNode)
+    m_parentNode(parentNode),
+    m_ownStore(parentNode ? nullptr : new TelemetryStore()),
+    m_store(parentNode ? parentNode->m_store : m_ownStore.data())
 {
+    m_leaves = telemetry_schema::nodeLeaves(id, &m_leafCount);
+
     if (parentNode) parentNode->addChildNode(this);
 }
 
@@ -25,12 +36,46 @@ Telemetry::TelemetryId Telemetry::id() const
 
 QVariant Telemetry::parameter(TelemetryId id) const
 {
+    const telemetry_schema::Leaf* leaf = this->leaf(id);
+    if (leaf && m_store->contains(*leaf)) return m_store->value(*leaf);
+
     return m_parameters.value(id);
 }
 
 Telemetry::TelemetryMap Telemetry::parameters() const
 {
-    return m_parameters;
+    TelemetryMap parameters = m_parameters;
+
+    for (int i = 0; i < m_leafCount; ++i)
+    {
+        if (m_store->contains(m_leaves[i])) parameters[m_leaves[i].id] = m_store->value(m_leaves[i]);
+    }
+
+    return parameters;
+}
+
+bool Telemetry::hasParameter(TelemetryId id) const
+{
+    const telemetry_schema::Leaf* leaf = this->leaf(id);
+    if (leaf && m_store->contains(*leaf)) return true;
+
+    return m_parameters.contains(id);
+}
+
+bool Telemetry::boolParameter(TelemetryId id) const
+{
+    const telemetry_schema::Leaf* leaf = this->leaf(id);
+    if (leaf && m_store->contains(*leaf)) return m_store->boolValue(*leaf);
+
+    return m_parameters.value(id).toBool();
+}
+
+double Telemetry::realParameter(TelemetryId id) const
+{
+    const telemetry_schema::Leaf* leaf = this->leaf(id);
+    if (leaf && m_store->contains(*leaf)) return m_store->realValue(*leaf);
+
+    return m_parameters.value(id).toDouble();
 }
 
 QList<Telemetry::TelemetryId> Telemetry::changedParameterKeys() const
@@ -45,7 +90,7 @@ Telemetry::TelemetryMap Telemetry::takeChangedParameters()
     while (!m_changedParameters.isEmpty())
     {
         TelemetryId key = m_changedParameters.takeFirst();
-        parameters[key] = m_parameters[key];
+        parameters[key] = this->parameter(key);
     }
 
     return parameters;
@@ -84,12 +129,85 @@ QList<Telemetry*> Telemetry::childNodes() const
     return m_childNodes.values();
 }
 
+Telemetry* Telemetry::findChildNode(TelemetryId id) const
+{
+    return m_childNodes.value(id, nullptr);
+}
+
+Telemetry* Telemetry::findChildNode(const TelemetryList& path) const
+{
+    const Telemetry* node = this;
+
+    for (TelemetryId id: path)
+    {
+        node = node->findChildNode(id);
+        if (!node) return nullptr;
+    }
+
+    return const_cast<Telemetry*>(node);
+}
+
+TelemetryPipeline* Telemetry::pipeline() const
+{
+    return m_parentNode ? m_parentNode->pipeline() : m_pipeline;
+}
+
+void Telemetry::setPipeline(TelemetryPipeline* pipeline)
+{
+    m_pipeline = pipeline;
+}
+
+TelemetryNotifier* Telemetry::notifier() const
+{
+    return m_parentNode ? m_parentNode->notifier() : m_notifier;
+}
+
+void Telemetry::setNotifier(TelemetryNotifier* notifier)
+{
+    m_notifier = notifier;
+}
+
+TelemetryHistory* Telemetry::history() const
+{
+    return m_parentNode ? m_parentNode->history() : m_history;
+}
+
+void Telemetry::setHistory(TelemetryHistory* history, int vehicleId)
+{
+    m_history = history;
+    m_historyId = vehicleId;
+}
+
 void Telemetry::setParameter(TelemetryId key, const QVariant& value)
 {
-    if (m_parameters.contains(key) && m_parameters[key] == value) return;
+    const telemetry_schema::Leaf* leaf = this->leaf(key);
 
-    m_parameters[key] = value;
-    m_changedParameters.append(key);
+    if (leaf && TelemetryStore::accepts(*leaf, value))
+    {
+        // Repeated values are recorded too, they keep the sampling regular
+        if (leaf->type != telemetry_schema::Variant)
+        {
+            const Telemetry* root = this;
+            while (root->m_parentNode) root = root->m_parentNode;
+
+            if (root->m_history) root->m_history->append(root->m_historyId, *leaf,
+                                                         value.toDouble());
+        }
+
+        if (!m_store->setValue(*leaf, value)) return;
+
+        if (!m_parameters.isEmpty()) m_parameters.remove(key);
+    }
+    else
+    {
+        if (m_parameters.contains(key) && m_parameters[key] == value) return;
+
+        if (leaf) m_store->reset(*leaf);
+        m_parameters[key] = value;
+    }
+
+    // Changes are coalesced until publishing, the key is kept once
+    if (!m_changedParameters.contains(key)) m_changedParameters.append(key);
 }
 
 void Telemetry::setParameter(const TelemetryList& path, const QVariant& value)
@@ -113,8 +231,18 @@ void Telemetry::notify()
 
     if (m_changedParameters.empty()) return;
 
-    emit parametersChanged(this->takeChangedParameters());
-    emit parametersUpdated(this->parameters());
+    qint64 origin = utils::LatencyMonitor::origin();
+    if (origin && (!m_origin || origin < m_origin)) m_origin = origin;
+
+    TelemetryNotifier* notifier = this->notifier();
+    if (notifier && notifier->interval() > 0)
+    {
+        notifier->schedule(this);
+    }
+    else
+    {
+        this->publish();
+    }
 }
 
 void Telemetry::addChildNode(Telemetry* childNode)
@@ -127,3 +255,29 @@ void Telemetry::removeChildNode(Telemetry* childNode)
     m_childNodes.remove(childNode->id());
 }
 
+void Telemetry::publish()
+{
+    if (m_changedParameters.empty()) return;
+
+    qint64 origin = m_origin;
+    m_origin = 0;
+    utils::LatencyMonitor::record(utils::LatencyMonitor::TelemetryNotify, origin);
+
+    utils::LatencyScope scope(origin);
+    emit parametersChanged(this->takeChangedParameters());
+
+    // Full copy of the node is built only for its listeners
+    static const QMetaMethod updatedSignal = QMetaMethod::fromSignal(&Telemetry::parametersUpdated);
+    if (this->isSignalConnected(updatedSignal)) emit parametersUpdated(this->parameters());
+}
+
+const telemetry_schema::Leaf* Telemetry::leaf(TelemetryId id) const
+{
+    for (int i = 0; i < m_leafCount; ++i)
+    {
+        if (m_leaves[i].id == id) return &m_leaves[i];
+    }
+
+    return nullptr;
+}
+
@@ -4,6 +4,7 @@
 //Internal
 #include <QObject>
 #include <QMap>
+#include <QScopedPointer>
 
 // TODO: unit support
 
@@ -140,6 +141,16 @@
 
 namespace domain
 {
+    class TelemetryPipeline;
+    class TelemetryNotifier;
+    class TelemetryStore;
+    class TelemetryHistory;
+
+    namespace telemetry_schema
+    {
+        struct Leaf;
+    }
+
     class Telemetry: public QObject
     {
         Q_OBJECT
@@ -269,6 +280,11 @@ namespace domain
         QVariant parameter(TelemetryId id) const;
         TelemetryMap parameters() const;
 
+        // Typed access to the schema leaves without boxing to QVariant
+        bool hasParameter(TelemetryId id) const;
+        bool boolParameter(TelemetryId id) const;
+        double realParameter(TelemetryId id) const;
+
         QList<TelemetryId> changedParameterKeys() const;
         TelemetryMap takeChangedParameters();
 
@@ -277,6 +293,22 @@ namespace domain
         Telemetry* childNode(const TelemetryList& path);
         QList<Telemetry*> childNodes() const;
 
+        // Unlike childNode, never creates nodes
+        Telemetry* findChildNode(TelemetryId id) const;
+        Telemetry* findChildNode(const TelemetryList& path) const;
+
+        // Pipeline of the root node, portions are delivered with it
+        TelemetryPipeline* pipeline() const;
+        void setPipeline(TelemetryPipeline* pipeline);
+
+        // Notifier of the root node, without it changes are published at once
+        TelemetryNotifier* notifier() const;
+        void setNotifier(TelemetryNotifier* notifier);
+
+        // History of the root node, recorded leaves are appended on every set
+        TelemetryHistory* history() const;
+        void setHistory(TelemetryHistory* history, int vehicleId);
+
     public slots:
         void setParameter(TelemetryId id, const QVariant& value);
         void setParameter(const TelemetryList& path, const QVariant& value);
@@ -291,12 +323,27 @@ namespace domain
         void removeChildNode(Telemetry* childNode);
 
     private:
+        friend class TelemetryNotifier;
+
+        const telemetry_schema::Leaf* leaf(TelemetryId id) const;
+        void publish();
+
         const TelemetryId m_id;
-        TelemetryMap m_parameters;
+        TelemetryMap m_parameters; // Parameters out of the schema
         TelemetryList m_changedParameters;
 
         Telemetry* const m_parentNode;
+        QScopedPointer<TelemetryStore> m_ownStore;
+        TelemetryStore* const m_store; // Store of the root node
+        const telemetry_schema::Leaf* m_leaves;
+        int m_leafCount;
         QMap<TelemetryId, Telemetry*> m_childNodes;
+        TelemetryPipeline* m_pipeline = nullptr;
+        TelemetryNotifier* m_notifier = nullptr;
+        TelemetryHistory* m_history = nullptr;
+        int m_historyId = 0;
+        int m_notifyIndex = -1;
+        qint64 m_origin = 0; // Latency origin of the oldest unpublished change
 
         Q_ENUM(TelemetryId)
     };
@@ -0,0 +1,67 @@
+#include "telemetry_notifier.h"
+
+// Internal
+#include "telemetry.h"
+
+using namespace domain;
+
+TelemetryNotifier::TelemetryNotifier(int interval, QObject* parent):
+    QObject(parent),
+    m_interval(interval),
+    m_flushes(0)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &TelemetryNotifier::flush);
+}
+
+TelemetryNotifier::~TelemetryNotifier()
+{}
+
+int TelemetryNotifier::interval() const
+{
+    return m_interval;
+}
+
+quint64 TelemetryNotifier::flushes() const
+{
+    return m_flushes;
+}
+
+void TelemetryNotifier::schedule(Telemetry* node)
+{
+    if (node->m_notifyIndex < 0)
+    {
+        node->m_notifyIndex = m_nodes.count();
+        m_nodes.append(node);
+        m_dirty.resize(m_nodes.count());
+    }
+
+    m_dirty.setBit(node->m_notifyIndex);
+
+    if (m_timer.isActive()) return;
+
+    // First change after a pause is published without waiting a whole interval
+    qint64 elapsed = m_lastFlush.isValid() ? m_lastFlush.elapsed() : m_interval;
+    m_timer.start(qMax<qint64>(0, m_interval - elapsed));
+}
+
+void TelemetryNotifier::setInterval(int interval)
+{
+    m_interval = interval;
+    if (!interval) this->flush();
+}
+
+void TelemetryNotifier::flush()
+{
+    m_timer.stop();
+    m_lastFlush.start();
+    ++m_flushes;
+
+    for (int index = 0; index < m_dirty.size(); ++index)
+    {
+        if (!m_dirty.testBit(index)) continue;
+
+        m_dirty.clearBit(index);
+        if (m_nodes.at(index)) m_nodes.at(index)->publish();
+    }
+}
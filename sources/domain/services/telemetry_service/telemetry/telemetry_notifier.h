@@ -0,0 +1,46 @@
+#ifndef TELEMETRY_NOTIFIER_H
+#define TELEMETRY_NOTIFIER_H
+
+// Qt
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <QBitArray>
+#include <QTimer>
+#include <QElapsedTimer>
+
+namespace domain
+{
+    class Telemetry;
+
+    // Coalesces notifications of the tree nodes: changed nodes are marked in a dirty mask and
+    // are published together not more often than once per interval
+    class TelemetryNotifier: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit TelemetryNotifier(int interval = 0, QObject* parent = nullptr);
+        ~TelemetryNotifier() override;
+
+        // Zero interval means nodes are published at once
+        int interval() const;
+        quint64 flushes() const;
+
+        void schedule(Telemetry* node);
+
+    public slots:
+        void setInterval(int interval);
+        void flush();
+
+    private:
+        int m_interval;
+        quint64 m_flushes;
+        QVector<QPointer<Telemetry> > m_nodes; // indexed by node notify index
+        QBitArray m_dirty;
+        QTimer m_timer;
+        QElapsedTimer m_lastFlush;
+    };
+}
+
+#endif // TELEMETRY_NOTIFIER_H
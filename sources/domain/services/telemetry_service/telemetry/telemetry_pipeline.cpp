@@ -0,0 +1,245 @@
+#include "telemetry_pipeline.h"
+
+// Qt
+#include <QThread>
+#include <QDebug>
+
+// Internal
+#include "latency_monitor.h"
+
+// Std
+#include <algorithm>
+
+namespace
+{
+    quint32 roundUpToPowerOfTwo(int value)
+    {
+        quint32 result = 1;
+        while (result < quint32(qMax(value, 2))) result <<= 1;
+        return result;
+    }
+
+    bool isSamePath(const domain::TelemetryEntry& first, const domain::TelemetryEntry& second)
+    {
+        if (first.depth != second.depth) return false;
+
+        for (int i = 0; i < first.depth; ++i)
+        {
+            if (first.path[i] != second.path[i]) return false;
+        }
+
+        return true;
+    }
+}
+
+using namespace domain;
+
+TelemetryEntry::TelemetryEntry():
+    depth(0)
+{}
+
+TelemetryEntry::TelemetryEntry(const Telemetry::TelemetryList& path, const QVariant& value):
+    depth(qMin(path.count(), int(maxDepth))),
+    value(value)
+{
+    if (path.count() > maxDepth) qWarning() << "Telemetry path is too deep" << path;
+
+    for (int i = 0; i < depth; ++i) this->path[i] = path.at(i);
+}
+
+TelemetryPipeline::TelemetryPipeline(int capacity, QObject* parent):
+    QObject(parent),
+    m_mask(::roundUpToPowerOfTwo(capacity) - 1),
+    m_records(new Record[m_mask + 1]),
+    m_head(0),
+    m_tail(0),
+    m_drainRequested(0),
+    m_wakeups(0),
+    m_drains(0),
+    m_coalesced(0),
+    m_producer(nullptr),
+    m_overflowed(0)
+{}
+
+TelemetryPipeline::~TelemetryPipeline()
+{}
+
+int TelemetryPipeline::capacity() const
+{
+    return m_mask + 1;
+}
+
+quint64 TelemetryPipeline::wakeups() const
+{
+    return m_wakeups.load();
+}
+
+quint64 TelemetryPipeline::drains() const
+{
+    return m_drains.load();
+}
+
+quint64 TelemetryPipeline::coalesced() const
+{
+    return m_coalesced.load();
+}
+
+void TelemetryPipeline::setProducer(QThread* producer)
+{
+    m_producer.store(producer);
+}
+
+void TelemetryPipeline::push(Telemetry* node, const TelemetryEntry* entries, int count,
+                             qint64 origin)
+{
+    Q_ASSERT_X(this->isProducerThread(), "TelemetryPipeline::push",
+               "pipeline has the single producer thread");
+
+    quint32 head = m_head.load();
+
+    // Ring is full or older portions are still in the overflow
+    if (m_overflowed.loadAcquire() || head - m_tail.loadAcquire() > m_mask)
+    {
+        this->overflow(node, entries, count, origin);
+        if (m_drainRequested.testAndSetOrdered(0, 1)) this->wakeUp();
+        return;
+    }
+
+    Record& record = m_records[head & m_mask];
+    record.node = node;
+    record.origin = origin;
+    record.entries.clear();
+    for (int i = 0; i < count; ++i) record.entries.append(entries[i]);
+
+    m_head.storeRelease(head + 1);
+
+    if (m_drainRequested.testAndSetOrdered(0, 1)) this->wakeUp();
+}
+
+void TelemetryPipeline::apply(Telemetry* node, const TelemetryEntry* entries, int count,
+                              qint64 origin)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const TelemetryEntry& entry = entries[i];
+        if (!entry.depth) continue;
+
+        Telemetry* target = node;
+        for (int level = 0; level < entry.depth - 1; ++level)
+        {
+            target = target->childNode(entry.path[level]);
+        }
+
+        target->setParameter(entry.path[entry.depth - 1], entry.value);
+    }
+
+    utils::LatencyMonitor::record(utils::LatencyMonitor::PortionDelivery, origin);
+
+    utils::LatencyScope scope(origin);
+    node->notify();
+}
+
+bool TelemetryPipeline::isProducerThread()
+{
+    QThread* current = QThread::currentThread();
+
+    m_producer.testAndSetRelaxed(nullptr, current);
+    return m_producer.load() == current;
+}
+
+void TelemetryPipeline::overflow(Telemetry* node, const TelemetryEntry* entries, int count,
+                                 qint64 origin)
+{
+    QMutexLocker locker(&m_overflowMutex);
+
+    auto it = std::find_if(m_overflow.begin(), m_overflow.end(),
+                           [node](const Record& record) { return record.node == node; });
+    if (it == m_overflow.end())
+    {
+        Record record;
+        record.node = node;
+        record.origin = origin;
+        for (int i = 0; i < count; ++i) record.entries.append(entries[i]);
+
+        m_overflow.append(record);
+        m_overflowed.storeRelease(1);
+        return;
+    }
+
+    // Later values replace earlier ones, latency is counted from the oldest portion
+    for (int i = 0; i < count; ++i)
+    {
+        auto entry = std::find_if(it->entries.begin(), it->entries.end(),
+                                  [&](const TelemetryEntry& other) {
+            return ::isSamePath(other, entries[i]);
+        });
+
+        if (entry != it->entries.end()) entry->value = entries[i].value;
+        else it->entries.append(entries[i]);
+    }
+
+    if (!it->origin) it->origin = origin;
+    m_coalesced.fetchAndAddRelaxed(1);
+}
+
+void TelemetryPipeline::drainOverflow()
+{
+    QVector<Record> records;
+    {
+        QMutexLocker locker(&m_overflowMutex);
+
+        records.swap(m_overflow);
+        m_overflowed.storeRelease(0);
+    }
+
+    for (const Record& record: records)
+    {
+        if (!record.node) continue;
+
+        TelemetryPipeline::apply(record.node, record.entries.constData(),
+                                 record.entries.count(), record.origin);
+    }
+}
+
+void TelemetryPipeline::wakeUp()
+{
+    m_wakeups.fetchAndAddRelaxed(1);
+    QMetaObject::invokeMethod(this, "drain", Qt::QueuedConnection);
+}
+
+void TelemetryPipeline::drain()
+{
+    // Full barrier: records, pushed without wake up, must be visible below
+    m_drainRequested.fetchAndStoreOrdered(0);
+    m_drains.fetchAndAddRelaxed(1);
+
+    quint32 tail = m_tail.load();
+    quint32 head = m_head.loadAcquire();
+
+    forever
+    {
+        while (tail != head)
+        {
+            Record& record = m_records[tail & m_mask];
+            if (record.node)
+            {
+                TelemetryPipeline::apply(record.node, record.entries.constData(),
+                                         record.entries.count(), record.origin);
+            }
+            record.node.clear();
+
+            m_tail.storeRelease(++tail);
+            if (tail == head) head = m_head.loadAcquire();
+        }
+
+        if (!m_overflowed.loadAcquire()) return;
+
+        // Producer doesn't use the ring while the overflow is not empty. Records, pushed before
+        // the overflow, are visible with it and go first to keep the order of values.
+        head = m_head.loadAcquire();
+        if (tail != head) continue;
+
+        this->drainOverflow();
+        return;
+    }
+}
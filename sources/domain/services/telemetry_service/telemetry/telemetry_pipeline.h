@@ -0,0 +1,93 @@
+#ifndef TELEMETRY_PIPELINE_H
+#define TELEMETRY_PIPELINE_H
+
+// Qt
+#include <QPointer>
+#include <QVector>
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QScopedArrayPointer>
+#include <QMutex>
+
+// Internal
+#include "telemetry.h"
+
+namespace domain
+{
+    // Telemetry value with a path relative to the portion node, path is never deeper than tree
+    class TelemetryEntry
+    {
+    public:
+        static const int maxDepth = 4;
+
+        TelemetryEntry();
+        TelemetryEntry(const Telemetry::TelemetryList& path, const QVariant& value);
+
+        Telemetry::TelemetryId path[maxDepth];
+        int depth;
+        QVariant value;
+    };
+
+    // Single producer/single consumer ring of decoded portions. Producer is the thread, where
+    // portions are decoded, consumer is the thread of telemetry nodes. Whole portion moves as one
+    // record and consumer is woken once per drain instead of queued signal per parameter.
+    // Producer never waits: while the ring is full, portions are coalesced per node into the
+    // overflow, which the consumer takes after the ring, so the latest values always arrive.
+    class TelemetryPipeline: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit TelemetryPipeline(int capacity = 1024, QObject* parent = nullptr);
+        ~TelemetryPipeline() override;
+
+        int capacity() const;
+        quint64 wakeups() const;
+        quint64 drains() const;
+        quint64 coalesced() const; // portions merged into the overflow
+
+        // Producer is bound by the first push, unless it is set. Any thread.
+        void setProducer(QThread* producer);
+
+        // Producer thread only, never blocks
+        void push(Telemetry* node, const TelemetryEntry* entries, int count, qint64 origin = 0);
+
+        // Sets values to the node and notifies it, like queued setParameter and notify did
+        static void apply(Telemetry* node, const TelemetryEntry* entries, int count,
+                          qint64 origin = 0);
+
+    public slots:
+        void drain();
+
+    private:
+        class Record
+        {
+        public:
+            QPointer<Telemetry> node;
+            QVector<TelemetryEntry> entries; // capacity is reused by next records
+            qint64 origin = 0; // latency origin
+        };
+
+        void wakeUp();
+        bool isProducerThread();
+        void overflow(Telemetry* node, const TelemetryEntry* entries, int count, qint64 origin);
+        void drainOverflow();
+
+        const quint32 m_mask;
+        QScopedArrayPointer<Record> m_records;
+        QAtomicInteger<quint32> m_head;
+        QAtomicInteger<quint32> m_tail;
+        QAtomicInt m_drainRequested;
+        QAtomicInteger<quint64> m_wakeups;
+        QAtomicInteger<quint64> m_drains;
+        QAtomicInteger<quint64> m_coalesced;
+        QAtomicPointer<QThread> m_producer;
+
+        // Set by producer, while overflow is not empty, ring is not used then to keep the order
+        QAtomicInt m_overflowed;
+        QMutex m_overflowMutex;
+        QVector<Record> m_overflow; // record per node
+    };
+}
+
+#endif // TELEMETRY_PIPELINE_H
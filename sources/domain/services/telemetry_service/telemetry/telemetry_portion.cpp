@@ -1,23 +1,46 @@
 #include "telemetry_portion.h"
 
+// Qt
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+// Internal
+#include "latency_monitor.h"
+
 using namespace domain;
 
 TelemetryPortion::TelemetryPortion(Telemetry* node):
-    QObject(nullptr),
-    m_node(node)
+    m_node(node),
+    m_origin(utils::LatencyMonitor::origin())
+{}
+
+TelemetryPortion::~TelemetryPortion()
 {
-    if (node)
+    if (!m_node) return;
+
+    if (m_node->thread() == QThread::currentThread())
+    {
+        TelemetryPipeline::apply(m_node, m_entries.constData(), m_entries.count(), m_origin);
+    }
+    else if (TelemetryPipeline* pipeline = m_node->pipeline())
     {
-        connect(this, &TelemetryPortion::setParameter,
-                node, QOverload< const QList< Telemetry::TelemetryId >&,
-                const QVariant& > ::of(&Telemetry::setParameter));
+        pipeline->push(m_node, m_entries.constData(), m_entries.count(), m_origin);
+    }
+    else // Node without pipeline, deliver portion with an event
+    {
+        QPointer<Telemetry> node = m_node;
+        QVector<TelemetryEntry> entries;
+        for (const TelemetryEntry& entry: m_entries) entries.append(entry);
+        qint64 origin = m_origin;
+
+        QTimer::singleShot(0, m_node, [node, entries, origin]() {
+            if (node) TelemetryPipeline::apply(node, entries.constData(), entries.count(), origin);
+        });
     }
 }
 
-TelemetryPortion::~TelemetryPortion()
+void TelemetryPortion::setParameter(const Telemetry::TelemetryList& path, const QVariant& value)
 {
-    if (m_node)
-    {
-        QMetaObject::invokeMethod(m_node, "notify", Qt::QueuedConnection);
-    }
+    m_entries.append(TelemetryEntry(path, value));
 }
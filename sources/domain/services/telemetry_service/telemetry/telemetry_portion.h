@@ -1,24 +1,29 @@
 #ifndef TELEMETRY_PORTION_H
 #define TELEMETRY_PORTION_H
 
+// Qt
+#include <QVarLengthArray>
+
 // Internal
-#include "telemetry.h"
+#include "telemetry_pipeline.h"
 
 namespace domain
 {
-    class TelemetryPortion: public QObject
+    // Collects decoded values and passes them to the node at once on destruction
+    class TelemetryPortion
     {
-        Q_OBJECT
-
     public:
         explicit TelemetryPortion(Telemetry* node);
-        ~TelemetryPortion() override;
+        ~TelemetryPortion();
 
-    signals:
         void setParameter(const Telemetry::TelemetryList& path, const QVariant& value);
 
     private:
-        Telemetry* m_node;
+        Telemetry* const m_node;
+        const qint64 m_origin;
+        QVarLengthArray<TelemetryEntry, 16> m_entries;
+
+        Q_DISABLE_COPY(TelemetryPortion)
     };
 }
 
@@ -0,0 +1,70 @@
+#include "telemetry_schema.h"
+
+using namespace domain;
+using namespace domain::telemetry_schema;
+
+namespace
+{
+#define TELEMETRY_TYPE(node, id, type) type,
+    constexpr ValueType types[] = { TELEMETRY_SCHEMA(TELEMETRY_TYPE) };
+#undef TELEMETRY_TYPE
+
+    // Number of leaves with the same type before the slot
+    constexpr int typeIndex(int slot, ValueType type)
+    {
+        return slot == 0 ? 0 : typeIndex(slot - 1, type) + (::types[slot - 1] == type ? 1 : 0);
+    }
+
+#define TELEMETRY_LEAF(node, id, type) \
+    { Telemetry::node, Telemetry::id, type, node##_##id, ::typeIndex(node##_##id, type) },
+    constexpr Leaf leaves[] = { TELEMETRY_SCHEMA(TELEMETRY_LEAF) };
+#undef TELEMETRY_LEAF
+
+    static_assert(sizeof(::leaves) / sizeof(Leaf) == SlotCount, "Schema table is incomplete");
+
+#define TELEMETRY_NAME(node, id, type) #node "/" #id,
+    const char* const names[] = { TELEMETRY_SCHEMA(TELEMETRY_NAME) };
+#undef TELEMETRY_NAME
+}
+
+const Leaf* telemetry_schema::nodeLeaves(Telemetry::TelemetryId node, int* count)
+{
+    for (int slot = 0; slot < SlotCount; ++slot)
+    {
+        if (::leaves[slot].node != node) continue;
+
+        int last = slot;
+        while (last < SlotCount && ::leaves[last].node == node) ++last;
+
+        *count = last - slot;
+        return &::leaves[slot];
+    }
+
+    *count = 0;
+    return nullptr;
+}
+
+const Leaf& telemetry_schema::slotLeaf(int slot)
+{
+    return ::leaves[slot];
+}
+
+QString telemetry_schema::slotName(int slot)
+{
+    return QString::fromLatin1(::names[slot]);
+}
+
+int telemetry_schema::nameSlot(const QString& name)
+{
+    for (int slot = 0; slot < SlotCount; ++slot)
+    {
+        if (name == QLatin1String(::names[slot])) return slot;
+    }
+
+    return -1;
+}
+
+int telemetry_schema::typeCount(ValueType type)
+{
+    return ::typeIndex(SlotCount, type);
+}
@@ -0,0 +1,161 @@
+#ifndef TELEMETRY_SCHEMA_H
+#define TELEMETRY_SCHEMA_H
+
+// Internal
+#include "telemetry.h"
+
+// Leaves of the tree, documented in telemetry.h: node, leaf, value type.
+// Leaves of a node must be adjacent, nodes with the same id share the leaves.
+#define TELEMETRY_SCHEMA(LEAF) \
+    LEAF(Root, Rssi, Number) \
+    LEAF(Root, Noise, Number) \
+    LEAF(Root, RemoteRssi, Number) \
+    LEAF(Root, RemoteNoise, Number) \
+    LEAF(Root, Errors, Number) \
+    LEAF(Root, Fixed, Number) \
+    LEAF(Flight, Uid, Variant) \
+    LEAF(Flight, Time, Variant) \
+    LEAF(System, Armed, Bool) \
+    LEAF(System, Auto, Bool) \
+    LEAF(System, Guided, Bool) \
+    LEAF(System, Stabilized, Bool) \
+    LEAF(System, Manual, Bool) \
+    LEAF(System, Mode, Variant) \
+    LEAF(System, AvailableModes, Variant) \
+    LEAF(System, State, Variant) \
+    LEAF(Position, Coordinate, Variant) \
+    LEAF(Position, Direction, Variant) \
+    LEAF(HomePosition, Coordinate, Variant) \
+    LEAF(HomePosition, Direction, Variant) \
+    LEAF(HomePosition, Altitude, Number) \
+    LEAF(Ahrs, Present, Bool) \
+    LEAF(Ahrs, Enabled, Bool) \
+    LEAF(Ahrs, Operational, Bool) \
+    LEAF(Ahrs, Pitch, Number) \
+    LEAF(Ahrs, Roll, Number) \
+    LEAF(Ahrs, Yaw, Number) \
+    LEAF(Ahrs, PitchSpeed, Number) \
+    LEAF(Ahrs, RollSpeed, Number) \
+    LEAF(Ahrs, YawSpeed, Number) \
+    LEAF(Ahrs, Vibration, Variant) \
+    LEAF(Accel, Present, Bool) \
+    LEAF(Accel, Enabled, Bool) \
+    LEAF(Accel, Operational, Bool) \
+    LEAF(Accel, Acceleration, Variant) \
+    LEAF(Gyro, Present, Bool) \
+    LEAF(Gyro, Enabled, Bool) \
+    LEAF(Gyro, Operational, Bool) \
+    LEAF(Gyro, AngularSpeed, Variant) \
+    LEAF(Compass, Present, Bool) \
+    LEAF(Compass, Enabled, Bool) \
+    LEAF(Compass, Operational, Bool) \
+    LEAF(Compass, Heading, Number) \
+    LEAF(Compass, MagneticField, Variant) \
+    LEAF(Ekf, VelocityVariance, Number) \
+    LEAF(Ekf, HorizontVariance, Number) \
+    LEAF(Ekf, VerticalVariance, Number) \
+    LEAF(Ekf, CompassVariance, Number) \
+    LEAF(Ekf, TerrainAltitudeVariance, Number) \
+    LEAF(Satellite, Present, Bool) \
+    LEAF(Satellite, Enabled, Bool) \
+    LEAF(Satellite, Operational, Bool) \
+    LEAF(Satellite, Fix, Number) \
+    LEAF(Satellite, Coordinate, Variant) \
+    LEAF(Satellite, Groundspeed, Number) \
+    LEAF(Satellite, Course, Number) \
+    LEAF(Satellite, Altitude, Number) \
+    LEAF(Satellite, Climb, Number) \
+    LEAF(Satellite, Eph, Number) \
+    LEAF(Satellite, Epv, Number) \
+    LEAF(Satellite, Time, Variant) \
+    LEAF(Satellite, SatellitesVisible, Number) \
+    LEAF(Satellite, SatelliteInfos, Variant) \
+    LEAF(Barometric, Present, Bool) \
+    LEAF(Barometric, Enabled, Bool) \
+    LEAF(Barometric, Operational, Bool) \
+    LEAF(Barometric, AltitudeMsl, Number) \
+    LEAF(Barometric, AltitudeRelative, Number) \
+    LEAF(Barometric, AltitudeTerrain, Number) \
+    LEAF(Barometric, Climb, Number) \
+    LEAF(Barometric, AbsPressure, Number) \
+    LEAF(Barometric, DiffPressure, Number) \
+    LEAF(Barometric, Temperature, Number) \
+    LEAF(Pitot, Present, Bool) \
+    LEAF(Pitot, Enabled, Bool) \
+    LEAF(Pitot, Operational, Bool) \
+    LEAF(Pitot, TrueAirspeed, Number) \
+    LEAF(Pitot, IndicatedAirspeed, Number) \
+    LEAF(Radalt, Present, Bool) \
+    LEAF(Radalt, Enabled, Bool) \
+    LEAF(Radalt, Operational, Bool) \
+    LEAF(Radalt, Altitude, Number) \
+    LEAF(Radalt, Voltage, Number) \
+    LEAF(FlightControl, DesiredPitch, Number) \
+    LEAF(FlightControl, DesiredRoll, Number) \
+    LEAF(FlightControl, DesiredHeading, Number) \
+    LEAF(FlightControl, AirspeedError, Number) \
+    LEAF(FlightControl, AltitudeError, Number) \
+    LEAF(Navigator, TargetBearing, Number) \
+    LEAF(Navigator, Distance, Number) \
+    LEAF(Navigator, TrackError, Number) \
+    LEAF(Navigator, Coordinate, Variant) \
+    LEAF(PowerSystem, Throttle, Number) \
+    LEAF(Battery, Present, Bool) \
+    LEAF(Battery, Enabled, Bool) \
+    LEAF(Battery, Operational, Bool) \
+    LEAF(Battery, Voltage, Number) \
+    LEAF(Battery, Current, Number) \
+    LEAF(Battery, Percentage, Number) \
+    LEAF(Wind, Yaw, Number) \
+    LEAF(Wind, Speed, Number) \
+    LEAF(Wind, Climb, Number) \
+    LEAF(LandingSystem, Distance, Number) \
+    LEAF(LandingSystem, DeviationX, Number) \
+    LEAF(LandingSystem, DeviationY, Number) \
+    LEAF(LandingSystem, SizeX, Number) \
+    LEAF(LandingSystem, SizeY, Number) \
+    LEAF(LandingSystem, Coordinate, Variant)
+
+namespace domain
+{
+    namespace telemetry_schema
+    {
+        enum ValueType: quint8
+        {
+            Bool,
+            Number, // any numeric type, kept as double with original type
+            Variant
+        };
+
+#define TELEMETRY_SLOT(node, id, type) node##_##id,
+        enum Slot
+        {
+            TELEMETRY_SCHEMA(TELEMETRY_SLOT)
+            SlotCount
+        };
+#undef TELEMETRY_SLOT
+
+        struct Leaf
+        {
+            Telemetry::TelemetryId node;
+            Telemetry::TelemetryId id;
+            ValueType type;
+            int slot;
+            int index; // in the store array of the value type
+        };
+
+        // Leaves of the node, count is zero if node is out of schema
+        const Leaf* nodeLeaves(Telemetry::TelemetryId node, int* count);
+
+        // Leaf of the slot, slot must be less than SlotCount
+        const Leaf& slotLeaf(int slot);
+
+        // Name of the slot leaf as "Node/Leaf", e.g. "Ahrs/Pitch", -1 for unknown name
+        QString slotName(int slot);
+        int nameSlot(const QString& name);
+
+        int typeCount(ValueType type);
+    }
+}
+
+#endif // TELEMETRY_SCHEMA_H
@@ -0,0 +1,146 @@
+#include "telemetry_store.h"
+
+using namespace domain;
+using namespace domain::telemetry_schema;
+
+namespace
+{
+    // 64-bit integers are not exact in double, they are kept out of the store
+    bool isNumberType(int type)
+    {
+        switch (type)
+        {
+        case QMetaType::Bool:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::Double:
+        case QMetaType::Float:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::UChar:
+            return true;
+        default:
+            return false;
+        }
+    }
+}
+
+TelemetryStore::TelemetryStore():
+    m_present(SlotCount),
+    m_bools(typeCount(Bool)),
+    m_reals(typeCount(Number)),
+    m_realTypes(typeCount(Number)),
+    m_variants(typeCount(Variant))
+{}
+
+bool TelemetryStore::accepts(const Leaf& leaf, const QVariant& value)
+{
+    switch (leaf.type)
+    {
+    case Bool:
+        return value.userType() == QMetaType::Bool;
+    case Number:
+        return ::isNumberType(value.userType());
+    default:
+        return true;
+    }
+}
+
+bool TelemetryStore::contains(const Leaf& leaf) const
+{
+    return m_present.testBit(leaf.slot);
+}
+
+QVariant TelemetryStore::value(const Leaf& leaf) const
+{
+    if (!this->contains(leaf)) return QVariant();
+
+    switch (leaf.type)
+    {
+    case Bool:
+        return m_bools.at(leaf.index);
+    case Number:
+    {
+        QVariant value(m_reals.at(leaf.index));
+        value.convert(m_realTypes.at(leaf.index));
+        return value;
+    }
+    default:
+        return m_variants.at(leaf.index);
+    }
+}
+
+bool TelemetryStore::boolValue(const Leaf& leaf) const
+{
+    if (!this->contains(leaf)) return false;
+
+    switch (leaf.type)
+    {
+    case Bool:
+        return m_bools.at(leaf.index);
+    case Number:
+        return !qFuzzyIsNull(m_reals.at(leaf.index));
+    default:
+        return m_variants.at(leaf.index).toBool();
+    }
+}
+
+double TelemetryStore::realValue(const Leaf& leaf) const
+{
+    if (!this->contains(leaf)) return 0;
+
+    switch (leaf.type)
+    {
+    case Bool:
+        return m_bools.at(leaf.index);
+    case Number:
+        return m_reals.at(leaf.index);
+    default:
+        return m_variants.at(leaf.index).toDouble();
+    }
+}
+
+bool TelemetryStore::setValue(const Leaf& leaf, const QVariant& value)
+{
+    bool present = this->contains(leaf);
+
+    switch (leaf.type)
+    {
+    case Bool:
+    {
+        bool boolValue = value.toBool();
+        if (present && m_bools.at(leaf.index) == boolValue) return false;
+
+        m_bools[leaf.index] = boolValue;
+        break;
+    }
+    case Number:
+    {
+        // Same as QVariant comparison: equal numbers of different types are not changes
+        double realValue = value.toDouble();
+        if (present && m_reals.at(leaf.index) == realValue) return false;
+
+        m_reals[leaf.index] = realValue;
+        m_realTypes[leaf.index] = quint8(value.userType());
+        break;
+    }
+    default:
+        if (present && m_variants.at(leaf.index) == value) return false;
+
+        m_variants[leaf.index] = value;
+        break;
+    }
+
+    m_present.setBit(leaf.slot);
+    return true;
+}
+
+void TelemetryStore::reset(const Leaf& leaf)
+{
+    if (!this->contains(leaf)) return;
+
+    m_present.clearBit(leaf.slot);
+    if (leaf.type == Variant) m_variants[leaf.index] = QVariant();
+}
@@ -0,0 +1,41 @@
+#ifndef TELEMETRY_STORE_H
+#define TELEMETRY_STORE_H
+
+// Qt
+#include <QVector>
+#include <QBitArray>
+#include <QVariant>
+
+// Internal
+#include "telemetry_schema.h"
+
+namespace domain
+{
+    // Values of the schema leaves for the whole tree, kept in arrays by value type
+    class TelemetryStore
+    {
+    public:
+        TelemetryStore();
+
+        // Value fits the leaf type without losing its type or precision
+        static bool accepts(const telemetry_schema::Leaf& leaf, const QVariant& value);
+
+        bool contains(const telemetry_schema::Leaf& leaf) const;
+        QVariant value(const telemetry_schema::Leaf& leaf) const;
+        bool boolValue(const telemetry_schema::Leaf& leaf) const;
+        double realValue(const telemetry_schema::Leaf& leaf) const;
+
+        // Returns false if value was not changed, value must be accepted
+        bool setValue(const telemetry_schema::Leaf& leaf, const QVariant& value);
+        void reset(const telemetry_schema::Leaf& leaf);
+
+    private:
+        QBitArray m_present;
+        QVector<bool> m_bools;
+        QVector<double> m_reals;
+        QVector<quint8> m_realTypes;
+        QVector<QVariant> m_variants;
+    };
+}
+
+#endif // TELEMETRY_STORE_H
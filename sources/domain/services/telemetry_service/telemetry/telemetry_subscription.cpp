@@ -0,0 +1,180 @@
+#include "telemetry_subscription.h"
+
+// Internal
+#include "latency_monitor.h"
+
+using namespace domain;
+
+TelemetrySubscription::TelemetrySubscription(Telemetry* node,
+                                             const Telemetry::TelemetryList& leaves,
+                                             QObject* parent):
+    QObject(parent),
+    m_node(node),
+    m_leaves(leaves)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &TelemetrySubscription::deliver);
+
+    this->connectNode();
+}
+
+TelemetrySubscription::~TelemetrySubscription()
+{}
+
+Telemetry* TelemetrySubscription::node() const
+{
+    return m_node;
+}
+
+Telemetry::TelemetryList TelemetrySubscription::leaves() const
+{
+    return m_leaves;
+}
+
+int TelemetrySubscription::maxRate() const
+{
+    return m_maxRate;
+}
+
+double TelemetrySubscription::deadband(Telemetry::TelemetryId id) const
+{
+    return m_deadbands.value(id, 0);
+}
+
+bool TelemetrySubscription::isActive() const
+{
+    return m_active;
+}
+
+Telemetry::TelemetryMap TelemetrySubscription::parameters() const
+{
+    return m_parameters;
+}
+
+void TelemetrySubscription::setMaxRate(int maxRate)
+{
+    m_maxRate = qMax(maxRate, 0);
+}
+
+void TelemetrySubscription::setDeadband(Telemetry::TelemetryId id, double deadband)
+{
+    if (deadband > 0)
+    {
+        m_deadbands[id] = deadband;
+    }
+    else
+    {
+        m_deadbands.remove(id);
+    }
+}
+
+void TelemetrySubscription::setActive(bool active)
+{
+    if (m_active == active) return;
+
+    m_active = active;
+
+    if (active)
+    {
+        this->connectNode();
+        emit parametersUpdated(m_parameters);
+    }
+    else
+    {
+        if (m_node) disconnect(m_node, 0, this, 0);
+        m_timer.stop();
+        m_pending.clear();
+        m_origin = 0;
+    }
+}
+
+void TelemetrySubscription::onNodeParametersChanged(const Telemetry::TelemetryMap& parameters)
+{
+    for (auto it = parameters.constBegin(); it != parameters.constEnd(); ++it)
+    {
+        if (!this->isSubscribed(it.key())) continue;
+
+        // Newer value always replaces pending one, deadband only decides to queue the leaf
+        if (!m_pending.contains(it.key()) && this->isInDeadband(it.key(), it.value())) continue;
+
+        m_pending[it.key()] = it.value();
+        if (!m_origin) m_origin = utils::LatencyMonitor::origin();
+    }
+
+    if (m_pending.isEmpty() || m_timer.isActive()) return;
+
+    if (!m_maxRate || !m_lastDelivery.isValid())
+    {
+        this->deliver();
+        return;
+    }
+
+    qint64 interval = 1000 / m_maxRate;
+    qint64 elapsed = m_lastDelivery.elapsed();
+
+    if (elapsed >= interval)
+    {
+        this->deliver();
+    }
+    else
+    {
+        m_timer.start(interval - elapsed);
+    }
+}
+
+void TelemetrySubscription::deliver()
+{
+    if (m_pending.isEmpty()) return;
+
+    m_lastDelivery.start();
+
+    Telemetry::TelemetryMap changed;
+    changed.swap(m_pending);
+
+    for (auto it = changed.constBegin(); it != changed.constEnd(); ++it)
+    {
+        m_parameters[it.key()] = it.value();
+    }
+
+    utils::LatencyScope scope(m_origin);
+    m_origin = 0;
+
+    emit parametersChanged(changed);
+    emit parametersUpdated(m_parameters);
+}
+
+bool TelemetrySubscription::isSubscribed(Telemetry::TelemetryId id) const
+{
+    return m_leaves.isEmpty() || m_leaves.contains(id);
+}
+
+bool TelemetrySubscription::isInDeadband(Telemetry::TelemetryId id, const QVariant& value) const
+{
+    auto deadband = m_deadbands.constFind(id);
+    if (deadband == m_deadbands.constEnd() || !m_parameters.contains(id)) return false;
+
+    bool ok = false;
+    double current = value.toDouble(&ok);
+    if (!ok) return false;
+
+    double delivered = m_parameters.value(id).toDouble(&ok);
+    if (!ok) return false;
+
+    return qAbs(current - delivered) < deadband.value();
+}
+
+void TelemetrySubscription::connectNode()
+{
+    if (!m_node) return;
+
+    m_parameters.clear();
+
+    const Telemetry::TelemetryMap parameters = m_node->parameters();
+    for (auto it = parameters.constBegin(); it != parameters.constEnd(); ++it)
+    {
+        if (this->isSubscribed(it.key())) m_parameters[it.key()] = it.value();
+    }
+
+    connect(m_node, &Telemetry::parametersChanged,
+            this, &TelemetrySubscription::onNodeParametersChanged);
+}
@@ -0,0 +1,68 @@
+#ifndef TELEMETRY_SUBSCRIPTION_H
+#define TELEMETRY_SUBSCRIPTION_H
+
+// Qt
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+
+// Internal
+#include "telemetry.h"
+
+namespace domain
+{
+    // Filtered view of the node changes: only chosen leaves, not more often than max rate and
+    // numeric leaves are queued only if they leave the deadband around the last delivered value
+    class TelemetrySubscription: public QObject
+    {
+        Q_OBJECT
+
+    public:
+        // Empty leaves list subscribes to all leaves of the node
+        explicit TelemetrySubscription(Telemetry* node,
+                                       const Telemetry::TelemetryList& leaves = {},
+                                       QObject* parent = nullptr);
+        ~TelemetrySubscription() override;
+
+        Telemetry* node() const;
+        Telemetry::TelemetryList leaves() const;
+        int maxRate() const;
+        double deadband(Telemetry::TelemetryId id) const;
+        bool isActive() const;
+
+        // Last delivered values of the subscribed leaves
+        Telemetry::TelemetryMap parameters() const;
+
+    public slots:
+        void setMaxRate(int maxRate); // Hz, zero means no limit
+        void setDeadband(Telemetry::TelemetryId id, double deadband);
+        void setActive(bool active); // Inactive subscription skips changes, like hidden views do
+
+    signals:
+        void parametersChanged(Telemetry::TelemetryMap parameters); // Only delivered changes
+        void parametersUpdated(Telemetry::TelemetryMap parameters); // All subscribed leaves
+
+    private slots:
+        void onNodeParametersChanged(const Telemetry::TelemetryMap& parameters);
+        void deliver();
+
+    private:
+        bool isSubscribed(Telemetry::TelemetryId id) const;
+        bool isInDeadband(Telemetry::TelemetryId id, const QVariant& value) const;
+        void connectNode();
+
+        QPointer<Telemetry> m_node;
+        const Telemetry::TelemetryList m_leaves;
+        QMap<Telemetry::TelemetryId, double> m_deadbands;
+        int m_maxRate = 0;
+        bool m_active = true;
+
+        Telemetry::TelemetryMap m_parameters;
+        Telemetry::TelemetryMap m_pending;
+        qint64 m_origin = 0; // Latency origin of the oldest pending value
+        QTimer m_timer;
+        QElapsedTimer m_lastDelivery;
+    };
+}
+
+#endif // TELEMETRY_SUBSCRIPTION_H
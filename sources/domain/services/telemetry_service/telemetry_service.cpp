@@ -2,6 +2,7 @@
 
 // Qt
 #include <QMap>
+#include <QStandardPaths>
 #include <QDebug>
 
 // Internal
@@ -11,7 +12,10 @@
 #include "vehicle.h"
 
 #include "telemetry.h"
-#include "telemetry_portion.h"
+#include "telemetry_schema.h"
+#include "telemetry_pipeline.h"
+#include "telemetry_notifier.h"
+#include "telemetry_history.h"
 #include "vehicle_telemetry_factory.h"
 
 #include "vehicle_types.h"
@@ -23,12 +27,56 @@ class TelemetryService::Impl
 public:
     domain::VehicleService* service;
 
+    TelemetryPipeline pipeline;
+    TelemetryNotifier notifier;
+    TelemetryHistory history;
     QMap<int, Telemetry*> vehicleNodes;
     Telemetry radioNode;
 
     Impl():
         radioNode(Telemetry::Root)
-    {}
+    {
+        int rate = settings::Provider::value(settings::gui::telemetryRate).toInt();
+        notifier.setInterval(rate > 0 ? 1000 / rate : 0);
+
+        radioNode.setPipeline(&pipeline);
+        radioNode.setNotifier(&notifier);
+
+        if (settings::Provider::boolValue(settings::telemetry::history)) this->openHistory();
+    }
+
+    void openHistory()
+    {
+        QString path = settings::Provider::value(settings::telemetry::historyPath).toString();
+        if (path.isEmpty())
+        {
+            path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+                   "/telemetry";
+        }
+
+        for (const QString& name:
+             settings::Provider::value(settings::telemetry::historyLeaves).toStringList())
+        {
+            int slot = telemetry_schema::nameSlot(name);
+            if (slot > -1) history.setRecorded(slot, true);
+            else qWarning() << "Unknown telemetry history leaf" << name;
+        }
+
+        history.setMaxSessions(settings::Provider::value(
+                                   settings::telemetry::historySessions).toInt());
+
+        if (!history.open(path)) qWarning() << "Can't open telemetry history" << path;
+    }
+
+    Telemetry* createVehicleNode(int vehicleId)
+    {
+        VehicleTelemetryFactory factory;
+        Telemetry* node = factory.create();
+        node->setPipeline(&pipeline);
+        node->setNotifier(&notifier);
+        node->setHistory(&history, vehicleId);
+        return node;
+    }
 };
 
 TelemetryService::TelemetryService(VehicleService* service, QObject* parent):
@@ -42,10 +90,9 @@ TelemetryService::TelemetryService(VehicleService* service, QObject* parent):
     connect(d->service, &VehicleService::vehicleAdded, this, &TelemetryService::onVehicleAdded);
     connect(d->service, &VehicleService::vehicleRemoved, this, &TelemetryService::onVehicleRemoved);
 
-    VehicleTelemetryFactory factory;
     for (const dto::VehiclePtr& vehicle: d->service->vehicles())
     {
-        d->vehicleNodes[vehicle->id()] = factory.create();
+        d->vehicleNodes[vehicle->id()] = d->createVehicleNode(vehicle->id());
     }
 }
 
@@ -77,12 +124,16 @@ Telemetry* TelemetryService::radioNode() const
     return &d->radioNode;
 }
 
+TelemetryHistory* TelemetryService::history() const
+{
+    return &d->history;
+}
+
 void TelemetryService::onVehicleAdded(const dto::VehiclePtr& vehicle)
 {
     if (d->vehicleNodes.contains(vehicle->id())) return;
 
-    VehicleTelemetryFactory factory;
-    d->vehicleNodes[vehicle->id()] = factory.create();
+    d->vehicleNodes[vehicle->id()] = d->createVehicleNode(vehicle->id());
 }
 
 void TelemetryService::onVehicleRemoved(const dto::VehiclePtr& vehicle)
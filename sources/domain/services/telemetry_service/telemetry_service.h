@@ -8,6 +8,7 @@ namespace domain
 {
     class VehicleService;
     class Telemetry;
+    class TelemetryHistory;
 
     class TelemetryService: public QObject
     {
@@ -23,6 +24,9 @@ namespace domain
         // TODO: multiply radio telemetry
         Telemetry* radioNode() const;
 
+        // Recorded values of the vehicle nodes for post-flight analysis
+        TelemetryHistory* history() const;
+
     private slots:
         void onVehicleAdded(const dto::VehiclePtr& vehicle);
         void onVehicleRemoved(const dto::VehiclePtr& vehicle);
@@ -2,6 +2,7 @@
 
 // Qt
 #include <QMutexLocker>
+#include <QHash>
 #include <QDebug>
 
 // Internal
@@ -23,6 +24,10 @@ public:
     GenericRepository<Vehicle> vehicleRepository;
     MissionService* missionService;
 
+    // Mav id index, asked for every received message
+    QHash<int, int> mavIdVehicles;
+    QHash<int, int> vehicleMavIds;
+
     Impl():
         mutex(QMutex::Recursive),
         vehicleRepository("vehicles")
@@ -30,7 +35,26 @@ public:
 
     void loadVehicles(const QString& condition = QString())
     {
-        for (int id: vehicleRepository.selectId(condition)) vehicleRepository.read(id);
+        for (const VehiclePtr& vehicle: vehicleRepository.loadAll(condition))
+        {
+            this->index(vehicle);
+        }
+    }
+
+    void index(const VehiclePtr& vehicle)
+    {
+        this->unindex(vehicle->id());
+
+        mavIdVehicles[vehicle->mavId()] = vehicle->id();
+        vehicleMavIds[vehicle->id()] = vehicle->mavId();
+    }
+
+    void unindex(int vehicleId)
+    {
+        if (!vehicleMavIds.contains(vehicleId)) return;
+
+        int mavId = vehicleMavIds.take(vehicleId);
+        if (mavIdVehicles.value(mavId) == vehicleId) mavIdVehicles.remove(mavId);
     }
 };
 
@@ -69,20 +93,14 @@ int VehicleService::vehicleIdByMavId(int mavId) const
 {
     QMutexLocker locker(&d->mutex);
 
-    for (const VehiclePtr& vehicle: d->vehicleRepository.loadedEntities())
-    {
-        if (vehicle->mavId() == mavId) return vehicle->id();
-    }
-    return 0;
+    return d->mavIdVehicles.value(mavId, 0);
 }
 
 int VehicleService::mavIdByVehicleId(int vehicleId) const
 {
     QMutexLocker locker(&d->mutex);
 
-    VehiclePtr vehicle = this->vehicle(vehicleId);
-    if (vehicle) return vehicle->mavId();
-    return -1;
+    return d->vehicleMavIds.value(vehicleId, -1);
 }
 
 QList<int> VehicleService::employedMavIds() const
@@ -100,7 +118,23 @@ bool VehicleService::save(const VehiclePtr& vehicle)
     QMutexLocker locker(&d->mutex);
 
     bool isNew = vehicle->id() == 0;
-    if (!d->vehicleRepository.save(vehicle)) return false;
+    if (isNew)
+    {
+        if (!d->vehicleRepository.insert(vehicle)) return false;
+    }
+    else
+    {
+        // Stored by DB writer, failed update brings the stored vehicle back
+        d->vehicleRepository.updateAsync(vehicle, this, [this, vehicle](bool ok) {
+            if (ok) return;
+
+            QMutexLocker locker(&d->mutex);
+            d->vehicleRepository.read(vehicle->id(), true);
+            d->index(vehicle);
+            emit vehicleChanged(vehicle);
+        });
+    }
+    d->index(vehicle);
 
     if (isNew)
     {
@@ -131,6 +165,7 @@ bool VehicleService::remove(const VehiclePtr& vehicle)
     if (assignment && !d->missionService->remove(assignment)) return false;
 
     if (!d->vehicleRepository.remove(vehicle)) return false;
+    d->unindex(vehicle->id());
 
     settings::Provider::remove(settings::vehicle::vehicle + QString::number(vehicle->id()));
 
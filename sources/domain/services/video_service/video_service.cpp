@@ -22,7 +22,7 @@ public:
 
     void loadVideoSources(const QString& condition = QString())
     {
-        for (int id: videoRepository.selectId(condition)) videoRepository.read(id);
+        videoRepository.loadAll(condition);
     }
 };
 
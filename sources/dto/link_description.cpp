@@ -20,7 +20,8 @@ namespace
         { LinkDescription::Udp, { LinkDescription::Port, LinkDescription::Endpoints,
                                   LinkDescription::UdpAutoResponse } },
         { LinkDescription::Tcp, { LinkDescription::Address, LinkDescription::Port } },
-        { LinkDescription::Bluetooth, { LinkDescription::Device, LinkDescription::Address } }
+        { LinkDescription::Bluetooth, { LinkDescription::Device, LinkDescription::Address } },
+        { LinkDescription::Replay, { LinkDescription::FileName, LinkDescription::ReplaySpeed } }
     };
 }
 
@@ -26,7 +26,8 @@ namespace dto
             Serial,
             Udp,
             Tcp,
-            Bluetooth
+            Bluetooth,
+            Replay
         };
 
         enum Protocol: quint8
@@ -45,7 +46,9 @@ namespace dto
             Address,
             Port,
             Endpoints,
-            UdpAutoResponse
+            UdpAutoResponse,
+            FileName,
+            ReplaySpeed
         };
 
         QString name() const;
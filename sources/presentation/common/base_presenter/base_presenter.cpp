@@ -43,14 +43,18 @@ void BasePresenter::disconnectView(QObject* view)
 
 void BasePresenter::setViewProperty(const char* name, const QVariant& value)
 {
-    if (m_view) m_view->setProperty(name, value);
+    if (!m_view) return;
+
+    m_view->setProperty(name, value);
 }
 
 void BasePresenter::setViewProperty(const QString& child, const char* name, const QVariant& value)
 {
     if (!m_view) return;
     QObject* childView = m_view->findChild<QObject*>(child);
-    if (childView) childView->setProperty(name, value);
+    if (!childView) return;
+
+    childView->setProperty(name, value);
 }
 
 void BasePresenter::invokeViewMethod(const char* name)
@@ -1,8 +1,13 @@
 #include "abstract_telemetry_presenter.h"
 
 // Qt
+#include <QMetaProperty>
 #include <QDebug>
 
+// Internal
+#include "telemetry_subscription.h"
+#include "latency_monitor.h"
+
 using namespace presentation;
 
 AbstractTelemetryPresenter::AbstractTelemetryPresenter(QObject* parent):
@@ -20,14 +25,82 @@ void AbstractTelemetryPresenter::setNode(domain::Telemetry* node)
     if (node) this->connectNode(node);
 }
 
+void AbstractTelemetryPresenter::setActive(bool active)
+{
+    if (m_active == active) return;
+
+    m_active = active;
+
+    for (domain::TelemetrySubscription* subscription: m_subscriptions)
+    {
+        subscription->setActive(active);
+    }
+}
+
+void AbstractTelemetryPresenter::connectView(QObject* view)
+{
+    BasePresenter::connectView(view);
+
+    // Views without visibility, e.g. plain objects, are always shown
+    int index = view->metaObject()->indexOfProperty("visible");
+    if (index < 0)
+    {
+        this->setActive(true);
+        return;
+    }
+
+    QMetaProperty visible = view->metaObject()->property(index);
+    if (visible.hasNotifySignal())
+    {
+        connect(view, visible.notifySignal(), this, this->metaObject()->method(
+                    this->metaObject()->indexOfSlot("onViewVisibleChanged()")));
+    }
+
+    this->setActive(visible.read(view).toBool());
+}
+
+void AbstractTelemetryPresenter::disconnectView(QObject* view)
+{
+    BasePresenter::disconnectView(view);
+
+    this->setActive(false);
+}
+
+void AbstractTelemetryPresenter::onViewVisibleChanged()
+{
+    if (this->view()) this->setActive(this->view()->property("visible").toBool());
+}
+
 void AbstractTelemetryPresenter::disconnectNode()
 {
     disconnect(m_node, 0, this, 0);
+
+    qDeleteAll(m_subscriptions);
+    m_subscriptions.clear();
 }
 
-void AbstractTelemetryPresenter::chainNode(
-        domain::Telemetry* node, std::function<void(const domain::Telemetry::TelemetryMap&)> func)
+domain::TelemetrySubscription* AbstractTelemetryPresenter::chainNode(
+        domain::Telemetry* node, std::function<void(const domain::Telemetry::TelemetryMap&)> func,
+        const domain::Telemetry::TelemetryList& leaves, int maxRate)
 {
-    if (node) QObject::connect(node, &domain::Telemetry::parametersUpdated, this, func);
-    func(node ? node->parameters() : domain::Telemetry::TelemetryMap());
+    if (!node)
+    {
+        func(domain::Telemetry::TelemetryMap());
+        return nullptr;
+    }
+
+    auto subscription = new domain::TelemetrySubscription(node, leaves, this);
+    subscription->setMaxRate(maxRate);
+    subscription->setActive(m_active);
+    // Delivery updates several view properties, it is traced once
+    QObject::connect(subscription, &domain::TelemetrySubscription::parametersUpdated, this,
+                     [func](const domain::Telemetry::TelemetryMap& parameters) {
+        func(parameters);
+        utils::LatencyMonitor::record(utils::LatencyMonitor::PresenterUpdate,
+                                      utils::LatencyMonitor::origin());
+    });
+    m_subscriptions.append(subscription);
+
+    func(subscription->parameters());
+    return subscription;
 }
@@ -8,6 +8,11 @@
 #include "base_presenter.h"
 #include "telemetry.h"
 
+namespace domain
+{
+    class TelemetrySubscription;
+}
+
 namespace presentation
 {
     class AbstractTelemetryPresenter: public BasePresenter
@@ -19,16 +24,30 @@ namespace presentation
 
     public slots:
         void setNode(domain::Telemetry* node);
+        void setActive(bool active);
 
     protected:
+        // Presenter is active while the view is visible
+        void connectView(QObject* view) override;
+        void disconnectView(QObject* view) override;
+
         virtual void connectNode(domain::Telemetry* node) = 0;
         virtual void disconnectNode();
 
-        void chainNode(domain::Telemetry* node,
-                       std::function<void(const domain::Telemetry::TelemetryMap&)> func);
+        // Subscribes func to the node leaves, empty leaves means whole node.
+        // Zero max rate delivers every change.
+        domain::TelemetrySubscription* chainNode(
+                domain::Telemetry* node,
+                std::function<void(const domain::Telemetry::TelemetryMap&)> func,
+                const domain::Telemetry::TelemetryList& leaves = {}, int maxRate = 0);
+
+    private slots:
+        void onViewVisibleChanged();
 
     private:
         domain::Telemetry* m_node = nullptr;
+        QList<domain::TelemetrySubscription*> m_subscriptions;
+        bool m_active = true;
     };
 }
 
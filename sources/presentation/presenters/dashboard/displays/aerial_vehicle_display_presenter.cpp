@@ -5,6 +5,18 @@
 
 // Internal
 #include "vibration_model.h"
+#include "telemetry_subscription.h"
+
+namespace
+{
+    // Display update rates, Hz
+    const int instrumentRate = 10;
+    const int statusRate = 5;
+    const int slowRate = 2;
+
+    const double speedDeadband = 0.1; // m/s
+    const double altitudeDeadband = 0.1; // m
+}
 
 using namespace presentation;
 
@@ -19,29 +31,74 @@ void AerialVehicleDisplayPresenter::connectNode(domain::Telemetry* node)
     domain::Telemetry* ahrs = node->childNode(domain::Telemetry::Ahrs);
     this->chainNode(ahrs->childNode(domain::Telemetry::Ekf),
                     std::bind(&AerialVehicleDisplayPresenter::updateEkf,
-                              this, std::placeholders::_1));
-
-    this->chainNode(node->childNode(domain::Telemetry::Pitot),
-                    std::bind(&AerialVehicleDisplayPresenter::updatePitot,
-                              this, std::placeholders::_1));
-    this->chainNode(node->childNode(domain::Telemetry::Barometric),
-                    std::bind(&AerialVehicleDisplayPresenter::updateBarometric,
-                              this, std::placeholders::_1));
-    this->chainNode(node->childNode(domain::Telemetry::Radalt),
-                    std::bind(&AerialVehicleDisplayPresenter::updateRadalt,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::VelocityVariance, domain::Telemetry::VerticalVariance,
+                      domain::Telemetry::HorizontVariance, domain::Telemetry::CompassVariance,
+                      domain::Telemetry::TerrainAltitudeVariance },
+                    ::slowRate);
+
+    domain::TelemetrySubscription* pitot =
+            this->chainNode(node->childNode(domain::Telemetry::Pitot),
+                            std::bind(&AerialVehicleDisplayPresenter::updatePitot,
+                                      this, std::placeholders::_1),
+                            { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                              domain::Telemetry::Operational, domain::Telemetry::TrueAirspeed,
+                              domain::Telemetry::IndicatedAirspeed },
+                            ::instrumentRate);
+    if (pitot)
+    {
+        pitot->setDeadband(domain::Telemetry::TrueAirspeed, ::speedDeadband);
+        pitot->setDeadband(domain::Telemetry::IndicatedAirspeed, ::speedDeadband);
+    }
+
+    domain::TelemetrySubscription* barometric =
+            this->chainNode(node->childNode(domain::Telemetry::Barometric),
+                            std::bind(&AerialVehicleDisplayPresenter::updateBarometric,
+                                      this, std::placeholders::_1),
+                            { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                              domain::Telemetry::Operational, domain::Telemetry::AltitudeMsl,
+                              domain::Telemetry::Climb },
+                            ::instrumentRate);
+    if (barometric)
+    {
+        barometric->setDeadband(domain::Telemetry::AltitudeMsl, ::altitudeDeadband);
+        barometric->setDeadband(domain::Telemetry::Climb, ::speedDeadband);
+    }
+
+    domain::TelemetrySubscription* radalt =
+            this->chainNode(node->childNode(domain::Telemetry::Radalt),
+                            std::bind(&AerialVehicleDisplayPresenter::updateRadalt,
+                                      this, std::placeholders::_1),
+                            { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                              domain::Telemetry::Operational, domain::Telemetry::Altitude },
+                            ::instrumentRate);
+    if (radalt) radalt->setDeadband(domain::Telemetry::Altitude, ::altitudeDeadband);
+
     this->chainNode(node->childNode(domain::Telemetry::FlightControl),
                     std::bind(&AerialVehicleDisplayPresenter::updateFlightControl,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::DesiredPitch, domain::Telemetry::DesiredRoll,
+                      domain::Telemetry::DesiredHeading, domain::Telemetry::AirspeedError,
+                      domain::Telemetry::AltitudeError },
+                    ::instrumentRate);
     this->chainNode(node->childNode(domain::Telemetry::Navigator),
                     std::bind(&AerialVehicleDisplayPresenter::updateNavigator,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::TargetBearing, domain::Telemetry::Distance,
+                      domain::Telemetry::TrackError },
+                    ::statusRate);
     this->chainNode(node->childNode(domain::Telemetry::LandingSystem),
                     std::bind(&AerialVehicleDisplayPresenter::updateLandingSystem,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Distance, domain::Telemetry::DeviationX,
+                      domain::Telemetry::DeviationY, domain::Telemetry::SizeX,
+                      domain::Telemetry::SizeY },
+                    ::instrumentRate);
     this->chainNode(node->childNode(domain::Telemetry::Wind),
                     std::bind(&AerialVehicleDisplayPresenter::updateWind,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Yaw, domain::Telemetry::Speed },
+                    ::slowRate);
 }
 
 void AerialVehicleDisplayPresenter::updateEkf(const domain::Telemetry::TelemetryMap& parameters)
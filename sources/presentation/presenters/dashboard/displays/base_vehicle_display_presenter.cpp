@@ -8,9 +8,22 @@
 
 // Internal
 #include "vibration_model.h"
+#include "telemetry_subscription.h"
 
 #include "vehicle_types.h"
 
+namespace
+{
+    // Display update rates, Hz
+    const int attitudeRate = 30;
+    const int instrumentRate = 10;
+    const int statusRate = 5;
+    const int slowRate = 2;
+
+    const double angleDeadband = 0.1; // degrees
+    const double headingDeadband = 0.5; // degrees
+}
+
 using namespace presentation;
 
 BaseVehicleDisplayPresenter::BaseVehicleDisplayPresenter(QObject* parent):
@@ -30,30 +43,67 @@ void BaseVehicleDisplayPresenter::connectNode(domain::Telemetry* node)
 {
     this->chainNode(node->childNode(domain::Telemetry::System),
                     std::bind(&BaseVehicleDisplayPresenter::updateSystem,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Armed, domain::Telemetry::Guided,
+                      domain::Telemetry::Stabilized, domain::Telemetry::State,
+                      domain::Telemetry::Mode, domain::Telemetry::AvailableModes },
+                    ::statusRate);
 
     domain::Telemetry* ahrs = node->childNode(domain::Telemetry::Ahrs);
-    this->chainNode(ahrs, std::bind(&BaseVehicleDisplayPresenter::updateAhrs,
-                                    this, std::placeholders::_1));
-    this->chainNode(ahrs->childNode(domain::Telemetry::Compass),
-                    std::bind(&BaseVehicleDisplayPresenter::updateCompass,
-                              this, std::placeholders::_1));
+    domain::TelemetrySubscription* attitude =
+            this->chainNode(ahrs, std::bind(&BaseVehicleDisplayPresenter::updateAhrs,
+                                            this, std::placeholders::_1),
+                            { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                              domain::Telemetry::Operational, domain::Telemetry::Pitch,
+                              domain::Telemetry::Roll, domain::Telemetry::Yaw,
+                              domain::Telemetry::YawSpeed, domain::Telemetry::Vibration },
+                            ::attitudeRate);
+    if (attitude)
+    {
+        attitude->setDeadband(domain::Telemetry::Pitch, ::angleDeadband);
+        attitude->setDeadband(domain::Telemetry::Roll, ::angleDeadband);
+        attitude->setDeadband(domain::Telemetry::Yaw, ::angleDeadband);
+    }
+
+    domain::TelemetrySubscription* compass =
+            this->chainNode(ahrs->childNode(domain::Telemetry::Compass),
+                            std::bind(&BaseVehicleDisplayPresenter::updateCompass,
+                                      this, std::placeholders::_1),
+                            { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                              domain::Telemetry::Operational, domain::Telemetry::Heading },
+                            ::instrumentRate);
+    if (compass) compass->setDeadband(domain::Telemetry::Heading, ::headingDeadband);
 
     this->chainNode(node->childNode(domain::Telemetry::Satellite),
                     std::bind(&BaseVehicleDisplayPresenter::updateSatellite,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                      domain::Telemetry::Operational, domain::Telemetry::Fix,
+                      domain::Telemetry::Course, domain::Telemetry::Groundspeed,
+                      domain::Telemetry::Coordinate, domain::Telemetry::Altitude,
+                      domain::Telemetry::Eph, domain::Telemetry::Epv,
+                      domain::Telemetry::SatellitesVisible },
+                    ::statusRate);
     this->chainNode(node->childNode(domain::Telemetry::PowerSystem),
                     std::bind(&BaseVehicleDisplayPresenter::updatePowerSystem,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Throttle }, ::instrumentRate);
     this->chainNode(node->childNode(domain::Telemetry::Battery),
                     std::bind(&BaseVehicleDisplayPresenter::updateBattery,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Present, domain::Telemetry::Enabled,
+                      domain::Telemetry::Operational, domain::Telemetry::Voltage,
+                      domain::Telemetry::Current, domain::Telemetry::Percentage },
+                    ::slowRate);
     this->chainNode(node->childNode(domain::Telemetry::HomePosition),
                     std::bind(&BaseVehicleDisplayPresenter::updateHome,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Coordinate, domain::Telemetry::Altitude },
+                    ::slowRate);
     this->chainNode(node->childNode(domain::Telemetry::Position),
                     std::bind(&BaseVehicleDisplayPresenter::updatePosition,
-                              this, std::placeholders::_1));
+                              this, std::placeholders::_1),
+                    { domain::Telemetry::Coordinate }, ::instrumentRate);
 }
 
 void BaseVehicleDisplayPresenter::updateSystem(const domain::Telemetry::TelemetryMap& parameters)
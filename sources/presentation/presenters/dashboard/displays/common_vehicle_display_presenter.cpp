@@ -173,7 +173,7 @@ void CommonVehicleDisplayPresenter::rejectCommand(int commandType)
 
 void CommonVehicleDisplayPresenter::connectView(QObject* view)
 {
-    BasePresenter::connectView(view);
+    AbstractTelemetryPresenter::connectView(view);
 
     this->updateVehicle();
 }
@@ -72,6 +72,10 @@ void LinkEditPresenter::updateLink()
                           endpoints.isEmpty() ? QStringList() : endpoints.split(::separator));
     this->setViewProperty(PROPERTY(autoResponse),
                           m_link ? m_link->parameter(dto::LinkDescription::UdpAutoResponse) : false);
+    this->setViewProperty(PROPERTY(fileName),
+                          m_link ? m_link->parameter(dto::LinkDescription::FileName) : QString());
+    this->setViewProperty(PROPERTY(replaySpeed),
+                          m_link ? m_link->parameter(dto::LinkDescription::ReplaySpeed, 1.0) : 1.0);
 
     this->setViewProperty(PROPERTY(changed), false);
 }
@@ -142,6 +146,10 @@ void LinkEditPresenter::save()
     m_link->setParameter(dto::LinkDescription::Endpoints, endpoints.join(::separator));
     m_link->setParameter(dto::LinkDescription::UdpAutoResponse,
                                 this->viewProperty(PROPERTY(autoResponse)).toBool());
+    m_link->setParameter(dto::LinkDescription::FileName,
+                                this->viewProperty(PROPERTY(fileName)).toString());
+    m_link->setParameter(dto::LinkDescription::ReplaySpeed,
+                                this->viewProperty(PROPERTY(replaySpeed)).toDouble());
 
     if (!m_service->save(m_link)) return;
 
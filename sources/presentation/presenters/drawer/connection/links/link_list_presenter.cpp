@@ -100,6 +100,18 @@ void LinkListPresenter::addBluetoothLink()
     d->service->save(description);
 }
 
+void LinkListPresenter::addReplayLink()
+{
+    dto::LinkDescriptionPtr description = dto::LinkDescriptionPtr::create();
+
+    description->setName(tr("Replay"));
+    description->setType(dto::LinkDescription::Replay);
+    description->setParameter(dto::LinkDescription::ReplaySpeed, 1.0);
+    description->setAutoConnect(false);
+
+    d->service->save(description);
+}
+
 void LinkListPresenter::filter(const QString& filterString)
 {
     d->filterModel.setFilterFixedString(filterString);
@@ -14,6 +14,20 @@
 
 #include "telemetry_service.h"
 #include "telemetry.h"
+#include "telemetry_subscription.h"
+
+namespace
+{
+    const int maxMapRate = 10; // Hz
+    const double headingDeadband = 0.5; // degrees
+
+    // Scalar leaf is read from the store without boxing, fallback if it is not reported
+    double realParameter(const domain::Telemetry* node, domain::Telemetry::TelemetryId id,
+                         double fallback)
+    {
+        return node && node->hasParameter(id) ? node->realParameter(id) : fallback;
+    }
+}
 
 using namespace presentation;
 
@@ -25,6 +39,7 @@ public:
 
     QList<int> vehicleIds;
     QMap<int, QVariantList> tracks;
+    QMultiMap<int, domain::TelemetrySubscription*> subscriptions;
 };
 
 VehicleMapItemModel::VehicleMapItemModel(domain::VehicleService* vehicleService,
@@ -100,30 +115,25 @@ QVariant VehicleMapItemModel::data(const QModelIndex& index, int role) const
         if (!data.isValid()) data = QVariant::fromValue(QGeoCoordinate());
         break;
     case HeadingRole:
-        data = node->childNode(domain::Telemetry::Ahrs)->
-                     childNode(domain::Telemetry::Compass)->parameter(
-                   domain::Telemetry::Heading);
-        if (!data.isValid()) data = 0;
+        data = ::realParameter(node->findChildNode({ domain::Telemetry::Ahrs,
+                                                     domain::Telemetry::Compass }),
+                               domain::Telemetry::Heading, 0);
         break;
     case CourseRole:
-        data = node->childNode(domain::Telemetry::Satellite)->parameter(
-                   domain::Telemetry::Course);
-        if (!data.isValid()) data = 0;
+        data = ::realParameter(node->findChildNode(domain::Telemetry::Satellite),
+                               domain::Telemetry::Course, 0);
         break;
     case GroundspeedRole:
-        data = node->childNode(domain::Telemetry::Satellite)->parameter(
-                   domain::Telemetry::Groundspeed);
-        if (!data.isValid()) data = 0;
+        data = ::realParameter(node->findChildNode(domain::Telemetry::Satellite),
+                               domain::Telemetry::Groundspeed, 0);
         break;
     case SnsFixRole:
-        data = node->childNode(domain::Telemetry::Satellite)->parameter(
-                   domain::Telemetry::Fix);
-        if (!data.isValid()) data = -1;
+        data = int(::realParameter(node->findChildNode(domain::Telemetry::Satellite),
+                                   domain::Telemetry::Fix, -1));
         break;
     case HdopRadiusRole:
-        data = node->childNode(domain::Telemetry::Satellite)->parameter(
-                   domain::Telemetry::Eph);
-        if (!data.isValid()) data = 0;
+        data = ::realParameter(node->findChildNode(domain::Telemetry::Satellite),
+                               domain::Telemetry::Eph, 0);
         break;
     case TrackRole:
         data = d->tracks[vehicleId];
@@ -142,35 +152,29 @@ void VehicleMapItemModel::onVehicleAdded(const dto::VehiclePtr& vehicle)
     domain::Telemetry* node = d->telemetryService->vehicleNode(vehicle->id());
     if (!node) return;
 
-    connect(node->childNode(domain::Telemetry::Position),
-            &domain::Telemetry::parametersChanged,
-            this, [this, vehicleId](const domain::Telemetry::TelemetryMap& parameters) {
-        this->onPositionParametersChanged(vehicleId, parameters);
-    });
+    this->subscribe(vehicleId, node->childNode(domain::Telemetry::Position),
+                    { domain::Telemetry::Coordinate },
+                    &VehicleMapItemModel::onPositionParametersChanged);
 
-    connect(node->childNode(domain::Telemetry::HomePosition),
-            &domain::Telemetry::parametersChanged,
-            this, [this, vehicleId](const domain::Telemetry::TelemetryMap& parameters) {
-        this->onHomeParametersChanged(vehicleId, parameters);
-    });
+    this->subscribe(vehicleId, node->childNode(domain::Telemetry::HomePosition),
+                    { domain::Telemetry::Coordinate },
+                    &VehicleMapItemModel::onHomeParametersChanged);
 
-    connect(node->childNode(domain::Telemetry::Navigator),
-            &domain::Telemetry::parametersChanged,
-            this, [this, vehicleId](const domain::Telemetry::TelemetryMap& parameters) {
-        this->onTargetParametersChanged(vehicleId, parameters);
-    });
+    this->subscribe(vehicleId, node->childNode(domain::Telemetry::Navigator),
+                    { domain::Telemetry::Coordinate },
+                    &VehicleMapItemModel::onTargetParametersChanged);
 
-    connect(node->childNode(domain::Telemetry::Ahrs),
-            &domain::Telemetry::parametersChanged,
-            this, [this, vehicleId](const domain::Telemetry::TelemetryMap& parameters) {
-        this->onAhrsParametersChanged(vehicleId, parameters);
-    });
+    this->subscribe(vehicleId, node->childNode({ domain::Telemetry::Ahrs,
+                                                 domain::Telemetry::Compass }),
+                    { domain::Telemetry::Heading },
+                    &VehicleMapItemModel::onAhrsParametersChanged)->setDeadband(
+                domain::Telemetry::Heading, ::headingDeadband);
 
-    connect(node->childNode(domain::Telemetry::Satellite),
-            &domain::Telemetry::parametersChanged,
-            this, [this, vehicleId](const domain::Telemetry::TelemetryMap& parameters) {
-        this->onSatelliteParametersChanged(vehicleId, parameters);
-    });
+    this->subscribe(vehicleId, node->childNode(domain::Telemetry::Satellite),
+                    { domain::Telemetry::Course, domain::Telemetry::Groundspeed,
+                      domain::Telemetry::Fix, domain::Telemetry::Eph },
+                    &VehicleMapItemModel::onSatelliteParametersChanged)->setDeadband(
+                domain::Telemetry::Course, ::headingDeadband);
 
     this->endInsertRows();
 }
@@ -183,6 +187,8 @@ void VehicleMapItemModel::onVehicleRemoved(const dto::VehiclePtr& vehicle)
     this->beginRemoveRows(QModelIndex(), row, row);
     d->vehicleIds.removeOne(vehicle->id());
     d->tracks.remove(vehicle->id());
+    qDeleteAll(d->subscriptions.values(vehicle->id()));
+    d->subscriptions.remove(vehicle->id());
 
     this->endRemoveRows();
 }
@@ -221,6 +227,22 @@ QModelIndex VehicleMapItemModel::vehicleIndex(int vehicleId) const
     return this->index(d->vehicleIds.indexOf(vehicleId));
 }
 
+domain::TelemetrySubscription* VehicleMapItemModel::subscribe(
+        int vehicleId, domain::Telemetry* node, const domain::Telemetry::TelemetryList& leaves,
+        void (VehicleMapItemModel::*slot)(int, const domain::Telemetry::TelemetryMap&))
+{
+    auto subscription = new domain::TelemetrySubscription(node, leaves, this);
+    subscription->setMaxRate(::maxMapRate);
+    d->subscriptions.insert(vehicleId, subscription);
+
+    connect(subscription, &domain::TelemetrySubscription::parametersChanged,
+            this, [this, vehicleId, slot](const domain::Telemetry::TelemetryMap& parameters) {
+        (this->*slot)(vehicleId, parameters);
+    });
+
+    return subscription;
+}
+
 void VehicleMapItemModel::onPositionParametersChanged(
         int vehicleId, const domain::Telemetry::TelemetryMap& parameters)
 {
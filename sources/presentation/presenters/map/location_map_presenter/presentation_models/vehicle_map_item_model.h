@@ -11,6 +11,7 @@
 namespace domain
 {
     class TelemetryService;
+    class TelemetrySubscription;
     class VehicleService;
     class Position;
     class Sns;
@@ -58,6 +59,11 @@ namespace presentation
 
         QModelIndex vehicleIndex(int vehicleId) const;
 
+        domain::TelemetrySubscription* subscribe(
+                int vehicleId, domain::Telemetry* node,
+                const domain::Telemetry::TelemetryList& leaves,
+                void (VehicleMapItemModel::*slot)(int, const domain::Telemetry::TelemetryMap&));
+
     private slots:
         void onPositionParametersChanged(
                 int vehicleId, const domain::Telemetry::TelemetryMap& parameters);
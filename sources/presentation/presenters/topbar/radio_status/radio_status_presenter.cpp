@@ -9,6 +9,8 @@
 #include "telemetry_service.h"
 #include "telemetry.h"
 
+#include "latency_monitor.h"
+
 using namespace presentation;
 
 class RadioStatusPresenter::Impl
@@ -30,6 +32,14 @@ RadioStatusPresenter::~RadioStatusPresenter()
 
 void RadioStatusPresenter::updateParameters()
 {
-    this->setViewProperty(PROPERTY(rssi), d->node->parameter(domain::Telemetry::Rssi));
-    this->setViewProperty(PROPERTY(remoteRssi), d->node->parameter(domain::Telemetry::RemoteRssi));
+    // Missing leaves stay invalid, as view shows no signal for them
+    auto value = [this](domain::Telemetry::TelemetryId id) {
+        return d->node->hasParameter(id) ? QVariant(d->node->realParameter(id)) : QVariant();
+    };
+
+    this->setViewProperty(PROPERTY(rssi), value(domain::Telemetry::Rssi));
+    this->setViewProperty(PROPERTY(remoteRssi), value(domain::Telemetry::RemoteRssi));
+
+    utils::LatencyMonitor::record(utils::LatencyMonitor::PresenterUpdate,
+                                  utils::LatencyMonitor::origin());
 }
@@ -28,6 +28,8 @@ ColumnLayout {
     property alias port: portBox.value
     property alias endpoints: endpointList.endpoints
     property alias autoResponse: autoResponseBox.checked
+    property alias fileName: fileNameField.text
+    property alias replaySpeed: replaySpeedBox.realValue
 
     onChangedChanged: {
         if (changed) return;
@@ -66,6 +68,7 @@ ColumnLayout {
                 case LinkDescription.Udp: return str + ": " + qsTr("UDP");
                 case LinkDescription.Tcp: return str + ": " + qsTr("TCP");
                 case LinkDescription.Bluetooth: return str + ": " + qsTr("Bluetooth");
+                case LinkDescription.Replay: return str + ": " + qsTr("Replay");
                 default: return str + ": " + qsTr("Unknown");
                 }
             }
@@ -190,6 +193,25 @@ ColumnLayout {
         Layout.fillWidth: true
     }
 
+    Controls.TextField {
+        id: fileNameField
+        labelText: qsTr("Tlog file")
+        visible: type == LinkDescription.Replay
+        onTextChanged: changed = true
+        Layout.fillWidth: true
+    }
+
+    Controls.RealSpinBox {
+        id: replaySpeedBox
+        labelText: qsTr("Speed (0 - max)")
+        visible: type == LinkDescription.Replay
+        realFrom: 0
+        realTo: 100
+        precision: 0.1
+        onRealValueChanged: changed = true
+        Layout.fillWidth: true
+    }
+
     Controls.CheckBox {
         id: autoResponseBox
         text: qsTr("Autoresponse on get data")
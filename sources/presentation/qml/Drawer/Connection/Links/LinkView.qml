@@ -96,6 +96,7 @@ Controls.Card {
                 case LinkDescription.Udp: return qsTr("UDP");
                 case LinkDescription.Tcp: return qsTr("TCP");
                 case LinkDescription.Bluetooth: return qsTr("Bluetooth");
+                case LinkDescription.Replay: return qsTr("Replay");
                 default: return qsTr("Unknown");
                 }
             }
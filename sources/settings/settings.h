@@ -15,6 +15,7 @@ namespace settings
         const QString systemId = "Communication/systemId";
         const QString componentId = "Communication/componentId";
         const QString retranslationEnabled = "Communication/retranslationEnabled";
+        const QString parseThreads = "Communication/parseThreads";
         const QString heartbeat = "Communication/heartbeat";
         const QString timeout = "Communication/timeout";
         const QString autoAdd = "Communication/autoAdd";
@@ -24,6 +25,21 @@ namespace settings
         const QString tcpAddress = "Communication/tcpAddress";
         const QString bluetoothAddress = "Communication/bluetoothAddress";
         const QString statisticsCount = "Communication/statisticsCount";
+        const QString recordTlog = "Communication/recordTlog";
+        const QString tlogPath = "Communication/tlogPath";
+    }
+
+    namespace telemetry
+    {
+        const QString history = "Telemetry/history";
+        const QString historyPath = "Telemetry/historyPath";
+        const QString historyLeaves = "Telemetry/historyLeaves";
+        const QString historySessions = "Telemetry/historySessions";
+    }
+
+    namespace diagnostics
+    {
+        const QString latency = "Diagnostics/latency";
     }
 
     namespace parameters
@@ -67,6 +83,7 @@ namespace settings
     {
         const QString enabled = "Manual/enabled";
         const QString interval = "Manual/interval";
+        const QString rcOverride = "Manual/rcOverride";
 
         namespace joystick
         {
@@ -114,6 +131,7 @@ namespace settings
         const QString fdRelativeAltitude = "Gui/fdRelativeAltitude";
         const QString vibrationModelCount = "Gui/vibrationModelCount";
         const QString coordinatesDms = "Gui/coordinatesDms";
+        const QString telemetryRate = "Gui/telemetryRate";
     }
 
     namespace proxy
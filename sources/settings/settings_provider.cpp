@@ -25,6 +25,7 @@ namespace
 
         { communication::systemId, 255 },
         { communication::componentId, 0 },
+        { communication::parseThreads, 0 },
         { communication::heartbeat, 1000 },
         { communication::timeout, 5000 },
         { communication::autoAdd, true },
@@ -34,6 +35,20 @@ namespace
         { communication::tcpAddress, "127.0.0.1" },
         { communication::bluetoothAddress, "00:00:00:00:00:00" },
         { communication::statisticsCount, 50 },
+        { communication::recordTlog, false },
+        { communication::tlogPath, QString() }, // application data location by default
+
+        { telemetry::history, false },
+        { telemetry::historyPath, QString() }, // application data location by default
+        { telemetry::historyLeaves, QStringList({ "Ahrs/Pitch", "Ahrs/Roll", "Ahrs/Yaw",
+                                                  "Barometric/AltitudeRelative",
+                                                  "Barometric/Climb",
+                                                  "Pitot/IndicatedAirspeed",
+                                                  "Satellite/Groundspeed",
+                                                  "Battery/Voltage", "System/Armed" }) },
+        { telemetry::historySessions, 50 },
+
+        { diagnostics::latency, false },
 
         { parameters::defaultAcceptanceRadius, 3 },
         { parameters::defaultTakeoffPitch, 15 },
@@ -65,6 +80,7 @@ namespace
 
         { manual::enabled, false },
         { manual::interval, 200 },
+        { manual::rcOverride, false },
         { manual::joystick::enabled, false },
         { manual::joystick::device, 0 },
         { manual::joystick::pitch::axis, 2 },
@@ -93,6 +109,7 @@ namespace
         { gui::fdRelativeAltitude, true },
         { gui::vibrationModelCount, 30 },
         { gui::coordinatesDms, true },
+        { gui::telemetryRate, 30 }, // Hz, zero publishes every change
 
         { proxy::type, 0 }
     };
@@ -0,0 +1,129 @@
+#include "latency_histogram.h"
+
+// Qt
+#include <QtAlgorithms>
+
+namespace
+{
+    // First bucket covers values below this one exactly
+    const qint64 exactLimit = 2 * utils::LatencyHistogram::subBucketCount;
+    const qint64 maxValue = (qint64(2 * utils::LatencyHistogram::subBucketCount) <<
+                             utils::LatencyHistogram::maxShift) - 1;
+}
+
+using namespace utils;
+
+LatencyHistogram::LatencyHistogram():
+    m_count(0),
+    m_total(0),
+    m_min(0),
+    m_max(0)
+{}
+
+void LatencyHistogram::record(qint64 value)
+{
+    value = qBound(qint64(0), value, ::maxValue);
+
+    m_buckets[LatencyHistogram::bucketIndex(value)].fetchAndAddRelaxed(1);
+    m_total.fetchAndAddRelaxed(value);
+
+    // Min is kept off by one, so zero means no values
+    qint64 min = m_min.loadAcquire();
+    while ((!min || value + 1 < min) && !m_min.testAndSetOrdered(min, value + 1, min)) {}
+
+    qint64 max = m_max.loadAcquire();
+    while (value > max && !m_max.testAndSetOrdered(max, value, max)) {}
+
+    m_count.fetchAndAddRelease(1);
+}
+
+void LatencyHistogram::reset()
+{
+    for (QAtomicInteger<quint64>& bucket: m_buckets) bucket.store(0);
+
+    m_total.store(0);
+    m_min.store(0);
+    m_max.store(0);
+    m_count.store(0);
+}
+
+quint64 LatencyHistogram::count() const
+{
+    return m_count.loadAcquire();
+}
+
+qint64 LatencyHistogram::min() const
+{
+    qint64 min = m_min.loadAcquire();
+    return min ? min - 1 : 0;
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return m_max.loadAcquire();
+}
+
+double LatencyHistogram::mean() const
+{
+    quint64 count = this->count();
+    return count ? double(m_total.loadAcquire()) / count : 0;
+}
+
+qint64 LatencyHistogram::percentile(double percent) const
+{
+    // Buckets are read one by one, concurrent records may make the sum differ from count
+    quint64 total = 0;
+    for (const QAtomicInteger<quint64>& bucket: m_buckets) total += bucket.loadAcquire();
+    if (!total) return 0;
+
+    quint64 target = qMax(quint64(1), quint64(qBound(0.0, percent, 100.0) / 100 * total + 0.5));
+    quint64 accumulated = 0;
+
+    for (int index = 0; index < bucketCount; ++index)
+    {
+        accumulated += m_buckets[index].loadAcquire();
+        if (accumulated >= target) return qMin(LatencyHistogram::bucketHighest(index), this->max());
+    }
+
+    return this->max();
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot snapshot;
+
+    snapshot.count = this->count();
+    snapshot.min = this->min();
+    snapshot.max = this->max();
+    snapshot.mean = this->mean();
+    snapshot.p50 = this->percentile(50);
+    snapshot.p90 = this->percentile(90);
+    snapshot.p99 = this->percentile(99);
+    snapshot.p999 = this->percentile(99.9);
+
+    return snapshot;
+}
+
+int LatencyHistogram::bucketIndex(qint64 value)
+{
+    if (value < ::exactLimit) return value;
+
+    int shift = 63 - qCountLeadingZeroBits(quint64(value)) - 5;
+    return shift * subBucketCount + int(value >> shift);
+}
+
+qint64 LatencyHistogram::bucketLowest(int index)
+{
+    if (index < ::exactLimit) return index;
+
+    int shift = index / subBucketCount - 1;
+    return qint64(index - shift * subBucketCount) << shift;
+}
+
+qint64 LatencyHistogram::bucketHighest(int index)
+{
+    if (index < ::exactLimit) return index;
+
+    int shift = index / subBucketCount - 1;
+    return LatencyHistogram::bucketLowest(index) + (qint64(1) << shift) - 1;
+}
@@ -0,0 +1,60 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+// Qt
+#include <QAtomicInteger>
+
+namespace utils
+{
+    // HDR-style histogram of microsecond values: exact below 64 us, then 32 linear sub-buckets
+    // per power of two, so every value keeps 3% precision up to a day. Recording is lock-free.
+    class LatencyHistogram
+    {
+    public:
+        struct Snapshot
+        {
+            quint64 count;
+            qint64 min;
+            qint64 max;
+            double mean;
+            qint64 p50;
+            qint64 p90;
+            qint64 p99;
+            qint64 p999;
+        };
+
+        LatencyHistogram();
+
+        // Any thread
+        void record(qint64 value);
+        void reset();
+
+        quint64 count() const;
+        qint64 min() const;
+        qint64 max() const;
+        double mean() const;
+
+        // Highest value, equivalent to the percentile bucket
+        qint64 percentile(double percent) const;
+        Snapshot snapshot() const;
+
+        static int bucketIndex(qint64 value);
+        static qint64 bucketLowest(int index);
+        static qint64 bucketHighest(int index);
+
+        static const int subBucketCount = 32;
+        static const int maxShift = 31;
+        static const int bucketCount = (maxShift + 2) * subBucketCount;
+
+    private:
+        QAtomicInteger<quint64> m_buckets[bucketCount];
+        QAtomicInteger<quint64> m_count;
+        QAtomicInteger<quint64> m_total;
+        QAtomicInteger<qint64> m_min;
+        QAtomicInteger<qint64> m_max;
+
+        Q_DISABLE_COPY(LatencyHistogram)
+    };
+}
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,117 @@
+#include "latency_monitor.h"
+
+// Qt
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QStringList>
+
+namespace
+{
+    QAtomicInt enabled(0);
+    thread_local qint64 threadOrigin = 0;
+
+    utils::LatencyHistogram histograms[utils::LatencyMonitor::StageCount];
+
+    const char* stageNames[utils::LatencyMonitor::StageCount] =
+    {
+        "Link read",
+        "Parse",
+        "Handler decode",
+        "Portion delivery",
+        "Telemetry notify",
+        "Presenter update",
+        "Manual control"
+    };
+
+    QElapsedTimer& clock()
+    {
+        static QElapsedTimer timer;
+        static bool started = (timer.start(), true);
+        Q_UNUSED(started)
+
+        return timer;
+    }
+}
+
+using namespace utils;
+
+bool LatencyMonitor::isEnabled()
+{
+    return ::enabled.load();
+}
+
+void LatencyMonitor::setEnabled(bool enabled)
+{
+    ::clock();
+    ::enabled.store(enabled);
+}
+
+qint64 LatencyMonitor::now()
+{
+    if (!::enabled.load()) return 0;
+
+    // Shifted by one, zero stays for the unknown origin
+    return ::clock().nsecsElapsed() / 1000 + 1;
+}
+
+qint64 LatencyMonitor::origin()
+{
+    return ::threadOrigin;
+}
+
+void LatencyMonitor::setOrigin(qint64 origin)
+{
+    ::threadOrigin = origin;
+}
+
+void LatencyMonitor::record(Stage stage, qint64 origin)
+{
+    if (!origin) return;
+
+    qint64 time = LatencyMonitor::now();
+    if (time) ::histograms[stage].record(time - origin);
+}
+
+const LatencyHistogram& LatencyMonitor::histogram(Stage stage)
+{
+    return ::histograms[stage];
+}
+
+QString LatencyMonitor::stageName(Stage stage)
+{
+    return ::stageNames[stage];
+}
+
+QString LatencyMonitor::report()
+{
+    QStringList lines;
+    lines.append(QString("%1 %2 %3 %4 %5 %6 %7").arg("Stage", -18).arg("count", 10)
+                 .arg("p50,us", 10).arg("p90,us", 10).arg("p99,us", 10).arg("p99.9,us", 10)
+                 .arg("max,us", 10));
+
+    for (int stage = 0; stage < StageCount; ++stage)
+    {
+        LatencyHistogram::Snapshot snapshot = ::histograms[stage].snapshot();
+        lines.append(QString("%1 %2 %3 %4 %5 %6 %7").arg(::stageNames[stage], -18)
+                     .arg(snapshot.count, 10).arg(snapshot.p50, 10).arg(snapshot.p90, 10)
+                     .arg(snapshot.p99, 10).arg(snapshot.p999, 10).arg(snapshot.max, 10));
+    }
+
+    return lines.join('\n');
+}
+
+void LatencyMonitor::reset()
+{
+    for (LatencyHistogram& histogram: ::histograms) histogram.reset();
+}
+
+LatencyScope::LatencyScope(qint64 origin):
+    m_previous(::threadOrigin)
+{
+    ::threadOrigin = origin;
+}
+
+LatencyScope::~LatencyScope()
+{
+    ::threadOrigin = m_previous;
+}
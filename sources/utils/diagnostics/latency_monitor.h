@@ -0,0 +1,64 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+// Qt
+#include <QString>
+
+// Internal
+#include "latency_histogram.h"
+
+namespace utils
+{
+    // Optional end-to-end latency tracing of received data. Origin is a monotonic timestamp of
+    // link read, it goes with thread data inside a thread and with queued items between threads.
+    // Every stage records latency from the origin to the moment the stage is passed.
+    // Manual control is traced the other way, from the stick input to the sent message.
+    class LatencyMonitor
+    {
+    public:
+        enum Stage
+        {
+            LinkRead,
+            Parse,
+            HandlerDecode,
+            PortionDelivery,
+            TelemetryNotify,
+            PresenterUpdate,
+            ManualControl,
+
+            StageCount
+        };
+
+        static bool isEnabled();
+        static void setEnabled(bool enabled);
+
+        // Monotonic microseconds, zero if tracing is disabled
+        static qint64 now();
+
+        // Origin of data, processed by the current thread, zero if unknown
+        static qint64 origin();
+        static void setOrigin(qint64 origin);
+
+        static void record(Stage stage, qint64 origin);
+
+        static const LatencyHistogram& histogram(Stage stage);
+        static QString stageName(Stage stage);
+        static QString report();
+        static void reset();
+    };
+
+    // Sets thread origin for the scope and restores the previous one
+    class LatencyScope
+    {
+    public:
+        explicit LatencyScope(qint64 origin);
+        ~LatencyScope();
+
+    private:
+        const qint64 m_previous;
+
+        Q_DISABLE_COPY(LatencyScope)
+    };
+}
+
+#endif // LATENCY_MONITOR_H
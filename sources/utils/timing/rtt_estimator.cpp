@@ -0,0 +1,72 @@
+#include "rtt_estimator.h"
+
+namespace
+{
+    // RFC 6298 gains
+    const double alpha = 0.125;
+    const double beta = 0.25;
+    const int maxBackOff = 6;
+}
+
+using namespace utils;
+
+RttEstimator::RttEstimator(int initialTimeout, int minTimeout, int maxTimeout):
+    m_initialTimeout(initialTimeout),
+    m_minTimeout(minTimeout),
+    m_maxTimeout(maxTimeout)
+{}
+
+bool RttEstimator::hasSamples() const
+{
+    return m_hasSamples;
+}
+
+int RttEstimator::smoothed() const
+{
+    return qRound(m_smoothed);
+}
+
+int RttEstimator::variation() const
+{
+    return qRound(m_variation);
+}
+
+int RttEstimator::timeout() const
+{
+    double timeout = m_hasSamples ? m_smoothed + 4 * m_variation : m_initialTimeout;
+    timeout *= 1 << m_backOff;
+
+    return qBound(m_minTimeout, qRound(qMin(timeout, double(m_maxTimeout))), m_maxTimeout);
+}
+
+void RttEstimator::addSample(qint64 rtt)
+{
+    if (rtt < 0) return;
+
+    if (m_hasSamples)
+    {
+        m_variation = (1 - ::beta) * m_variation + ::beta * qAbs(m_smoothed - rtt);
+        m_smoothed = (1 - ::alpha) * m_smoothed + ::alpha * rtt;
+    }
+    else
+    {
+        m_smoothed = rtt;
+        m_variation = rtt / 2.0;
+        m_hasSamples = true;
+    }
+
+    m_backOff = 0;
+}
+
+void RttEstimator::backOff()
+{
+    if (m_backOff < ::maxBackOff) m_backOff++;
+}
+
+void RttEstimator::reset()
+{
+    m_smoothed = 0;
+    m_variation = 0;
+    m_hasSamples = false;
+    m_backOff = 0;
+}
@@ -0,0 +1,40 @@
+#ifndef RTT_ESTIMATOR_H
+#define RTT_ESTIMATOR_H
+
+// Qt
+#include <QtGlobal>
+
+namespace utils
+{
+    // Retransmission timeout from the measured round trip, as TCP does: smoothed round trip
+    // plus four variations. Timeout doubles on every loss until the next sample comes.
+    class RttEstimator
+    {
+    public:
+        explicit RttEstimator(int initialTimeout = 1000, int minTimeout = 200,
+                              int maxTimeout = 5000);
+
+        bool hasSamples() const;
+        int smoothed() const; // ms, zero without samples
+        int variation() const;
+
+        int timeout() const;
+
+        // Samples of the retransmitted requests are ambiguous and must not be added
+        void addSample(qint64 rtt);
+        void backOff();
+        void reset();
+
+    private:
+        int m_initialTimeout; // not const, estimators are kept in containers by value
+        int m_minTimeout;
+        int m_maxTimeout;
+
+        double m_smoothed = 0;
+        double m_variation = 0;
+        bool m_hasSamples = false;
+        int m_backOff = 0;
+    };
+}
+
+#endif // RTT_ESTIMATOR_H
@@ -0,0 +1,95 @@
+#include "timing_wheel.h"
+
+using namespace utils;
+
+TimingWheel::TimingWheel(int tick, int slots):
+    m_tick(qMax(tick, 1)),
+    m_slots(qMax(slots, 1))
+{}
+
+int TimingWheel::tick() const
+{
+    return m_tick;
+}
+
+bool TimingWheel::isEmpty() const
+{
+    return m_entries.isEmpty();
+}
+
+int TimingWheel::count() const
+{
+    return m_entries.count();
+}
+
+bool TimingWheel::contains(quint64 id) const
+{
+    return m_entries.contains(id);
+}
+
+qint64 TimingWheel::deadline(quint64 id) const
+{
+    auto it = m_entries.constFind(id);
+    return it != m_entries.constEnd() ? it->deadline : -1;
+}
+
+void TimingWheel::schedule(quint64 id, qint64 deadline)
+{
+    this->cancel(id);
+
+    // Deadline in the processed tick goes to the next one
+    qint64 tick = qMax(deadline / m_tick, m_processed + 1);
+
+    int slot = int(tick % m_slots.count());
+
+    m_slots[slot].insert(id);
+    m_entries.insert(id, { deadline, slot });
+}
+
+void TimingWheel::cancel(quint64 id)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) return;
+
+    m_slots[it->slot].remove(id);
+    m_entries.erase(it);
+}
+
+void TimingWheel::clear()
+{
+    for (QSet<quint64>& slot: m_slots) slot.clear();
+    m_entries.clear();
+}
+
+QList<quint64> TimingWheel::advance(qint64 now)
+{
+    QList<quint64> expired;
+
+    // Tick is processed when it is over, so every deadline of it has passed
+    qint64 last = now / m_tick - 1;
+    if (last <= m_processed) return expired;
+
+    // Slots are visited once, even if more than a turn has passed
+    qint64 first = qMax(m_processed + 1, last - m_slots.count() + 1);
+    m_processed = last;
+
+    for (qint64 tick = first; tick <= last; ++tick)
+    {
+        QSet<quint64>& slot = m_slots[int(tick % m_slots.count())];
+
+        for (auto it = slot.begin(); it != slot.end();)
+        {
+            if (m_entries.value(*it).deadline > now)
+            {
+                ++it;
+                continue;
+            }
+
+            expired.append(*it);
+            m_entries.remove(*it);
+            it = slot.erase(it);
+        }
+    }
+
+    return expired;
+}
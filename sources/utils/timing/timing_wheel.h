@@ -0,0 +1,50 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+// Qt
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QList>
+
+namespace utils
+{
+    // Hashed timing wheel: timeouts are kept in slots of one tick, so scheduling and cancel are
+    // O(1) and one periodic timer serves all of them. Deadlines beyond one turn of the wheel
+    // stay in their slot for the next turns. Timeouts fire not earlier than the deadline and
+    // not later than one tick after it.
+    class TimingWheel
+    {
+    public:
+        explicit TimingWheel(int tick = 10, int slots = 256);
+
+        int tick() const; // ms
+
+        bool isEmpty() const;
+        int count() const;
+        bool contains(quint64 id) const;
+        qint64 deadline(quint64 id) const; // -1 if not scheduled
+
+        // Replaces the previous deadline of the id
+        void schedule(quint64 id, qint64 deadline);
+        void cancel(quint64 id);
+        void clear();
+
+        // Ids with passed deadlines are taken out of the wheel
+        QList<quint64> advance(qint64 now);
+
+    private:
+        struct Entry
+        {
+            qint64 deadline;
+            int slot;
+        };
+
+        const int m_tick;
+        QVector< QSet<quint64> > m_slots;
+        QHash<quint64, Entry> m_entries;
+        qint64 m_processed = -1; // last tick, which slot is processed
+    };
+}
+
+#endif // TIMING_WHEEL_H
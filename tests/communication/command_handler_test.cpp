@@ -0,0 +1,186 @@
+#include "command_handler_test.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QElapsedTimer>
+
+// Internal
+#include "mavlink_communicator.h"
+#include "command_handler.h"
+#include "vehicle_simulator.h"
+
+#include "service_registry.h"
+#include "command_service.h"
+#include "manual_control_channel.h"
+#include "vehicle_service.h"
+#include "vehicle.h"
+
+#include "settings_provider.h"
+
+#include "pipe_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint8 gcsSysId = 255;
+    const quint8 gcsCompId = 0;
+    const quint8 mavId = 22; // not taken by vehicles of the other tests
+    const int timeout = 5000;
+
+    const int manualInterval = 20; // ms, rate cap of the handler
+    const int postDuration = 500; // ms, samples come much faster than the cap
+
+    // Simulator takes the last channel
+    const quint8 sentChannel = MAVLINK_COMM_NUM_BUFFERS - 2;
+
+    int count(const QList<mavlink_message_t>& messages, quint32 msgId)
+    {
+        int found = 0;
+        for (const mavlink_message_t& message: messages)
+        {
+            if (message.msgid == msgId) found++;
+        }
+        return found;
+    }
+
+    // Ground station with CommandHandler and a simulated vehicle to have its link known
+    class Bench
+    {
+    public:
+        sim::VehicleSimulator simulator;
+        PipeLink* vehicleLink = new PipeLink();
+        MavLinkCommunicator communicator;
+        PipeLink* groundLink = new PipeLink();
+
+        domain::VehicleService* vehicleService = domain::ServiceRegistry::vehicleService();
+        domain::ManualControlChannel* channel =
+                domain::ServiceRegistry::commandService()->manualControl();
+
+        dto::VehiclePtr vehicle = dto::VehiclePtr::create();
+
+        Bench():
+            communicator(::gcsSysId, ::gcsCompId, false)
+        {
+            groundLink->setParent(&communicator);
+            groundLink->peer = vehicleLink;
+            vehicleLink->peer = groundLink;
+
+            simulator.setLink(vehicleLink);
+            simulator.setVehicleCount(1, ::mavId);
+
+            communicator.addLink(groundLink);
+            communicator.addHandler(new CommandHandler(&communicator));
+
+            vehicle->setName("Command handler vehicle");
+            vehicle->setMavId(::mavId);
+            vehicleService->save(vehicle);
+
+            simulator.start();
+        }
+
+        ~Bench()
+        {
+            simulator.stop();
+            vehicleLink->peer = nullptr;
+            groundLink->peer = nullptr;
+
+            vehicleService->remove(vehicle);
+        }
+
+        bool isVehicleOnline()
+        {
+            return communicator.mavSystemLink(::mavId);
+        }
+
+        void post(float pitch)
+        {
+            domain::ManualControlChannel::Sample sample;
+            sample.vehicleId = vehicle->id();
+            sample.pitch = pitch;
+            channel->post(sample);
+        }
+
+        // Manual control messages of the ground station since the last call
+        QList<mavlink_message_t> takeSent()
+        {
+            QList<mavlink_message_t> messages;
+            for (const mavlink_message_t& message: ::takeMessages(groundLink->sent,
+                                                                  ::sentChannel))
+            {
+                if (message.msgid == MAVLINK_MSG_ID_MANUAL_CONTROL ||
+                    message.msgid == MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE)
+                {
+                    messages.append(message);
+                }
+            }
+            return messages;
+        }
+    };
+}
+
+void CommandHandlerTest::testManualRateCap()
+{
+    Bench bench;
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    QVariant rcOverride = settings::Provider::value(settings::manual::rcOverride);
+    settings::Provider::setValue(settings::manual::rcOverride, false);
+    bench.takeSent();
+
+    // Sample per millisecond, the one held back is replaced by the newer
+    QElapsedTimer timer;
+    timer.start();
+    int posted = 0;
+    float pitch = 0;
+    while (timer.elapsed() < ::postDuration)
+    {
+        pitch = ++posted * 0.001f;
+        bench.post(pitch);
+        QTest::qWait(1);
+    }
+    QTest::qWait(::manualInterval * 2);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    int manuals = ::count(sent, MAVLINK_MSG_ID_MANUAL_CONTROL);
+    QVERIFY(manuals <= int(timer.elapsed() / ::manualInterval) + 1);
+    QVERIFY(manuals >= ::postDuration / ::manualInterval / 2);
+    QVERIFY(manuals < posted);
+
+    // Latest sample is sent after the burst, nothing is left in the channel
+    mavlink_manual_control_t manual;
+    mavlink_msg_manual_control_decode(&sent.last(), &manual);
+    QCOMPARE(manual.x, qint16(pitch * 1000));
+
+    domain::ManualControlChannel::Sample sample;
+    QVERIFY(!bench.channel->take(&sample));
+
+    settings::Provider::setValue(settings::manual::rcOverride, rcOverride);
+}
+
+void CommandHandlerTest::testRcOverrideSwitch()
+{
+    Bench bench;
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    QVariant rcOverride = settings::Provider::value(settings::manual::rcOverride);
+    bench.takeSent();
+
+    // Setting applies to the next sample of the running handler
+    settings::Provider::setValue(settings::manual::rcOverride, true);
+    bench.post(0.5);
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE), 1);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MANUAL_CONTROL), 0);
+
+    settings::Provider::setValue(settings::manual::rcOverride, false);
+    QTest::qWait(::manualInterval * 2);
+    bench.post(0.5);
+    sent = bench.takeSent();
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE), 0);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MANUAL_CONTROL), 1);
+
+    settings::Provider::setValue(settings::manual::rcOverride, rcOverride);
+}
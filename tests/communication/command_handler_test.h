@@ -0,0 +1,15 @@
+#ifndef COMMAND_HANDLER_TEST_H
+#define COMMAND_HANDLER_TEST_H
+
+#include <QTest>
+
+class CommandHandlerTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testManualRateCap();
+    void testRcOverrideSwitch();
+};
+
+#endif // COMMAND_HANDLER_TEST_H
@@ -0,0 +1,108 @@
+#include "link_receive_test.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QUdpSocket>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+// Internal
+#include "udp_link.h"
+#include "mavlink_communicator.h"
+
+#include "allocation_counter.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint16 port = 60010;
+    const int warmUpDatagrams = 10;
+    const int countedDatagrams = 100;
+    const int timeout = 2000;
+
+    QByteArray heartbeatPacket()
+    {
+        mavlink_message_t message;
+        mavlink_heartbeat_t heartbeat = {};
+        mavlink_msg_heartbeat_encode(1, 1, &message, &heartbeat);
+
+        quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+        int lenght = mavlink_msg_to_send_buffer(buffer, &message);
+
+        return QByteArray((const char*)buffer, lenght);
+    }
+}
+
+void LinkReceiveTest::testUdpReceiveAllocations()
+{
+    UdpLink link(::port);
+    link.setAutoResponse(false);
+    link.connectLink();
+    QVERIFY(link.isConnected());
+
+    MavLinkCommunicator communicator(255, 0, false);
+    communicator.addLink(&link);
+
+    int received = 0;
+    QObject::connect(&link, &AbstractLink::dataReceived, [&received]() { received++; });
+
+    QUdpSocket sender;
+    const QByteArray packet = ::heartbeatPacket();
+
+    auto send = [&](int count) {
+        for (int i = 0; i < count; ++i)
+        {
+            sender.writeDatagram(packet, QHostAddress::LocalHost, ::port);
+        }
+    };
+
+    auto waitReceived = [&](int count) {
+        QElapsedTimer timer;
+        timer.start();
+        while (received < count && !timer.hasExpired(::timeout))
+        {
+            QCoreApplication::processEvents();
+        }
+        return received == count;
+    };
+
+    // First datagrams grow link buffer and communicator's per-system state
+    send(::warmUpDatagrams);
+    QVERIFY(waitReceived(::warmUpDatagrams));
+
+    send(::countedDatagrams);
+
+    quint64 allocations = allocation_counter::count();
+    QVERIFY(waitReceived(::warmUpDatagrams + ::countedDatagrams));
+    QCOMPARE(allocation_counter::count() - allocations, quint64(0));
+}
+
+void LinkReceiveTest::testUdpLargeDatagram()
+{
+    UdpLink link(::port);
+    link.setAutoResponse(false);
+    link.connectLink();
+    QVERIFY(link.isConnected());
+
+    QList<QByteArray> received;
+    QObject::connect(&link, &AbstractLink::dataReceived,
+                     [&received](const QByteArray& data) { received.append(data); });
+
+    // Datagram larger than the MTU slot comes whole, in the batch after the first one
+    QByteArray large(5000, Qt::Uninitialized);
+    for (int i = 0; i < large.size(); ++i) large[i] = char(i % 251);
+
+    QUdpSocket sender;
+    const QByteArray packet = ::heartbeatPacket();
+    sender.writeDatagram(packet, QHostAddress::LocalHost, ::port);
+    sender.writeDatagram(large, QHostAddress::LocalHost, ::port);
+    sender.writeDatagram(packet, QHostAddress::LocalHost, ::port);
+
+    QTRY_COMPARE_WITH_TIMEOUT(received.count(), 3, ::timeout);
+    QCOMPARE(received.at(0), packet);
+    QCOMPARE(received.at(1), large);
+    QCOMPARE(received.at(2), packet);
+}
@@ -0,0 +1,15 @@
+#ifndef LINK_RECEIVE_TEST_H
+#define LINK_RECEIVE_TEST_H
+
+#include <QTest>
+
+class LinkReceiveTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testUdpReceiveAllocations();
+    void testUdpLargeDatagram();
+};
+
+#endif // LINK_RECEIVE_TEST_H
@@ -0,0 +1,114 @@
+#include "mavlink_frame_parser_test.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QDebug>
+
+// Internal
+#include "mavlink_frame_parser.h"
+
+using namespace comm;
+
+namespace
+{
+    QByteArray toPacket(const mavlink_message_t& message)
+    {
+        quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+        int lenght = mavlink_msg_to_send_buffer(buffer, &message);
+
+        return QByteArray((const char*)buffer, lenght);
+    }
+
+    QByteArray telemetryStream()
+    {
+        mavlink_message_t message;
+        QByteArray stream;
+
+        mavlink_heartbeat_t heartbeat = {};
+        heartbeat.custom_mode = 42;
+        mavlink_msg_heartbeat_encode(1, 1, &message, &heartbeat);
+        stream.append(::toPacket(message));
+
+        mavlink_attitude_t attitude = {};
+        attitude.pitch = 0.5;
+        mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+        stream.append(::toPacket(message));
+
+        mavlink_vfr_hud_t vfrHud = {};
+        vfrHud.heading = 270;
+        mavlink_msg_vfr_hud_encode(2, 1, &message, &vfrHud);
+        stream.append(::toPacket(message));
+
+        return stream;
+    }
+
+    QList<mavlink_message_t> parse(MavLinkFrameParser& parser, const QByteArray& data)
+    {
+        QList<mavlink_message_t> messages;
+        mavlink_message_t message;
+
+        parser.setData(data.constData(), data.size());
+        while (parser.next(message)) messages.append(message);
+
+        return messages;
+    }
+
+    void verifyStream(const QList<mavlink_message_t>& messages)
+    {
+        QCOMPARE(messages.count(), 3);
+
+        QCOMPARE(quint32(messages.at(0).msgid), quint32(MAVLINK_MSG_ID_HEARTBEAT));
+        QCOMPARE(mavlink_msg_heartbeat_get_custom_mode(&messages.at(0)), quint32(42));
+
+        QCOMPARE(quint32(messages.at(1).msgid), quint32(MAVLINK_MSG_ID_ATTITUDE));
+        QCOMPARE(mavlink_msg_attitude_get_pitch(&messages.at(1)), float(0.5));
+
+        QCOMPARE(quint32(messages.at(2).msgid), quint32(MAVLINK_MSG_ID_VFR_HUD));
+        QCOMPARE(int(messages.at(2).sysid), 2);
+        QCOMPARE(mavlink_msg_vfr_hud_get_heading(&messages.at(2)), qint16(270));
+    }
+}
+
+void MavLinkFrameParserTest::testWholeFrames()
+{
+    MavLinkFrameParser parser(0);
+
+    ::verifyStream(::parse(parser, "garbage" + ::telemetryStream()));
+
+    QCOMPARE(parser.packetsReceived(), 3);
+    QCOMPARE(parser.packetsDrops(), 0);
+}
+
+void MavLinkFrameParserTest::testSplittedFrames()
+{
+    QByteArray stream = ::telemetryStream();
+
+    for (int boundary = 1; boundary < stream.size(); ++boundary)
+    {
+        MavLinkFrameParser parser(1);
+
+        QList<mavlink_message_t> messages = ::parse(parser, stream.left(boundary));
+        messages.append(::parse(parser, stream.mid(boundary)));
+
+        ::verifyStream(messages);
+        QCOMPARE(parser.packetsDrops(), 0);
+    }
+}
+
+void MavLinkFrameParserTest::testBrokenFrame()
+{
+    QByteArray stream = ::telemetryStream();
+    QByteArray broken = stream;
+
+    // Corrupt heartbeat header
+    broken[8] = broken[8] ^ 0xFF;
+
+    MavLinkFrameParser parser(2);
+    QList<mavlink_message_t> messages = ::parse(parser, broken + stream);
+
+    QCOMPARE(messages.count(), 5);
+    QCOMPARE(parser.packetsReceived(), 5);
+    QVERIFY(parser.packetsDrops() > 0);
+}
@@ -0,0 +1,16 @@
+#ifndef MAVLINK_FRAME_PARSER_TEST_H
+#define MAVLINK_FRAME_PARSER_TEST_H
+
+#include <QTest>
+
+class MavLinkFrameParserTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testWholeFrames();
+    void testSplittedFrames();
+    void testBrokenFrame();
+};
+
+#endif // MAVLINK_FRAME_PARSER_TEST_H
@@ -0,0 +1,109 @@
+#include "mavlink_message_queue_test.h"
+
+// Qt
+#include <QThread>
+#include <QVector>
+
+// Internal
+#include "mavlink_message_queue.h"
+
+using namespace comm;
+
+namespace
+{
+    const int producersCount = 4;
+    const int messagesCount = 100000;
+
+    class Producer: public QThread
+    {
+    public:
+        Producer(MavLinkMessageQueue* queue, quint32 id):
+            m_queue(queue),
+            m_id(id)
+        {}
+
+    protected:
+        void run() override
+        {
+            MavLinkMessageQueue::Item item;
+            item.link = nullptr;
+            item.generation = m_id;
+
+            for (int i = 0; i < ::messagesCount; ++i)
+            {
+                item.message.seq = i;
+                item.message.msgid = i >> 8;
+                while (!m_queue->push(item)) m_queue->waitForSpace(10);
+            }
+        }
+
+    private:
+        MavLinkMessageQueue* const m_queue;
+        const quint32 m_id;
+    };
+}
+
+void MavLinkMessageQueueTest::testFullQueue()
+{
+    MavLinkMessageQueue queue(10);
+    QCOMPARE(queue.capacity(), 16);
+
+    MavLinkMessageQueue::Item item;
+    item.link = nullptr;
+
+    for (int i = 0; i < queue.capacity(); ++i)
+    {
+        item.generation = i;
+        QVERIFY(queue.push(item));
+    }
+    QVERIFY(!queue.push(item));
+
+    QVERIFY(queue.requestDrain());
+    QVERIFY(!queue.requestDrain());
+    queue.drainStarted();
+
+    for (int i = 0; i < queue.capacity(); ++i)
+    {
+        QVERIFY(queue.pop(item));
+        QCOMPARE(item.generation, quint32(i));
+    }
+    QVERIFY(!queue.pop(item));
+    QVERIFY(queue.requestDrain());
+}
+
+void MavLinkMessageQueueTest::testMultipleProducers()
+{
+    MavLinkMessageQueue queue(256);
+
+    QList<Producer*> producers;
+    for (int i = 0; i < ::producersCount; ++i)
+    {
+        producers.append(new Producer(&queue, i));
+        producers.last()->start();
+    }
+
+    // Every producer messages must come in order, nothing lost or duplicated
+    QVector<int> expected(::producersCount, 0);
+    int popped = 0;
+    MavLinkMessageQueue::Item item;
+
+    while (popped < ::producersCount * ::messagesCount)
+    {
+        if (!queue.pop(item))
+        {
+            QThread::yieldCurrentThread();
+            continue;
+        }
+
+        int& next = expected[item.generation];
+        QCOMPARE(int(item.message.seq) | (int(item.message.msgid) << 8), next);
+        next++;
+        popped++;
+    }
+
+    for (Producer* producer: producers) producer->wait();
+    qDeleteAll(producers);
+
+    QVERIFY(!queue.pop(item));
+    for (int count: expected) QCOMPARE(count, ::messagesCount);
+}
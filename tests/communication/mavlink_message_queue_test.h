@@ -0,0 +1,15 @@
+#ifndef MAVLINK_MESSAGE_QUEUE_TEST_H
+#define MAVLINK_MESSAGE_QUEUE_TEST_H
+
+#include <QTest>
+
+class MavLinkMessageQueueTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testFullQueue();
+    void testMultipleProducers();
+};
+
+#endif // MAVLINK_MESSAGE_QUEUE_TEST_H
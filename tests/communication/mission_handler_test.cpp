@@ -0,0 +1,394 @@
+#include "mission_handler_test.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QGeoCoordinate>
+
+// Internal
+#include "mavlink_communicator.h"
+#include "mission_handler.h"
+#include "vehicle_simulator.h"
+
+#include "service_registry.h"
+#include "mission_service.h"
+#include "vehicle_service.h"
+
+#include "mission.h"
+#include "mission_item.h"
+#include "mission_assignment.h"
+#include "vehicle.h"
+
+#include "pipe_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint8 gcsSysId = 255;
+    const quint8 gcsCompId = 0;
+    const quint8 mavId = 21; // not taken by vehicles of the other tests
+    const int itemCount = 3;
+    const int timeout = 10000; // ms, fallbacks wait for retransmissions
+
+    // Frames of the both sides are parsed again, simulator takes the last channel
+    const quint8 sentChannel = MAVLINK_COMM_NUM_BUFFERS - 2;
+    const quint8 receivedChannel = MAVLINK_COMM_NUM_BUFFERS - 3;
+
+    // Degrees * 1e7, last digit is about a centimetre, float keeps only the fifth one
+    const qint32 latitude = 551234567;
+    const qint32 longitude = 377654321;
+
+    int count(const QList<mavlink_message_t>& messages, quint32 msgId)
+    {
+        int found = 0;
+        for (const mavlink_message_t& message: messages)
+        {
+            if (message.msgid == msgId) found++;
+        }
+        return found;
+    }
+
+    const mavlink_message_t* find(const QList<mavlink_message_t>& messages, quint32 msgId)
+    {
+        for (const mavlink_message_t& message: messages)
+        {
+            if (message.msgid == msgId) return &message;
+        }
+        return nullptr;
+    }
+
+    QGeoCoordinate coordinate(int seq)
+    {
+        return QGeoCoordinate((::latitude + seq) / 1e7, (::longitude - seq) / 1e7);
+    }
+
+    // Ground station with MissionHandler and a simulated vehicle, which has the mission assigned
+    class Bench
+    {
+    public:
+        sim::VehicleSimulator simulator;
+        PipeLink* vehicleLink = new PipeLink();
+        QScopedPointer<MavLinkCommunicator> communicator;
+        PipeLink* groundLink = nullptr;
+
+        domain::MissionService* missionService = domain::ServiceRegistry::missionService();
+        domain::VehicleService* vehicleService = domain::ServiceRegistry::vehicleService();
+
+        dto::VehiclePtr vehicle = dto::VehiclePtr::create();
+        dto::MissionPtr mission = dto::MissionPtr::create();
+
+        Bench()
+        {
+            simulator.setLink(vehicleLink);
+            simulator.setVehicleCount(1, ::mavId);
+            this->restartGroundStation();
+
+            vehicle->setName("Mission handler vehicle");
+            vehicle->setMavId(::mavId);
+            vehicleService->save(vehicle);
+
+            mission->setName("Mission handler mission");
+            missionService->save(mission);
+
+            missionService->addNewMissionItem(mission->id(), dto::MissionItem::Home, 0,
+                                              ::coordinate(0));
+            for (int seq = 1; seq < ::itemCount; ++seq)
+            {
+                missionService->addNewMissionItem(mission->id(), dto::MissionItem::Waypoint,
+                                                  seq, ::coordinate(seq));
+            }
+            missionService->assign(mission->id(), vehicle->id());
+
+            simulator.start();
+        }
+
+        ~Bench()
+        {
+            simulator.stop();
+            vehicleLink->peer = nullptr;
+            communicator.reset();
+
+            missionService->remove(mission);
+            vehicleService->remove(vehicle);
+        }
+
+        sim::SimulatedVehicle* simulated() const
+        {
+            return simulator.vehicle(::mavId);
+        }
+
+        dto::MissionAssignmentPtr assignment() const
+        {
+            return missionService->missionAssignment(mission->id());
+        }
+
+        dto::MissionItemPtr item(int seq) const
+        {
+            return missionService->missionItem(mission->id(), seq);
+        }
+
+        QVector<uint> onboardHashes() const
+        {
+            return missionService->vehicleItemHashes(vehicle->id());
+        }
+
+        bool isVehicleOnline() const
+        {
+            return communicator->mavSystemLink(::mavId);
+        }
+
+        // Vehicle capabilities, learned by the handler, are lost with the restart
+        void restartGroundStation()
+        {
+            vehicleLink->peer = nullptr;
+            communicator.reset(new MavLinkCommunicator(::gcsSysId, ::gcsCompId, false));
+
+            groundLink = new PipeLink();
+            groundLink->setParent(communicator.data());
+            groundLink->peer = vehicleLink;
+            vehicleLink->peer = groundLink;
+
+            communicator->addLink(groundLink);
+            communicator->addHandler(new MissionHandler(communicator.data()));
+        }
+
+        void requestCapabilities()
+        {
+            mavlink_command_long_t command = {};
+            command.target_system = ::mavId;
+            command.target_component = MAV_COMP_ID_AUTOPILOT1;
+            command.command = MAV_CMD_REQUEST_AUTOPILOT_CAPABILITIES;
+            command.param1 = 1;
+
+            mavlink_message_t message;
+            mavlink_msg_command_long_encode_chan(::gcsSysId, ::gcsCompId,
+                                                 communicator->linkChannel(groundLink),
+                                                 &message, &command);
+            communicator->sendMessage(message, groundLink);
+        }
+
+        // Messages of the ground station since the last call
+        QList<mavlink_message_t> takeSent()
+        {
+            return ::takeMessages(groundLink->sent, ::sentChannel);
+        }
+
+        QList<mavlink_message_t> takeReceived()
+        {
+            return ::takeMessages(groundLink->received, ::receivedChannel);
+        }
+    };
+}
+
+void MissionHandlerTest::testIntRoundTrip()
+{
+    Bench bench;
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+    QCOMPARE(bench.simulated()->missionCount(), ::itemCount);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_ITEM_INT) >= ::itemCount);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_ITEM), 0);
+
+    // Downloaded coordinates replace the local ones, the last digit is kept
+    for (int seq = 0; seq < ::itemCount; ++seq) bench.item(seq)->setLatitude(0);
+
+    emit bench.missionService->download(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    for (int seq = 0; seq < ::itemCount; ++seq)
+    {
+        QCOMPARE(qRound(bench.item(seq)->latitude() * 1e7), ::latitude + seq);
+        QCOMPARE(qRound(bench.item(seq)->longitude() * 1e7), ::longitude - seq);
+    }
+
+    sent = bench.takeSent();
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST_INT) >= ::itemCount);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST), 0);
+}
+
+void MissionHandlerTest::testUnsupportedFallback()
+{
+    Bench bench;
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    // MISSION_REQUEST_INT of the whole window is rejected, requests go again as float
+    bench.simulated()->setMissionInt(sim::SimulatedVehicle::MissionInt::Rejected);
+    bench.takeSent();
+
+    emit bench.missionService->download(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST_INT) > 0);
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST) >= ::itemCount);
+    QVERIFY(qAbs(bench.item(1)->latitude() - (::latitude + 1) / 1e7) < 1e-5);
+
+    // Vehicle requests upload items as float, they are sent in its form
+    bench.item(1)->setLatitude(bench.item(1)->latitude() + 0.001);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    sent = bench.takeSent();
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_ITEM) > 0);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_ITEM_INT), 0);
+}
+
+void MissionHandlerTest::testCapabilityFallback()
+{
+    Bench bench;
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    // AUTOPILOT_VERSION without MISSION_INT capability switches requests to float at once
+    bench.simulated()->setMissionInt(sim::SimulatedVehicle::MissionInt::Ignored);
+    bench.requestCapabilities();
+    QTRY_VERIFY_WITH_TIMEOUT(::count(bench.takeReceived(), MAVLINK_MSG_ID_AUTOPILOT_VERSION),
+                             ::timeout);
+    bench.takeSent();
+
+    emit bench.missionService->download(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST_INT), 0);
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST) >= ::itemCount);
+}
+
+void MissionHandlerTest::testSilentFallback()
+{
+    Bench bench;
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    // Restarted ground station knows nothing of the vehicle, which doesn't answer
+    // MISSION_REQUEST_INT at all, expired requests go as float
+    bench.simulated()->setMissionInt(sim::SimulatedVehicle::MissionInt::Ignored);
+    bench.restartGroundStation();
+    QTRY_VERIFY_WITH_TIMEOUT(bench.isVehicleOnline(), ::timeout);
+
+    emit bench.missionService->download(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST_INT) > 0);
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_REQUEST) >= ::itemCount);
+}
+
+void MissionHandlerTest::testPartialUpload()
+{
+    Bench bench;
+
+    // Heartbeat of ArduPilot enables partial writes
+    QTRY_VERIFY_WITH_TIMEOUT(::count(bench.takeReceived(), MAVLINK_MSG_ID_HEARTBEAT), ::timeout);
+
+    QVERIFY(bench.onboardHashes().isEmpty());
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    // Onboard state is taken when the vehicle accepts the upload
+    QCOMPARE(bench.onboardHashes().count(), ::itemCount);
+    for (int seq = 0; seq < ::itemCount; ++seq)
+    {
+        QCOMPARE(bench.onboardHashes().at(seq), domain::MissionService::itemHash(bench.item(seq)));
+    }
+    bench.takeSent();
+
+    // Only the changed item goes with MISSION_WRITE_PARTIAL_LIST
+    bench.item(1)->setAltitude(bench.item(1)->altitude() + 50);
+
+    emit bench.missionService->upload(bench.assignment());
+    QCOMPARE(bench.item(0)->status(), dto::MissionItem::Actual);
+    QCOMPARE(bench.item(1)->status(), dto::MissionItem::NotActual);
+    QCOMPARE(bench.item(2)->status(), dto::MissionItem::Actual);
+
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_COUNT), 0);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST), 1);
+
+    const mavlink_message_t* partial = ::find(sent, MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST);
+    QCOMPARE(mavlink_msg_mission_write_partial_list_get_start_index(partial), qint16(1));
+    QCOMPARE(mavlink_msg_mission_write_partial_list_get_end_index(partial), qint16(1));
+
+    for (const mavlink_message_t& message: sent)
+    {
+        if (message.msgid != MAVLINK_MSG_ID_MISSION_ITEM_INT) continue;
+        QCOMPARE(mavlink_msg_mission_item_int_get_seq(&message), quint16(1));
+    }
+
+    QCOMPARE(bench.simulated()->missionCount(), ::itemCount);
+    QCOMPARE(bench.onboardHashes().at(1), domain::MissionService::itemHash(bench.item(1)));
+
+    // Nothing is sent, if nothing is changed
+    emit bench.missionService->upload(bench.assignment());
+    QCOMPARE(bench.assignment()->status(), dto::MissionAssignment::Actual);
+
+    QTest::qWait(100);
+    QVERIFY(bench.takeSent().isEmpty());
+}
+
+void MissionHandlerTest::testPartialRejected()
+{
+    Bench bench;
+    bench.simulated()->setPartialWrites(false);
+
+    QTRY_VERIFY_WITH_TIMEOUT(::count(bench.takeReceived(), MAVLINK_MSG_ID_HEARTBEAT), ::timeout);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+    bench.takeSent();
+
+    // Rejected partial write is followed by the full upload
+    bench.item(1)->setAltitude(bench.item(1)->altitude() + 50);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    QList<mavlink_message_t> sent = bench.takeSent();
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST), 1);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_COUNT), 1);
+    QVERIFY(::count(sent, MAVLINK_MSG_ID_MISSION_ITEM_INT) >= ::itemCount);
+
+    QCOMPARE(bench.onboardHashes().count(), ::itemCount);
+    QCOMPARE(bench.onboardHashes().at(1), domain::MissionService::itemHash(bench.item(1)));
+
+    // Partial writes are not tried again with this vehicle
+    bench.item(2)->setAltitude(bench.item(2)->altitude() + 50);
+
+    emit bench.missionService->upload(bench.assignment());
+    QTRY_COMPARE_WITH_TIMEOUT(bench.assignment()->status(), dto::MissionAssignment::Actual,
+                              ::timeout);
+
+    sent = bench.takeSent();
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_WRITE_PARTIAL_LIST), 0);
+    QCOMPARE(::count(sent, MAVLINK_MSG_ID_MISSION_COUNT), 1);
+}
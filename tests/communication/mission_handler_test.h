@@ -0,0 +1,19 @@
+#ifndef MISSION_HANDLER_TEST_H
+#define MISSION_HANDLER_TEST_H
+
+#include <QTest>
+
+class MissionHandlerTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testIntRoundTrip();
+    void testUnsupportedFallback();
+    void testCapabilityFallback();
+    void testSilentFallback();
+    void testPartialUpload();
+    void testPartialRejected();
+};
+
+#endif // MISSION_HANDLER_TEST_H
@@ -0,0 +1,85 @@
+#include "mission_transfer_test.h"
+
+// Internal
+#include "mission_transfer.h"
+
+using namespace comm;
+
+void MissionTransferTest::testSingleWindow()
+{
+    MissionTransfer transfer;
+    transfer.start(3);
+
+    QCOMPARE(transfer.takeRequests(1), QList<int>({ 0 }));
+    QVERIFY(transfer.takeRequests(2).isEmpty());
+
+    QVERIFY(transfer.markDone(0, 50));
+    QCOMPARE(transfer.takeRequests(50), QList<int>({ 1 }));
+    QVERIFY(transfer.markDone(1, 100));
+    QCOMPARE(transfer.takeRequests(100), QList<int>({ 2 }));
+    QVERIFY(transfer.markDone(2, 150));
+
+    QVERIFY(transfer.isComplete());
+    QVERIFY(transfer.rtt().hasSamples());
+}
+
+void MissionTransferTest::testPipelinedRequests()
+{
+    MissionTransfer transfer;
+    transfer.setMaxWindow(8);
+    transfer.start(10);
+
+    QCOMPARE(transfer.takeRequests(1), QList<int>({ 0, 1, 2, 3 }));
+
+    // Duplicate answer is not counted
+    QVERIFY(transfer.markDone(2, 50));
+    QVERIFY(!transfer.markDone(2, 60));
+    QCOMPARE(transfer.doneCount(), 1);
+
+    QCOMPARE(transfer.takeRequests(60), QList<int>({ 4 }));
+    QVERIFY(transfer.window() <= transfer.maxWindow());
+}
+
+void MissionTransferTest::testSelectiveRetransmission()
+{
+    MissionTransfer transfer;
+    transfer.setMaxWindow(8);
+    transfer.start(4);
+
+    QCOMPARE(transfer.takeRequests(1), QList<int>({ 0, 1, 2, 3 }));
+    QVERIFY(transfer.markDone(1, 100));
+    QVERIFY(transfer.markDone(3, 100));
+
+    // Nothing expires before the timeout, then only lost ones are requested again
+    QVERIFY(transfer.takeExpired(101).isEmpty());
+    int timeout = transfer.nextTimeout(101);
+    QVERIFY(timeout > 0);
+
+    QCOMPARE(transfer.takeExpired(101 + timeout), QList<int>({ 0, 2 }));
+    QCOMPARE(transfer.window(), 2);
+    QVERIFY(transfer.nextTimeout(101 + timeout) > timeout); // backed off
+
+    QVERIFY(transfer.markDone(0, 200 + timeout));
+    QVERIFY(transfer.markDone(2, 200 + timeout));
+    QVERIFY(transfer.isComplete());
+    QCOMPARE(transfer.nextTimeout(200 + timeout), -1);
+}
+
+void MissionTransferTest::testPartialRange()
+{
+    MissionTransfer transfer;
+    transfer.setMaxWindow(8);
+    transfer.start(10, 3, 5);
+
+    // Sequences out of the range are taken as done
+    QCOMPARE(transfer.doneCount(), 7);
+    QVERIFY(transfer.isDone(0));
+    QVERIFY(!transfer.isDone(3));
+    QVERIFY(!transfer.markDone(9, 1));
+
+    QCOMPARE(transfer.takeRequests(1), QList<int>({ 3, 4, 5 }));
+    QVERIFY(transfer.markDone(3, 50));
+    QVERIFY(transfer.markDone(4, 50));
+    QVERIFY(transfer.markDone(5, 50));
+    QVERIFY(transfer.isComplete());
+}
@@ -0,0 +1,17 @@
+#ifndef MISSION_TRANSFER_TEST_H
+#define MISSION_TRANSFER_TEST_H
+
+#include <QTest>
+
+class MissionTransferTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSingleWindow();
+    void testPipelinedRequests();
+    void testSelectiveRetransmission();
+    void testPartialRange();
+};
+
+#endif // MISSION_TRANSFER_TEST_H
@@ -0,0 +1,51 @@
+#include "pipe_link.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Internal
+#include "mavlink_frame_parser.h"
+
+using namespace comm;
+
+PipeLink::PipeLink()
+{
+    QObject::connect(this, &AbstractLink::dataReceived, [this](const QByteArray& data) {
+        received.append(data);
+    });
+}
+
+bool PipeLink::isConnected() const
+{
+    return true;
+}
+
+void PipeLink::connectLink()
+{}
+
+void PipeLink::disconnectLink()
+{}
+
+bool PipeLink::sendDataImpl(const QByteArray& data)
+{
+    sent.append(data);
+    if (peer)
+    {
+        QMetaObject::invokeMethod(peer, "receiveData", Qt::QueuedConnection,
+                                  Q_ARG(QByteArray, data));
+    }
+    return true;
+}
+
+QList<mavlink_message_t> takeMessages(QByteArray& data, quint8 channel)
+{
+    QList<mavlink_message_t> messages;
+    mavlink_message_t message;
+
+    MavLinkFrameParser parser(channel);
+    parser.setData(data.constData(), data.size());
+    while (parser.next(message)) messages.append(message);
+
+    data.clear();
+    return messages;
+}
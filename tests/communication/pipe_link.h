@@ -0,0 +1,32 @@
+#ifndef PIPE_LINK_H
+#define PIPE_LINK_H
+
+// MAVLink
+#include <mavlink_types.h>
+
+// Internal
+#include "abstract_link.h"
+
+// End of the in-process link pair, data goes to the other end through the event loop
+class PipeLink: public comm::AbstractLink
+{
+public:
+    PipeLink* peer = nullptr;
+    QByteArray sent;
+    QByteArray received;
+
+    PipeLink();
+
+    bool isConnected() const override;
+
+    void connectLink() override;
+    void disconnectLink() override;
+
+protected:
+    bool sendDataImpl(const QByteArray& data) override;
+};
+
+// Frames of the recorded data, which is cleared, channel must not be taken by a communicator
+QList<mavlink_message_t> takeMessages(QByteArray& data, quint8 channel);
+
+#endif // PIPE_LINK_H
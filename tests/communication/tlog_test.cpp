@@ -0,0 +1,178 @@
+#include "tlog_test.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Qt
+#include <QTemporaryDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QtEndian>
+#include <QDebug>
+
+// Internal
+#include "tlog_recorder.h"
+#include "tlog_reader.h"
+#include "replay_link.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint64 startTime = 1500000000000000;
+    const quint64 period = 100000; // 10 Hz
+    const int recordsCount = 600; // one minute
+
+    QString recordTlog(const QTemporaryDir& dir)
+    {
+        QString fileName = dir.filePath("test.tlog");
+
+        TlogRecorder recorder;
+        if (!recorder.start(fileName)) return QString();
+
+        mavlink_message_t message;
+        mavlink_attitude_t attitude = {};
+        quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+
+        for (int i = 0; i < ::recordsCount; ++i)
+        {
+            attitude.time_boot_ms = i;
+            mavlink_msg_attitude_encode(1, 1, &message, &attitude);
+            int size = mavlink_msg_to_send_buffer(buffer, &message);
+
+            recorder.record(::startTime + i * ::period, (const char*)buffer, size);
+        }
+
+        recorder.stop();
+        return fileName;
+    }
+
+    bool checkSeek(TlogReader& reader, int record)
+    {
+        reader.seek(::startTime + record * ::period);
+
+        quint64 time;
+        const char* frame;
+        int size;
+        if (!reader.next(&time, &frame, &size)) return false;
+
+        mavlink_message_t message;
+        mavlink_status_t status;
+        for (int i = 0; i < size; ++i)
+        {
+            if (mavlink_parse_char(MAVLINK_COMM_3, frame[i], &message, &status))
+            {
+                return time == ::startTime + record * ::period &&
+                        mavlink_msg_attitude_get_time_boot_ms(&message) == quint32(record);
+            }
+        }
+
+        return false;
+    }
+}
+
+void TlogTest::testRecordAndSeek()
+{
+    QTemporaryDir dir;
+    QString fileName = ::recordTlog(dir);
+    QVERIFY(!fileName.isEmpty());
+
+    TlogReader reader(fileName);
+    QVERIFY(reader.open());
+    QCOMPARE(reader.startTime(), ::startTime);
+    QCOMPARE(reader.endTime(), ::startTime + (::recordsCount - 1) * ::period);
+
+    QVERIFY(::checkSeek(reader, 0));
+    QVERIFY(::checkSeek(reader, 317));
+    QVERIFY(::checkSeek(reader, ::recordsCount - 1));
+
+    reader.seek(reader.endTime() + 1);
+    quint64 time;
+    const char* frame;
+    int size;
+    QVERIFY(!reader.next(&time, &frame, &size));
+}
+
+void TlogTest::testSeekWithoutIndex()
+{
+    QTemporaryDir dir;
+    QString fileName = ::recordTlog(dir);
+    QVERIFY(QFile::remove(fileName + ".idx"));
+
+    TlogReader reader(fileName);
+    QVERIFY(reader.open());
+    QCOMPARE(reader.startTime(), ::startTime);
+
+    QVERIFY(::checkSeek(reader, 42));
+    QVERIFY(::checkSeek(reader, 555));
+}
+
+void TlogTest::testClockStepBack()
+{
+    QTemporaryDir dir;
+    QString fileName = dir.filePath("step.tlog");
+
+    TlogRecorder recorder;
+    QVERIFY(recorder.start(fileName));
+
+    mavlink_message_t message;
+    mavlink_heartbeat_t heartbeat = {};
+    quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+    mavlink_msg_heartbeat_encode(1, 1, &message, &heartbeat);
+    int size = mavlink_msg_to_send_buffer(buffer, &message);
+
+    // Wall clock steps ten seconds back in the middle of the recording
+    for (int i = 0; i < 200; ++i)
+    {
+        quint64 time = ::startTime + i * ::period;
+        if (i >= 100) time -= 10000000;
+        recorder.record(time, (const char*)buffer, size);
+    }
+    recorder.stop();
+
+    QFile index(tlog::indexFileName(fileName));
+    QVERIFY(index.open(QIODevice::ReadOnly));
+    QByteArray data = index.readAll().mid(tlog::indexHeaderSize);
+    QVERIFY(data.size() >= int(sizeof(tlog::IndexEntry)) * 2);
+
+    const int entrySize = sizeof(tlog::IndexEntry);
+    quint64 previous = 0;
+    for (int i = 0; i + entrySize <= data.size(); i += entrySize)
+    {
+        quint64 time = qFromLittleEndian<quint64>(
+                           reinterpret_cast<const uchar*>(data.constData() + i));
+        QVERIFY(time >= previous);
+        previous = time;
+    }
+}
+
+void TlogTest::testReplayLink()
+{
+    QTemporaryDir dir;
+    ReplayLink link(::recordTlog(dir));
+    link.setSpeed(0);
+
+    int received = 0;
+    mavlink_message_t message;
+    mavlink_status_t status;
+    QObject::connect(&link, &AbstractLink::dataReceived, [&](const QByteArray& data) {
+        for (char c: data)
+        {
+            if (mavlink_parse_char(MAVLINK_COMM_3, c, &message, &status)) received++;
+        }
+    });
+    QSignalSpy finishedSpy(&link, &ReplayLink::finished);
+
+    link.connectLink();
+    QVERIFY(link.isConnected());
+    QCOMPARE(link.duration(), qint64((::recordsCount - 1) * ::period / 1000));
+
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(received, ::recordsCount);
+
+    // Seek to the last 10 records
+    received = 0;
+    link.seek((::recordsCount - 10) * ::period / 1000);
+    QTRY_COMPARE(finishedSpy.count(), 2);
+    QCOMPARE(received, 10);
+}
@@ -0,0 +1,17 @@
+#ifndef TLOG_TEST_H
+#define TLOG_TEST_H
+
+#include <QTest>
+
+class TlogTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRecordAndSeek();
+    void testSeekWithoutIndex();
+    void testClockStepBack();
+    void testReplayLink();
+};
+
+#endif // TLOG_TEST_H
@@ -0,0 +1,246 @@
+#include "vehicle_simulator_test.h"
+
+// MAVLink
+#include <mavlink.h>
+
+// Internal
+#include "abstract_link.h"
+#include "mavlink_frame_parser.h"
+#include "vehicle_simulator.h"
+
+using namespace comm;
+
+namespace
+{
+    const quint8 gcsSysId = 255;
+    const quint8 gcsCompId = 0;
+    const quint8 mavId = 1;
+    const int itemCount = 3;
+
+    // Ground station side channels, simulator takes the last one
+    const quint8 uplinkChannel = MAVLINK_COMM_NUM_BUFFERS - 3;
+    const quint8 downlinkChannel = MAVLINK_COMM_NUM_BUFFERS - 2;
+
+    // Loopback of the simulator link: sent data is kept, received one is injected
+    class LoopbackLink: public AbstractLink
+    {
+    public:
+        QByteArray sent;
+
+        bool isConnected() const override { return true; }
+
+        void connectLink() override {}
+        void disconnectLink() override {}
+
+        void inject(const mavlink_message_t& message)
+        {
+            quint8 buffer[MAVLINK_MAX_PACKET_LEN];
+            int lenght = mavlink_msg_to_send_buffer(buffer, &message);
+
+            this->receiveData(QByteArray((const char*)buffer, lenght));
+        }
+
+    protected:
+        bool sendDataImpl(const QByteArray& data) override
+        {
+            sent.append(data);
+            return true;
+        }
+    };
+
+    QList<mavlink_message_t> takeReplies(LoopbackLink* link, MavLinkFrameParser& parser)
+    {
+        QList<mavlink_message_t> messages;
+        mavlink_message_t message;
+
+        parser.setData(link->sent.constData(), link->sent.size());
+        while (parser.next(message)) messages.append(message);
+
+        link->sent.clear();
+        return messages;
+    }
+
+    void sendItem(LoopbackLink* link, quint16 seq, qint32 latitude)
+    {
+        mavlink_mission_item_int_t item = {};
+        item.target_system = ::mavId;
+        item.target_component = MAV_COMP_ID_AUTOPILOT1;
+        item.seq = seq;
+        item.frame = MAV_FRAME_GLOBAL_RELATIVE_ALT_INT;
+        item.command = MAV_CMD_NAV_WAYPOINT;
+        item.x = latitude;
+        item.y = 300000000;
+        item.z = 100;
+
+        mavlink_message_t message;
+        mavlink_msg_mission_item_int_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel,
+                                                 &message, &item);
+        link->inject(message);
+    }
+
+    // Expects single MISSION_REQUEST_INT of the vehicle, returns its sequence or -1
+    int requestedSeq(const QList<mavlink_message_t>& replies)
+    {
+        if (replies.count() != 1) return -1;
+
+        const mavlink_message_t& reply = replies.first();
+        if (reply.sysid != ::mavId || reply.msgid != MAVLINK_MSG_ID_MISSION_REQUEST_INT)
+        {
+            return -1;
+        }
+
+        return mavlink_msg_mission_request_int_get_seq(&reply);
+    }
+
+    // Expects single MISSION_ACK of the vehicle, returns its result or -1
+    int ackResult(const QList<mavlink_message_t>& replies)
+    {
+        if (replies.count() != 1) return -1;
+
+        const mavlink_message_t& reply = replies.first();
+        if (reply.sysid != ::mavId || reply.msgid != MAVLINK_MSG_ID_MISSION_ACK) return -1;
+
+        return mavlink_msg_mission_ack_get_type(&reply);
+    }
+
+    void uploadMission(LoopbackLink* link, MavLinkFrameParser& parser)
+    {
+        mavlink_mission_count_t count = {};
+        count.target_system = ::mavId;
+        count.target_component = MAV_COMP_ID_AUTOPILOT1;
+        count.count = ::itemCount;
+
+        mavlink_message_t message;
+        mavlink_msg_mission_count_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel,
+                                              &message, &count);
+        link->inject(message);
+
+        for (int seq = 0; seq < ::itemCount; ++seq)
+        {
+            QCOMPARE(::requestedSeq(::takeReplies(link, parser)), seq);
+            ::sendItem(link, seq, 550000000 + seq);
+        }
+
+        QCOMPARE(::ackResult(::takeReplies(link, parser)), int(MAV_MISSION_ACCEPTED));
+    }
+
+    qint32 downloadLatitude(LoopbackLink* link, MavLinkFrameParser& parser, quint16 seq)
+    {
+        mavlink_mission_request_int_t request = {};
+        request.target_system = ::mavId;
+        request.target_component = MAV_COMP_ID_AUTOPILOT1;
+        request.seq = seq;
+
+        mavlink_message_t message;
+        mavlink_msg_mission_request_int_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel,
+                                                    &message, &request);
+        link->inject(message);
+
+        QList<mavlink_message_t> replies = ::takeReplies(link, parser);
+        if (replies.count() != 1 || replies.first().msgid != MAVLINK_MSG_ID_MISSION_ITEM_INT)
+        {
+            return -1;
+        }
+
+        return mavlink_msg_mission_item_int_get_x(&replies.first());
+    }
+}
+
+void VehicleSimulatorTest::testMissionUpload()
+{
+    sim::VehicleSimulator simulator;
+    LoopbackLink* link = new LoopbackLink();
+    simulator.setLink(link);
+    simulator.setVehicleCount(1, ::mavId);
+
+    MavLinkFrameParser parser(::downlinkChannel);
+
+    ::uploadMission(link, parser);
+    QCOMPARE(simulator.vehicle(::mavId)->planCount(MAV_MISSION_TYPE_MISSION), ::itemCount);
+
+    QCOMPARE(::downloadLatitude(link, parser, 2), 550000002);
+}
+
+void VehicleSimulatorTest::testPartialUpload()
+{
+    sim::VehicleSimulator simulator;
+    LoopbackLink* link = new LoopbackLink();
+    simulator.setLink(link);
+    simulator.setVehicleCount(1, ::mavId);
+
+    MavLinkFrameParser parser(::downlinkChannel);
+
+    ::uploadMission(link, parser);
+
+    mavlink_mission_write_partial_list_t partial = {};
+    partial.target_system = ::mavId;
+    partial.target_component = MAV_COMP_ID_AUTOPILOT1;
+    partial.start_index = 1;
+    partial.end_index = 1;
+
+    mavlink_message_t message;
+    mavlink_msg_mission_write_partial_list_encode_chan(::gcsSysId, ::gcsCompId,
+                                                       ::uplinkChannel, &message, &partial);
+    link->inject(message);
+
+    QCOMPARE(::requestedSeq(::takeReplies(link, parser)), 1);
+    ::sendItem(link, 1, 560000000);
+    QCOMPARE(::ackResult(::takeReplies(link, parser)), int(MAV_MISSION_ACCEPTED));
+
+    QCOMPARE(simulator.vehicle(::mavId)->planCount(MAV_MISSION_TYPE_MISSION), ::itemCount);
+    QCOMPARE(::downloadLatitude(link, parser, 0), 550000000);
+    QCOMPARE(::downloadLatitude(link, parser, 1), 560000000);
+    QCOMPARE(::downloadLatitude(link, parser, 2), 550000002);
+}
+
+void VehicleSimulatorTest::testRouting()
+{
+    sim::VehicleSimulator simulator;
+    LoopbackLink* link = new LoopbackLink();
+    simulator.setLink(link);
+    simulator.setVehicleCount(2, ::mavId);
+
+    MavLinkFrameParser parser(::downlinkChannel);
+    mavlink_message_t message;
+
+    // Message without target goes to every vehicle
+    mavlink_timesync_t timesync = {};
+    timesync.ts1 = 12345;
+    mavlink_msg_timesync_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel,
+                                     &message, &timesync);
+    link->inject(message);
+
+    QList<mavlink_message_t> replies = ::takeReplies(link, parser);
+    QCOMPARE(replies.count(), 2);
+    for (const mavlink_message_t& reply: replies)
+    {
+        QCOMPARE(quint32(reply.msgid), quint32(MAVLINK_MSG_ID_TIMESYNC));
+        QCOMPARE(mavlink_msg_timesync_get_ts1(&reply), qint64(12345));
+    }
+
+    // Targeted message goes to its vehicle only
+    mavlink_rc_channels_override_t rcOverride = {};
+    rcOverride.target_system = ::mavId + 1;
+    mavlink_msg_rc_channels_override_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel,
+                                                 &message, &rcOverride);
+    link->inject(message);
+
+    mavlink_manual_control_t manual = {};
+    manual.target = ::mavId;
+    mavlink_msg_manual_control_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel,
+                                           &message, &manual);
+    link->inject(message);
+
+    QCOMPARE(simulator.vehicle(::mavId)->manualSamples(), quint64(1));
+    QCOMPARE(simulator.vehicle(::mavId + 1)->manualSamples(), quint64(1));
+
+    mavlink_ping_t ping = {};
+    ping.seq = 7;
+    mavlink_msg_ping_encode_chan(::gcsSysId, ::gcsCompId, ::uplinkChannel, &message, &ping);
+    link->inject(message);
+
+    replies = ::takeReplies(link, parser);
+    QCOMPARE(replies.count(), 2);
+    QCOMPARE(mavlink_msg_ping_get_target_system(&replies.first()), ::gcsSysId);
+    QCOMPARE(mavlink_msg_ping_get_seq(&replies.first()), quint32(7));
+}
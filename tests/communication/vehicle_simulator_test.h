@@ -0,0 +1,16 @@
+#ifndef VEHICLE_SIMULATOR_TEST_H
+#define VEHICLE_SIMULATOR_TEST_H
+
+#include <QTest>
+
+class VehicleSimulatorTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMissionUpload();
+    void testPartialUpload();
+    void testRouting();
+};
+
+#endif // VEHICLE_SIMULATOR_TEST_H
@@ -0,0 +1,129 @@
+#include "abstract_command_handler_test.h"
+
+// Internal
+#include "abstract_command_handler.h"
+
+using namespace domain;
+
+namespace
+{
+    // Handler without a link, keeps attempts of the sent commands
+    class TestCommandHandler: public AbstractCommandHandler
+    {
+    public:
+        using AbstractCommandHandler::ackCommand;
+        using AbstractCommandHandler::sampleRoundTrip;
+        using AbstractCommandHandler::addRoundTrip;
+
+        QList<int> attempts;
+
+    protected:
+        void sendCommand(int vehicleId, const dto::CommandPtr& command, int attempt) override
+        {
+            Q_UNUSED(vehicleId)
+            Q_UNUSED(command)
+
+            attempts.append(attempt);
+        }
+    };
+
+    dto::CommandPtr makeCommand(dto::Command::CommandType type)
+    {
+        dto::CommandPtr command = dto::CommandPtr::create();
+        command->setType(type);
+        return command;
+    }
+}
+
+void AbstractCommandHandlerTest::testRetryBackOff()
+{
+    TestCommandHandler handler;
+    dto::CommandPtr command = ::makeCommand(dto::Command::ArmDisarm);
+
+    // Timeout is not shorter than the floor, even on a fast link
+    handler.addRoundTrip(1, 1);
+    QCOMPARE(handler.retryTimeout(1), 500);
+
+    handler.executeCommand(1, command);
+    QCOMPARE(handler.attempts, QList<int>({ 0 }));
+
+    // Retry doubles the timeout of the next one
+    QTRY_COMPARE_WITH_TIMEOUT(handler.attempts, QList<int>({ 0, 1 }), 1000);
+    QCOMPARE(handler.retryTimeout(1), 1000);
+    QCOMPARE(command->status(), dto::Command::Sending);
+
+    QTest::qWait(700);
+    QCOMPARE(handler.attempts, QList<int>({ 0, 1 }));
+
+    QTRY_COMPARE_WITH_TIMEOUT(handler.attempts, QList<int>({ 0, 1, 2 }), 1000);
+    QCOMPARE(handler.retryTimeout(1), 2000);
+
+    handler.ackCommand(1, dto::Command::ArmDisarm, dto::Command::Completed);
+    QCOMPARE(command->status(), dto::Command::Completed);
+}
+
+void AbstractCommandHandlerTest::testCancel()
+{
+    TestCommandHandler handler;
+    dto::CommandPtr first = ::makeCommand(dto::Command::SetMode);
+    dto::CommandPtr second = ::makeCommand(dto::Command::SetMode);
+
+    // Command of the same type cancels the previous one
+    handler.executeCommand(1, first);
+    handler.executeCommand(1, second);
+    QCOMPARE(first->status(), dto::Command::Canceled);
+    QCOMPARE(second->status(), dto::Command::Sending);
+
+    handler.cancelCommand(1, dto::Command::SetMode);
+    QCOMPARE(second->status(), dto::Command::Canceled);
+
+    // Canceled commands are not retried
+    QTest::qWait(700);
+    QCOMPARE(handler.attempts, QList<int>({ 0, 0 }));
+}
+
+void AbstractCommandHandlerTest::testRoundTripSampling()
+{
+    TestCommandHandler handler;
+
+    // Answer of the first sending is a sample: 400 ms, 200 ms variation, then ~0 ms
+    handler.addRoundTrip(1, 400);
+    QCOMPARE(handler.retryTimeout(1), 1200);
+
+    handler.executeCommand(1, ::makeCommand(dto::Command::Land));
+    handler.sampleRoundTrip(1, dto::Command::Land);
+    QVERIFY(handler.retryTimeout(1) > 1200);
+    handler.ackCommand(1, dto::Command::Land, dto::Command::Completed);
+
+    // Answer of the retried command is ambiguous, backed off timeout stays (Karn)
+    dto::CommandPtr command = ::makeCommand(dto::Command::Land);
+    handler.executeCommand(2, command);
+    QTRY_COMPARE_WITH_TIMEOUT(handler.attempts.count(), 2, 1000);
+    QCOMPARE(handler.retryTimeout(2), 1000);
+
+    handler.sampleRoundTrip(2, dto::Command::Land);
+    handler.ackCommand(2, dto::Command::Land, dto::Command::InProgress);
+    QCOMPARE(handler.retryTimeout(2), 1000);
+    QCOMPARE(command->status(), dto::Command::InProgress);
+
+    handler.cancelCommand(2, dto::Command::Land);
+}
+
+void AbstractCommandHandlerTest::testRejection()
+{
+    TestCommandHandler handler;
+    dto::CommandPtr command = ::makeCommand(dto::Command::CalibrateAirspeed);
+
+    // Vehicle rejects the command
+    handler.executeCommand(1, command);
+    handler.ackCommand(1, dto::Command::CalibrateAirspeed, dto::Command::Rejected);
+    QCOMPARE(command->status(), dto::Command::Rejected);
+
+    // Silent vehicle: 500, 1000, 2000, 3000 and 3000 ms between the attempts
+    command = ::makeCommand(dto::Command::CalibrateAirspeed);
+    handler.attempts.clear();
+    handler.executeCommand(1, command);
+
+    QTRY_COMPARE_WITH_TIMEOUT(command->status(), dto::Command::Rejected, 12000);
+    QCOMPARE(handler.attempts, QList<int>({ 0, 1, 2, 3, 4, 5 }));
+}
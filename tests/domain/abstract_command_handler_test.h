@@ -0,0 +1,17 @@
+#ifndef ABSTRACT_COMMAND_HANDLER_TEST_H
+#define ABSTRACT_COMMAND_HANDLER_TEST_H
+
+#include <QTest>
+
+class AbstractCommandHandlerTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRetryBackOff();
+    void testCancel();
+    void testRoundTripSampling();
+    void testRejection();
+};
+
+#endif // ABSTRACT_COMMAND_HANDLER_TEST_H
@@ -0,0 +1,56 @@
+#include "manual_control_channel_test.h"
+
+// Qt
+#include <QSignalSpy>
+
+// Internal
+#include "manual_control_channel.h"
+
+using namespace domain;
+
+namespace
+{
+    ManualControlChannel::Sample makeSample(float pitch)
+    {
+        ManualControlChannel::Sample sample;
+        sample.vehicleId = 1;
+        sample.pitch = pitch;
+        return sample;
+    }
+}
+
+void ManualControlChannelTest::testLatestSampleWins()
+{
+    ManualControlChannel channel;
+    ManualControlChannel::Sample sample;
+
+    QVERIFY(!channel.take(&sample));
+
+    channel.post(::makeSample(0.1f));
+    channel.post(::makeSample(0.2f));
+    channel.post(::makeSample(0.3f));
+
+    // Overwritten samples are dropped, not queued
+    QVERIFY(channel.take(&sample));
+    QCOMPARE(sample.pitch, 0.3f);
+    QVERIFY(!channel.take(&sample));
+}
+
+void ManualControlChannelTest::testSinglePosted()
+{
+    ManualControlChannel channel;
+    ManualControlChannel::Sample sample;
+    QSignalSpy spy(&channel, &ManualControlChannel::posted);
+
+    channel.post(::makeSample(0.1f));
+    channel.post(::makeSample(0.2f));
+    QCOMPARE(spy.count(), 1);
+
+    // Taken sample makes the next one notify again
+    QVERIFY(channel.take(&sample));
+    channel.post(::makeSample(0.3f));
+    QCOMPARE(spy.count(), 2);
+
+    channel.post(::makeSample(0.4f));
+    QCOMPARE(spy.count(), 2);
+}
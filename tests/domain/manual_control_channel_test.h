@@ -0,0 +1,15 @@
+#ifndef MANUAL_CONTROL_CHANNEL_TEST_H
+#define MANUAL_CONTROL_CHANNEL_TEST_H
+
+#include <QTest>
+
+class ManualControlChannelTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testLatestSampleWins();
+    void testSinglePosted();
+};
+
+#endif // MANUAL_CONTROL_CHANNEL_TEST_H
@@ -0,0 +1,188 @@
+#include "telemetry_history_test.h"
+
+// Qt
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <QtMath>
+#include <QtNumeric>
+#include <QDebug>
+
+// Internal
+#include "telemetry.h"
+#include "telemetry_schema.h"
+#include "telemetry_history.h"
+#include "time_series_codec.h"
+
+// Std
+#include <cstring>
+#include <limits>
+
+using namespace domain;
+
+namespace
+{
+    const qint64 startTime = 1500000000000;
+    const qint64 period = 20; // 50 Hz
+    const int samplesCount = 3000; // one minute, several blocks
+
+    const telemetry_schema::Leaf& pitchLeaf()
+    {
+        return telemetry_schema::slotLeaf(telemetry_schema::Ahrs_Pitch);
+    }
+
+    double pitch(int sample)
+    {
+        return qSin(sample * 0.01) * 15;
+    }
+
+    bool open(TelemetryHistory& history, const QString& path)
+    {
+        history.setRecorded(telemetry_schema::Ahrs_Pitch, true);
+        return history.open(path);
+    }
+
+    void fill(TelemetryHistory& history, int vehicleId)
+    {
+        for (int i = 0; i < ::samplesCount; ++i)
+        {
+            history.append(vehicleId, ::pitchLeaf(), ::pitch(i), ::startTime + i * ::period);
+        }
+    }
+
+    bool checkSamples(const QVector<TelemetryHistory::Sample>& samples, int first, int count)
+    {
+        if (samples.count() != count) return false;
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (samples[i].time != ::startTime + (first + i) * ::period ||
+                samples[i].value != ::pitch(first + i)) return false;
+        }
+
+        return true;
+    }
+}
+
+void TelemetryHistoryTest::testCodecRoundTrip()
+{
+    const qint64 times[] = { 1000, 1020, 1040, 1041, 1300, 5000, 5000, 100000, 100020 };
+    const double values[] = { 0.0, 1.5, 1.5, -1.5, 1e300, 3.14159, qQNaN(), 0.1, -0.0 };
+    const int count = sizeof(times) / sizeof(qint64);
+
+    TimeSeriesEncoder encoder;
+    for (int i = 0; i < count; ++i) encoder.append(times[i], values[i]);
+    QCOMPARE(encoder.count(), count);
+
+    QByteArray timeColumn = encoder.times();
+    QByteArray valueColumn = encoder.values();
+    TimeSeriesDecoder decoder(reinterpret_cast<const uchar*>(timeColumn.constData()),
+                              timeColumn.size(),
+                              reinterpret_cast<const uchar*>(valueColumn.constData()),
+                              valueColumn.size(), encoder.count(), encoder.firstTime());
+
+    qint64 time;
+    double value;
+    for (int i = 0; i < count; ++i)
+    {
+        QVERIFY(decoder.next(&time, &value));
+        QCOMPARE(time, times[i]);
+        QCOMPARE(std::memcmp(&value, &values[i], sizeof(double)), 0);
+    }
+    QVERIFY(!decoder.next(&time, &value));
+}
+
+void TelemetryHistoryTest::testQueryWindow()
+{
+    QTemporaryDir dir;
+    TelemetryHistory history;
+    QVERIFY(::open(history, dir.path()));
+
+    ::fill(history, 1);
+
+    // Window covers written blocks and the open one
+    QVERIFY(::checkSamples(history.query(1, Telemetry::Ahrs, Telemetry::Pitch, ::startTime,
+                                         ::startTime + ::samplesCount * ::period),
+                           0, ::samplesCount));
+    QVERIFY(::checkSamples(history.query(1, Telemetry::Ahrs, Telemetry::Pitch,
+                                         ::startTime + 1000 * ::period,
+                                         ::startTime + 2999 * ::period), 1000, 2000));
+
+    QVERIFY(history.query(2, Telemetry::Ahrs, Telemetry::Pitch, ::startTime,
+                          ::startTime + ::samplesCount * ::period).isEmpty());
+    QVERIFY(history.query(1, Telemetry::Ahrs, Telemetry::Roll, ::startTime,
+                          ::startTime + ::samplesCount * ::period).isEmpty());
+    QVERIFY(history.query(1, Telemetry::Ahrs, Telemetry::Pitch, 0, ::startTime - 1).isEmpty());
+}
+
+void TelemetryHistoryTest::testReopen()
+{
+    QTemporaryDir dir;
+    {
+        TelemetryHistory history;
+        QVERIFY(::open(history, dir.path()));
+        ::fill(history, 1);
+    }
+
+    TelemetryHistory history;
+    QVERIFY(::open(history, dir.path()));
+    QVERIFY(::checkSamples(history.query(1, Telemetry::Ahrs, Telemetry::Pitch, 0,
+                                         ::startTime + ::samplesCount * ::period),
+                           0, ::samplesCount));
+}
+
+void TelemetryHistoryTest::testNodeRecording()
+{
+    QTemporaryDir dir;
+    TelemetryHistory history;
+    QVERIFY(!history.isRecorded(telemetry_schema::Ahrs_Pitch));
+
+    history.setRecorded(telemetry_schema::Ahrs_Pitch, true);
+    history.setRecorded(telemetry_schema::System_Armed, true);
+    history.setRecorded(telemetry_schema::System_Mode, true);
+    QVERIFY(!history.isRecorded(telemetry_schema::System_Mode));
+    QVERIFY(history.open(dir.path()));
+
+    Telemetry root(Telemetry::Root);
+    root.setHistory(&history, 7);
+
+    root.childNode(Telemetry::Ahrs)->setParameter(Telemetry::Pitch, 5.5);
+    root.childNode(Telemetry::Ahrs)->setParameter(Telemetry::Pitch, 5.5);
+    root.childNode(Telemetry::Ahrs)->setParameter(Telemetry::Roll, 1.5);
+    root.childNode(Telemetry::System)->setParameter(Telemetry::Armed, true);
+    root.childNode(Telemetry::System)->setParameter(Telemetry::Mode, QString("mode"));
+
+    QVector<TelemetryHistory::Sample> samples = history.query(7, Telemetry::Ahrs,
+                                                              Telemetry::Pitch, 0,
+                                                              std::numeric_limits<qint64>::max());
+    QCOMPARE(samples.count(), 2);
+    QCOMPARE(samples.last().value, 5.5);
+
+    samples = history.query(7, Telemetry::System, Telemetry::Armed, 0,
+                            std::numeric_limits<qint64>::max());
+    QCOMPARE(samples.count(), 1);
+    QCOMPARE(samples.first().value, 1.0);
+
+    QVERIFY(history.query(7, Telemetry::Ahrs, Telemetry::Roll, 0,
+                          std::numeric_limits<qint64>::max()).isEmpty());
+}
+
+void TelemetryHistoryTest::testRetention()
+{
+    QTemporaryDir dir;
+    const QStringList sessions = { "2017-01-01_00-00-00.tsd", "2017-01-02_00-00-00.tsd",
+                                   "2017-01-03_00-00-00.tsd" };
+    for (const QString& name: sessions)
+    {
+        QFile file(QDir(dir.path()).filePath(name));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    TelemetryHistory history;
+    history.setMaxSessions(2);
+    QVERIFY(::open(history, dir.path()));
+
+    QStringList names = QDir(dir.path()).entryList({ "*.tsd" }, QDir::Files, QDir::Name);
+    QCOMPARE(names.count(), 2);
+    QCOMPARE(names.first(), sessions.last());
+}
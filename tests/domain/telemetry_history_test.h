@@ -0,0 +1,18 @@
+#ifndef TELEMETRY_HISTORY_TEST_H
+#define TELEMETRY_HISTORY_TEST_H
+
+#include <QTest>
+
+class TelemetryHistoryTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testCodecRoundTrip();
+    void testQueryWindow();
+    void testReopen();
+    void testNodeRecording();
+    void testRetention();
+};
+
+#endif // TELEMETRY_HISTORY_TEST_H
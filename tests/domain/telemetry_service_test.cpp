@@ -6,6 +6,8 @@
 
 // Internal
 #include "telemetry.h"
+#include "telemetry_notifier.h"
+#include "telemetry_subscription.h"
 
 using namespace domain;
 
@@ -37,3 +39,111 @@ void TelemetryServiceTest::testTelemetryTree()
     QCOMPARE(root.takeChangedParameters().count(), 0);
     QCOMPARE(spy.count(), 1);
 }
+
+void TelemetryServiceTest::testTelemetryStore()
+{
+    Telemetry root(Telemetry::Root);
+    Telemetry* ahrs = root.childNode(Telemetry::Ahrs);
+    Telemetry* barometric = root.childNode(Telemetry::Barometric);
+
+    ahrs->setParameter(Telemetry::Pitch, 1.5f);
+    ahrs->setParameter(Telemetry::Enabled, true);
+    barometric->setParameter(Telemetry::AbsPressure, 1013);
+
+    QCOMPARE(ahrs->realParameter(Telemetry::Pitch), 1.5);
+    QCOMPARE(ahrs->parameter(Telemetry::Pitch).userType(), int(QMetaType::Float));
+    QVERIFY(ahrs->boolParameter(Telemetry::Enabled));
+    QVERIFY(!ahrs->hasParameter(Telemetry::Roll));
+    QCOMPARE(barometric->parameter(Telemetry::AbsPressure), QVariant(1013));
+    QCOMPARE(ahrs->takeChangedParameters().count(), 2);
+
+    // Same number of another type is not a change
+    ahrs->setParameter(Telemetry::Pitch, 1.5);
+    QCOMPARE(ahrs->takeChangedParameters().count(), 0);
+
+    // Values out of the leaf type and off-schema leaves are kept as is
+    ahrs->setParameter(Telemetry::Enabled, QString("yes"));
+    ahrs->setParameter(Telemetry::Fix, 3);
+    QCOMPARE(ahrs->parameter(Telemetry::Enabled), QVariant(QString("yes")));
+    QCOMPARE(ahrs->parameters().count(), 3);
+    QCOMPARE(ahrs->takeChangedParameters().count(), 2);
+
+    QVERIFY(!root.findChildNode(Telemetry::Wind));
+    QCOMPARE(root.findChildNode({ Telemetry::Ahrs }), ahrs);
+}
+
+void TelemetryServiceTest::testNotifierCoalescing()
+{
+    qRegisterMetaType<Telemetry::TelemetryMap>("TelemetryMap");
+
+    TelemetryNotifier notifier(50);
+    Telemetry root(Telemetry::Root);
+    root.setNotifier(&notifier);
+
+    Telemetry* ahrs = root.childNode(Telemetry::Ahrs);
+    QSignalSpy spy(ahrs, &Telemetry::parametersChanged);
+
+    // First change after a pause is published without waiting the interval
+    ahrs->setParameter(Telemetry::Pitch, 0);
+    root.notify();
+    QTRY_COMPARE(spy.count(), 1);
+
+    for (int i = 1; i < 10; ++i)
+    {
+        ahrs->setParameter(Telemetry::Pitch, i);
+        if (i == 5) ahrs->setParameter(Telemetry::Roll, i);
+        root.notify();
+    }
+
+    QCOMPARE(spy.count(), 1);
+    QTRY_COMPARE(spy.count(), 2);
+    QCOMPARE(notifier.flushes(), quint64(2));
+
+    Telemetry::TelemetryMap diff = spy.last().first().value<Telemetry::TelemetryMap>();
+    QCOMPARE(diff.count(), 2);
+    QCOMPARE(diff.value(Telemetry::Pitch), QVariant(9));
+}
+
+void TelemetryServiceTest::testSubscriptionFilters()
+{
+    qRegisterMetaType<Telemetry::TelemetryMap>("TelemetryMap");
+
+    Telemetry root(Telemetry::Root);
+    Telemetry* compass = root.childNode(Telemetry::Compass);
+    compass->setParameter(Telemetry::Heading, 10.0);
+    compass->notify();
+
+    TelemetrySubscription subscription(compass, { Telemetry::Heading });
+    subscription.setDeadband(Telemetry::Heading, 0.5);
+    QSignalSpy spy(&subscription, &TelemetrySubscription::parametersChanged);
+
+    QCOMPARE(subscription.parameters().value(Telemetry::Heading), QVariant(10.0));
+
+    // Not subscribed leaf and change inside the deadband are skipped
+    compass->setParameter(Telemetry::Enabled, true);
+    compass->setParameter(Telemetry::Heading, 10.3);
+    compass->notify();
+    QCOMPARE(spy.count(), 0);
+
+    compass->setParameter(Telemetry::Heading, 10.6);
+    compass->notify();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(subscription.parameters().value(Telemetry::Heading), QVariant(10.6));
+
+    subscription.setActive(false);
+    compass->setParameter(Telemetry::Heading, 20.0);
+    compass->notify();
+    QCOMPARE(spy.count(), 1);
+
+    // Pending value is replaced even by the one inside the deadband of the delivered value
+    subscription.setActive(true);
+    subscription.setMaxRate(10);
+    compass->setParameter(Telemetry::Heading, 21.0);
+    compass->notify();
+    compass->setParameter(Telemetry::Heading, 20.2);
+    compass->notify();
+    QCOMPARE(spy.count(), 1);
+
+    QTRY_COMPARE(spy.count(), 2);
+    QCOMPARE(subscription.parameters().value(Telemetry::Heading), QVariant(20.2));
+}
@@ -9,6 +9,9 @@ class TelemetryServiceTest: public QObject
 
 private slots:
     void testTelemetryTree();
+    void testTelemetryStore();
+    void testNotifierCoalescing();
+    void testSubscriptionFilters();
 };
 
 #endif // TELEMETRY_TEST_H
@@ -8,7 +8,20 @@
 // Tests
 #include "communication_service_test.h"
 #include "telemetry_service_test.h"
+#include "telemetry_history_test.h"
 #include "mission_service_test.h"
+#include "mavlink_frame_parser_test.h"
+#include "link_receive_test.h"
+#include "mavlink_message_queue_test.h"
+#include "tlog_test.h"
+#include "mission_transfer_test.h"
+#include "mission_handler_test.h"
+#include "command_handler_test.h"
+#include "latency_histogram_test.h"
+#include "timing_wheel_test.h"
+#include "vehicle_simulator_test.h"
+#include "abstract_command_handler_test.h"
+#include "manual_control_channel_test.h"
 
 int main(int argc, char* argv[])
 {
@@ -27,8 +40,47 @@ int main(int argc, char* argv[])
     TelemetryServiceTest telemetryTest;
     QTest::qExec(&telemetryTest);
 
+    TelemetryHistoryTest historyTest;
+    QTest::qExec(&historyTest);
+
     MissionServiceTest missionTest;
     QTest::qExec(&missionTest);
 
+    MavLinkFrameParserTest frameParserTest;
+    QTest::qExec(&frameParserTest);
+
+    LinkReceiveTest linkReceiveTest;
+    QTest::qExec(&linkReceiveTest);
+
+    MavLinkMessageQueueTest messageQueueTest;
+    QTest::qExec(&messageQueueTest);
+
+    TlogTest tlogTest;
+    QTest::qExec(&tlogTest);
+
+    MissionTransferTest missionTransferTest;
+    QTest::qExec(&missionTransferTest);
+
+    MissionHandlerTest missionHandlerTest;
+    QTest::qExec(&missionHandlerTest);
+
+    CommandHandlerTest commandTest;
+    QTest::qExec(&commandTest);
+
+    LatencyHistogramTest latencyTest;
+    QTest::qExec(&latencyTest);
+
+    TimingWheelTest timingWheelTest;
+    QTest::qExec(&timingWheelTest);
+
+    VehicleSimulatorTest vehicleSimulatorTest;
+    QTest::qExec(&vehicleSimulatorTest);
+
+    AbstractCommandHandlerTest commandHandlerTest;
+    QTest::qExec(&commandHandlerTest);
+
+    ManualControlChannelTest manualChannelTest;
+    QTest::qExec(&manualChannelTest);
+
     return 0;
 }
@@ -0,0 +1,65 @@
+#include "allocation_counter.h"
+
+// Std
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local quint64 allocations = 0;
+
+    void* allocate(std::size_t size)
+    {
+        ++::allocations;
+
+        if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+        throw std::bad_alloc();
+    }
+}
+
+quint64 allocation_counter::count()
+{
+    return ::allocations;
+}
+
+void* operator new(std::size_t size)
+{
+    return ::allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++::allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    ++::allocations;
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
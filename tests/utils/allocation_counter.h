@@ -0,0 +1,13 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+// Qt
+#include <QtGlobal>
+
+// Counts global operator new calls made by the current thread
+namespace allocation_counter
+{
+    quint64 count();
+}
+
+#endif // ALLOCATION_COUNTER_H
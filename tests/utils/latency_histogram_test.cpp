@@ -0,0 +1,142 @@
+#include "latency_histogram_test.h"
+
+// Qt
+#include <QThread>
+#include <QRegExp>
+
+// Internal
+#include "latency_histogram.h"
+#include "latency_monitor.h"
+
+#include "telemetry.h"
+#include "telemetry_portion.h"
+
+using namespace utils;
+
+namespace
+{
+    class Producer: public QThread
+    {
+    public:
+        Producer(LatencyHistogram* histogram, int offset, int count):
+            m_histogram(histogram),
+            m_offset(offset),
+            m_count(count)
+        {}
+
+    protected:
+        void run() override
+        {
+            for (int value = 0; value < m_count; ++value)
+            {
+                m_histogram->record(value % 1000 + m_offset);
+            }
+        }
+
+    private:
+        LatencyHistogram* const m_histogram;
+        const int m_offset;
+        const int m_count;
+    };
+}
+
+void LatencyHistogramTest::testBuckets()
+{
+    for (qint64 value: { 0LL, 1LL, 63LL, 64LL, 65LL, 100LL, 1000LL, 12345LL, 1000000LL,
+                         86400000000LL })
+    {
+        int index = LatencyHistogram::bucketIndex(value);
+
+        QVERIFY(index < LatencyHistogram::bucketCount);
+        QVERIFY(LatencyHistogram::bucketLowest(index) <= value);
+        QVERIFY(LatencyHistogram::bucketHighest(index) >= value);
+
+        // Bucket width stays within the precision, small values are exact
+        qint64 width = LatencyHistogram::bucketHighest(index) -
+                       LatencyHistogram::bucketLowest(index) + 1;
+        if (value < 64) QCOMPARE(width, qint64(1));
+        else QVERIFY(width * LatencyHistogram::subBucketCount <= value);
+    }
+}
+
+void LatencyHistogramTest::testPercentiles()
+{
+    LatencyHistogram histogram;
+
+    for (qint64 value = 1; value <= 10000; ++value) histogram.record(value);
+
+    QCOMPARE(histogram.count(), quint64(10000));
+    QCOMPARE(histogram.min(), qint64(1));
+    QCOMPARE(histogram.max(), qint64(10000));
+    QCOMPARE(histogram.mean(), 5000.5);
+
+    QVERIFY(qAbs(histogram.percentile(50) - 5000) <= 5000 / 32);
+    QVERIFY(qAbs(histogram.percentile(99) - 9900) <= 9900 / 32);
+    QCOMPARE(histogram.percentile(100), qint64(10000));
+
+    histogram.reset();
+    QCOMPARE(histogram.count(), quint64(0));
+    QCOMPARE(histogram.percentile(50), qint64(0));
+}
+
+void LatencyHistogramTest::testConcurrentRecording()
+{
+    const int threads = 4;
+    const int values = 100000;
+
+    LatencyHistogram histogram;
+    QList<QThread*> producers;
+
+    for (int i = 0; i < threads; ++i) producers.append(new Producer(&histogram, i, values));
+
+    for (QThread* producer: producers) producer->start();
+    for (QThread* producer: producers) producer->wait();
+    qDeleteAll(producers);
+
+    QCOMPARE(histogram.count(), quint64(threads * values));
+    QCOMPARE(histogram.min(), qint64(0));
+    QCOMPARE(histogram.max(), qint64(999 + threads - 1));
+}
+
+void LatencyHistogramTest::testStageTrace()
+{
+    LatencyMonitor::reset();
+    LatencyMonitor::setEnabled(true);
+
+    domain::Telemetry root(domain::Telemetry::Root);
+
+    {
+        LatencyScope scope(LatencyMonitor::now());
+        domain::TelemetryPortion portion(&root);
+        portion.setParameter({ domain::Telemetry::Ahrs, domain::Telemetry::Pitch }, 5);
+    }
+
+    QCOMPARE(LatencyMonitor::histogram(LatencyMonitor::PortionDelivery).count(), quint64(1));
+    QCOMPARE(LatencyMonitor::histogram(LatencyMonitor::TelemetryNotify).count(), quint64(1));
+    QCOMPARE(LatencyMonitor::origin(), qint64(0));
+
+    // Without origin nothing is recorded
+    {
+        domain::TelemetryPortion portion(&root);
+        portion.setParameter({ domain::Telemetry::Ahrs, domain::Telemetry::Pitch }, 6);
+    }
+
+    QCOMPARE(LatencyMonitor::histogram(LatencyMonitor::PortionDelivery).count(), quint64(1));
+
+    // Header and a row with the count of every stage
+    QStringList lines = LatencyMonitor::report().split('\n');
+    QCOMPARE(lines.count(), LatencyMonitor::StageCount + 1);
+
+    QStringList delivery = lines.at(LatencyMonitor::PortionDelivery + 1).split(
+                               QRegExp("\\s{2,}"), QString::SkipEmptyParts);
+    QCOMPARE(delivery.first(), LatencyMonitor::stageName(LatencyMonitor::PortionDelivery));
+    QCOMPARE(delivery.at(1), QString("1"));
+
+    QStringList parse = lines.at(LatencyMonitor::Parse + 1).split(
+                            QRegExp("\\s{2,}"), QString::SkipEmptyParts);
+    QCOMPARE(parse.first(), LatencyMonitor::stageName(LatencyMonitor::Parse));
+    QCOMPARE(parse.at(1), QString("0"));
+
+    LatencyMonitor::setEnabled(false);
+    LatencyMonitor::reset();
+}
@@ -0,0 +1,17 @@
+#ifndef LATENCY_HISTOGRAM_TEST_H
+#define LATENCY_HISTOGRAM_TEST_H
+
+#include <QTest>
+
+class LatencyHistogramTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testBuckets();
+    void testPercentiles();
+    void testConcurrentRecording();
+    void testStageTrace();
+};
+
+#endif // LATENCY_HISTOGRAM_TEST_H
@@ -0,0 +1,53 @@
+#include "timing_wheel_test.h"
+
+// Internal
+#include "timing_wheel.h"
+
+using namespace utils;
+
+void TimingWheelTest::testExpiration()
+{
+    TimingWheel wheel(10, 16);
+    wheel.schedule(1, 25);
+    wheel.schedule(2, 40);
+
+    // Nothing fires before the deadline, then not later than one tick after it
+    QVERIFY(wheel.advance(24).isEmpty());
+    QCOMPARE(wheel.advance(35), QList<quint64>({ 1 }));
+    QVERIFY(wheel.advance(45).isEmpty());
+    QCOMPARE(wheel.advance(50), QList<quint64>({ 2 }));
+    QVERIFY(wheel.isEmpty());
+
+    // Deadline in the processed tick fires with the next one
+    wheel.schedule(3, 45);
+    QCOMPARE(wheel.advance(60), QList<quint64>({ 3 }));
+}
+
+void TimingWheelTest::testRescheduleAndCancel()
+{
+    TimingWheel wheel(10, 16);
+    wheel.schedule(1, 20);
+    wheel.schedule(2, 20);
+
+    wheel.schedule(1, 100);
+    wheel.cancel(2);
+    QCOMPARE(wheel.count(), 1);
+    QCOMPARE(wheel.deadline(1), qint64(100));
+    QCOMPARE(wheel.deadline(2), qint64(-1));
+
+    QVERIFY(wheel.advance(50).isEmpty());
+    QCOMPARE(wheel.advance(110), QList<quint64>({ 1 }));
+}
+
+void TimingWheelTest::testLongDeadline()
+{
+    TimingWheel wheel(10, 4);
+    wheel.schedule(1, 125); // Three turns of the wheel
+
+    QVERIFY(wheel.advance(50).isEmpty());
+    QVERIFY(wheel.advance(100).isEmpty());
+    QVERIFY(wheel.contains(1));
+
+    // Gap of several turns visits every slot once
+    QCOMPARE(wheel.advance(1000), QList<quint64>({ 1 }));
+}
@@ -0,0 +1,16 @@
+#ifndef TIMING_WHEEL_TEST_H
+#define TIMING_WHEEL_TEST_H
+
+#include <QTest>
+
+class TimingWheelTest: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testExpiration();
+    void testRescheduleAndCancel();
+    void testLongDeadline();
+};
+
+#endif // TIMING_WHEEL_TEST_H